@@ -111,6 +111,7 @@ def get_models_from_file(model_file):
         "public ClopathArchivingNode": "clopath",
         "public UrbanczikArchivingNode": "urbanczik",
         "public EpropArchivingNode": "neuron",
+        "public static_synapse_base": "connection",
         "typedef binary_neuron": "binary",
         "typedef rate_": "rate",
     }
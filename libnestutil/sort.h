@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 // Generated includes:
@@ -38,6 +39,7 @@
 #endif
 
 #define INSERTION_SORT_CUTOFF 10 // use insertion sort for smaller arrays
+#define RADIX_SORT_BITS 8        // number of bits sorted per radix sort pass
 
 namespace nest
 {
@@ -185,6 +187,285 @@ sort( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm )
 #endif
 }
 
+/**
+ * Applies the permutation order to vec_sort and vec_perm, so that entry i
+ * afterwards holds the former entry order[ i ].
+ *
+ * The permutation is decomposed into cycles, so that every entry is moved
+ * exactly once without allocating a copy of the vectors. order is reset to
+ * the identity.
+ */
+template < typename T1, typename T2 >
+void
+apply_permutation_( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm, std::vector< uint64_t >& order )
+{
+  for ( size_t i = 0; i < order.size(); ++i )
+  {
+    if ( order[ i ] == i )
+    {
+      continue;
+    }
+
+    T1 tmp_sort = std::move( vec_sort[ i ] );
+    T2 tmp_perm = std::move( vec_perm[ i ] );
+    size_t j = i;
+    while ( order[ j ] != i )
+    {
+      const size_t k = order[ j ];
+      vec_sort[ j ] = std::move( vec_sort[ k ] );
+      vec_perm[ j ] = std::move( vec_perm[ k ] );
+      order[ j ] = j;
+      j = k;
+    }
+    vec_sort[ j ] = std::move( tmp_sort );
+    vec_perm[ j ] = std::move( tmp_perm );
+    order[ j ] = j;
+  }
+}
+
+/**
+ * Stable LSD radix sort of words by their bits from begin_bit to end_bit,
+ * in passes of RADIX_SORT_BITS bits. Passes in which all words share the
+ * same digit are skipped. If values is not empty, it is permuted in the
+ * same way as words.
+ */
+inline void
+radix_sort_words_( std::vector< uint64_t >& words,
+  std::vector< uint64_t >& values,
+  const size_t begin_bit,
+  const size_t end_bit )
+{
+  constexpr size_t num_buckets = 1 << RADIX_SORT_BITS;
+  const size_t n = words.size();
+
+  std::vector< uint64_t > words_tmp( n );
+  std::vector< uint64_t > values_tmp( values.size() );
+  std::vector< size_t > bucket_begin( num_buckets );
+  for ( size_t shift = begin_bit; shift < end_bit; shift += RADIX_SORT_BITS )
+  {
+    std::fill( bucket_begin.begin(), bucket_begin.end(), 0 );
+    for ( const uint64_t w : words )
+    {
+      ++bucket_begin[ ( w >> shift ) & ( num_buckets - 1 ) ];
+    }
+    if ( *std::max_element( bucket_begin.begin(), bucket_begin.end() ) == n )
+    {
+      continue; // all words have the same digit
+    }
+
+    size_t position = 0;
+    for ( size_t& b : bucket_begin )
+    {
+      const size_t count = b;
+      b = position;
+      position += count;
+    }
+
+    for ( size_t j = 0; j < n; ++j )
+    {
+      const size_t pos = bucket_begin[ ( words[ j ] >> shift ) & ( num_buckets - 1 ) ]++;
+      words_tmp[ pos ] = words[ j ];
+      if ( not values.empty() )
+      {
+        values_tmp[ pos ] = values[ j ];
+      }
+    }
+    words.swap( words_tmp );
+    values.swap( values_tmp );
+  }
+}
+
+/**
+ * Returns the number of bits needed to represent value.
+ */
+inline size_t
+num_bits_( uint64_t value )
+{
+  size_t bits = 0;
+  while ( value > 0 )
+  {
+    ++bits;
+    value >>= 1;
+  }
+  return bits;
+}
+
+/**
+ * Stable LSD radix sort of vec_sort by the unsigned integer key(
+ * vec_sort[ i ] ), applying the same permutation to vec_perm.
+ *
+ * Keys are sorted together with their indices, and only afterwards are the
+ * entries of both vectors moved to their final positions along the cycles
+ * of the permutation. Heavyweight entries of vec_perm are thus moved once,
+ * and no copy of the vectors is needed.
+ *
+ * If the key and the index of an entry fit into 64 bits together, they
+ * are packed into one word, and sorting needs two words per entry at most.
+ * Otherwise keys and indices are sorted as separate words, which needs four
+ * words per entry. Moving the entries needs one word per entry.
+ */
+template < typename T1, typename T2, typename KeyFunction >
+void
+radix_sort( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm, KeyFunction key )
+{
+  const size_t n = vec_sort.size();
+  if ( n <= INSERTION_SORT_CUTOFF )
+  {
+    if ( n > 1 )
+    {
+      insertion_sort( vec_sort, vec_perm, 0, n - 1 );
+    }
+    return;
+  }
+
+  uint64_t max_key = 0;
+  for ( const auto& entry : vec_sort )
+  {
+    max_key = std::max( max_key, static_cast< uint64_t >( key( entry ) ) );
+  }
+  const size_t key_bits = num_bits_( max_key );
+  const size_t index_bits = num_bits_( n - 1 );
+
+  std::vector< uint64_t > order;
+  if ( key_bits + index_bits <= 64 )
+  {
+    // index in the lower bits, key in the upper bits
+    order.resize( n );
+    size_t i = 0;
+    for ( auto it = vec_sort.begin(); it != vec_sort.end(); ++it, ++i )
+    {
+      order[ i ] = ( static_cast< uint64_t >( key( *it ) ) << index_bits ) | i;
+    }
+
+    std::vector< uint64_t > no_values;
+    radix_sort_words_( order, no_values, index_bits, index_bits + key_bits );
+
+    const uint64_t index_mask = ( uint64_t( 1 ) << index_bits ) - 1;
+    for ( uint64_t& word : order )
+    {
+      word &= index_mask;
+    }
+  }
+  else
+  {
+    std::vector< uint64_t > keys( n );
+    order.resize( n );
+    size_t i = 0;
+    for ( auto it = vec_sort.begin(); it != vec_sort.end(); ++it, ++i )
+    {
+      keys[ i ] = key( *it );
+      order[ i ] = i;
+    }
+
+    radix_sort_words_( keys, order, 0, key_bits );
+  }
+
+  apply_permutation_( vec_sort, vec_perm, order );
+}
+
+/**
+ * Radix sort for vectors of non-negative integers. Convenience function.
+ */
+template < typename T1, typename T2 >
+void
+radix_sort( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm )
+{
+  radix_sort( vec_sort, vec_perm, []( const T1& k ) { return static_cast< uint64_t >( k ); } );
+}
+
+/**
+ * Returns the length of the longest sorted prefix of vec.
+ */
+template < typename T >
+size_t
+sorted_prefix_size( const BlockVector< T >& vec )
+{
+  const size_t size = vec.size();
+  if ( size == 0 )
+  {
+    return 0;
+  }
+
+  size_t prefix_size = 1;
+  while ( prefix_size < size and not( vec[ prefix_size ] < vec[ prefix_size - 1 ] ) )
+  {
+    ++prefix_size;
+  }
+  return prefix_size;
+}
+
+/**
+ * Sorts vec_sort and vec_perm accordingly if only entries appended to
+ * a sorted vector are out of order.
+ *
+ * Entries after the sorted prefix of length prefix_size are sorted
+ * separately and merged into the prefix, moving only entries of the prefix
+ * that are larger than the smallest new entry. Equal entries keep their
+ * order. Besides an index per appended entry, this needs memory for a copy
+ * of the appended entries of both vectors.
+ */
+template < typename T1, typename T2 >
+void
+sort_tail_and_merge( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm, const size_t prefix_size )
+{
+  const size_t size = vec_sort.size();
+  if ( prefix_size >= size )
+  {
+    return; // already sorted
+  }
+
+  std::vector< size_t > tail_order( size - prefix_size );
+  for ( size_t i = 0; i < tail_order.size(); ++i )
+  {
+    tail_order[ i ] = prefix_size + i;
+  }
+  std::stable_sort( tail_order.begin(),
+    tail_order.end(),
+    [ &vec_sort ]( const size_t lhs, const size_t rhs ) { return vec_sort[ lhs ] < vec_sort[ rhs ]; } );
+
+  std::vector< T1 > tail_sort;
+  std::vector< T2 > tail_perm;
+  tail_sort.reserve( tail_order.size() );
+  tail_perm.reserve( tail_order.size() );
+  for ( const size_t i : tail_order )
+  {
+    tail_sort.push_back( vec_sort[ i ] );
+    tail_perm.push_back( vec_perm[ i ] );
+  }
+
+  // merge from the back, so that entries are moved at most once
+  size_t i = prefix_size;
+  size_t j = tail_sort.size();
+  size_t k = size;
+  while ( j > 0 )
+  {
+    --k;
+    if ( i > 0 and tail_sort[ j - 1 ] < vec_sort[ i - 1 ] )
+    {
+      --i;
+      vec_sort[ k ] = vec_sort[ i ];
+      vec_perm[ k ] = vec_perm[ i ];
+    }
+    else
+    {
+      --j;
+      vec_sort[ k ] = tail_sort[ j ];
+      vec_perm[ k ] = tail_perm[ j ];
+    }
+  }
+}
+
+/**
+ * Sorts vec_sort and vec_perm accordingly if only entries appended to
+ * a sorted vector are out of order. Convenience function.
+ */
+template < typename T1, typename T2 >
+void
+sort_tail_and_merge( BlockVector< T1 >& vec_sort, BlockVector< T2 >& vec_perm )
+{
+  sort_tail_and_merge( vec_sort, vec_perm, sorted_prefix_size( vec_sort ) );
+}
+
 } // namespace sort
 
 #endif /* #ifndef SORT_H */
@@ -214,6 +214,8 @@ public:
   size_t handles_test_event( CurrentEvent&, size_t ) override;
   size_t handles_test_event( DataLoggingRequest&, size_t ) override;
 
+  std::vector< size_t > get_receptor_types_of_port( const size_t ) const override;
+
   void get_status( DictionaryDatum& ) const override;
   void set_status( const DictionaryDatum& ) override;
 
@@ -565,6 +567,13 @@ ht_neuron::handles_test_event( DataLoggingRequest& dlr, size_t receptor_type )
   }
   return B_.logger_.connect_logging_device( dlr, recordablesMap_ );
 }
+
+inline std::vector< size_t >
+ht_neuron::get_receptor_types_of_port( const size_t rport ) const
+{
+  // spike receptors are numbered from 1, current input has receptor type 0
+  return { rport + 1, rport };
+}
 }
 
 #endif // HAVE_GSL
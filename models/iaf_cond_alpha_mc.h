@@ -205,6 +205,8 @@ public:
   size_t handles_test_event( CurrentEvent&, size_t ) override;
   size_t handles_test_event( DataLoggingRequest&, size_t ) override;
 
+  std::vector< size_t > get_receptor_types_of_port( const size_t ) const override;
+
   void get_status( DictionaryDatum& ) const override;
   void set_status( const DictionaryDatum& ) override;
 
@@ -532,6 +534,12 @@ iaf_cond_alpha_mc::handles_test_event( DataLoggingRequest& dlr, size_t receptor_
   return B_.logger_.connect_logging_device( dlr, recordablesMap_ );
 }
 
+inline std::vector< size_t >
+iaf_cond_alpha_mc::get_receptor_types_of_port( const size_t rport ) const
+{
+  return { rport + MIN_SPIKE_RECEPTOR, rport + MIN_CURR_RECEPTOR };
+}
+
 inline void
 iaf_cond_alpha_mc::get_status( DictionaryDatum& d ) const
 {
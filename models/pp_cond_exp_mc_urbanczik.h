@@ -279,6 +279,8 @@ public:
   size_t handles_test_event( CurrentEvent&, size_t ) override;
   size_t handles_test_event( DataLoggingRequest&, size_t ) override;
 
+  std::vector< size_t > get_receptor_types_of_port( const size_t ) const override;
+
   void get_status( DictionaryDatum& ) const override;
   void set_status( const DictionaryDatum& ) override;
 
@@ -612,6 +614,12 @@ pp_cond_exp_mc_urbanczik::handles_test_event( DataLoggingRequest& dlr, size_t re
   return B_.logger_.connect_logging_device( dlr, recordablesMap_ );
 }
 
+inline std::vector< size_t >
+pp_cond_exp_mc_urbanczik::get_receptor_types_of_port( const size_t rport ) const
+{
+  return { rport + MIN_SPIKE_RECEPTOR, rport + MIN_CURR_RECEPTOR };
+}
+
 inline void
 pp_cond_exp_mc_urbanczik::get_status( DictionaryDatum& d ) const
 {
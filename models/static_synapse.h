@@ -62,10 +62,16 @@ EndUserDocs */
 
 void register_static_synapse( const std::string& name );
 
-template < typename targetidentifierT >
-class static_synapse : public Connection< targetidentifierT >
+/**
+ * Static synapse storing its weight as weightT.
+ *
+ * Base of static_synapse, which stores its weight as double, and of
+ * static_synapse_compact, which stores its weight as float.
+ */
+template < typename targetidentifierT, typename weightT >
+class static_synapse_base : public Connection< targetidentifierT >
 {
-  double weight_;
+  weightT weight_;
 
 public:
   // this line determines which common properties to use
@@ -74,13 +80,13 @@ public:
 
   static constexpr ConnectionModelProperties properties = ConnectionModelProperties::HAS_DELAY
     | ConnectionModelProperties::IS_PRIMARY | ConnectionModelProperties::SUPPORTS_HPC
-    | ConnectionModelProperties::SUPPORTS_LBL;
+    | ConnectionModelProperties::SUPPORTS_LBL | ConnectionModelProperties::SUPPORTS_MULTIPLICITY;
 
   /**
    * Default Constructor.
    * Sets default values for all parameters. Needed by GenericConnectorModel.
    */
-  static_synapse()
+  static_synapse_base()
     : ConnectionBase()
     , weight_( 1.0 )
   {
@@ -90,8 +96,8 @@ public:
    * Copy constructor from a property object.
    * Needs to be defined properly in order for GenericConnector to work.
    */
-  static_synapse( const static_synapse& rhs ) = default;
-  static_synapse& operator=( const static_synapse& rhs ) = default;
+  static_synapse_base( const static_synapse_base& rhs ) = default;
+  static_synapse_base& operator=( const static_synapse_base& rhs ) = default;
 
   // Explicitly declare all methods inherited from the dependent base
   // ConnectionBase. This avoids explicit name prefixes in all places these
@@ -172,6 +178,12 @@ public:
 
   void set_status( const DictionaryDatum& d, ConnectorModel& cm );
 
+  double
+  get_weight() const
+  {
+    return weight_;
+  }
+
   void
   set_weight( double w )
   {
@@ -179,12 +191,12 @@ public:
   }
 };
 
-template < typename targetidentifierT >
-constexpr ConnectionModelProperties static_synapse< targetidentifierT >::properties;
+template < typename targetidentifierT, typename weightT >
+constexpr ConnectionModelProperties static_synapse_base< targetidentifierT, weightT >::properties;
 
-template < typename targetidentifierT >
+template < typename targetidentifierT, typename weightT >
 void
-static_synapse< targetidentifierT >::get_status( DictionaryDatum& d ) const
+static_synapse_base< targetidentifierT, weightT >::get_status( DictionaryDatum& d ) const
 {
 
   ConnectionBase::get_status( d );
@@ -192,14 +204,19 @@ static_synapse< targetidentifierT >::get_status( DictionaryDatum& d ) const
   def< long >( d, names::size_of, sizeof( *this ) );
 }
 
-template < typename targetidentifierT >
+template < typename targetidentifierT, typename weightT >
 void
-static_synapse< targetidentifierT >::set_status( const DictionaryDatum& d, ConnectorModel& cm )
+static_synapse_base< targetidentifierT, weightT >::set_status( const DictionaryDatum& d, ConnectorModel& cm )
 {
   ConnectionBase::set_status( d, cm );
   updateValue< double >( d, names::weight, weight_ );
 }
 
+template < typename targetidentifierT >
+class static_synapse : public static_synapse_base< targetidentifierT, double >
+{
+};
+
 } // namespace
 
 #endif /* #ifndef STATICSYNAPSE_H */
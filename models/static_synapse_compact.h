@@ -0,0 +1,74 @@
+/*
+ *  static_synapse_compact.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STATICSYNAPSE_COMPACT_H
+#define STATICSYNAPSE_COMPACT_H
+
+// Includes from models:
+#include "static_synapse.h"
+
+namespace nest
+{
+
+/* BeginUserDocs: synapse, static
+
+Short description
++++++++++++++++++
+
+Synapse type for static connections with single precision weights
+
+Description
++++++++++++
+
+``static_synapse_compact`` behaves like ``static_synapse``, but stores the
+weight of each connection as a single precision floating point number. Weights
+thus have a relative precision of about :math:`10^{-7}`. The delay is stored
+in steps together with the synapse type in 32 bits, as for all synapse types.
+
+Combined with the compact target identifier of ``static_synapse_compact_hpc``,
+a connection takes 12 bytes instead of the 16 bytes of
+``static_synapse_hpc``. The kernel attribute ``bytes_per_synapse`` lists the
+size of a connection for each synapse model.
+
+Transmits
++++++++++
+
+SpikeEvent, RateEvent, CurrentEvent, ConductanceEvent,
+DoubleDataEvent, DataLoggingRequest
+
+See also
+++++++++
+
+static_synapse, static_synapse_hom_w
+
+EndUserDocs */
+
+void register_static_synapse_compact( const std::string& name );
+
+template < typename targetidentifierT >
+class static_synapse_compact : public static_synapse_base< targetidentifierT, float >
+{
+};
+
+} // namespace
+
+#endif /* #ifndef STATICSYNAPSE_COMPACT_H */
@@ -41,6 +41,7 @@
 
 // Includes from C++:
 #include <algorithm>
+#include <cmath>
 
 nest::ConnBuilder::ConnBuilder( NodeCollectionPTR sources,
   NodeCollectionPTR targets,
@@ -408,6 +409,12 @@ nest::ConnBuilder::loop_over_targets_() const
     or parameters_requiring_skipping_.size() > 0;
 }
 
+bool
+nest::ConnBuilder::loop_over_thread_local_targets_() const
+{
+  return parameters_requiring_skipping_.empty() and targets_->has_proxies();
+}
+
 void
 nest::ConnBuilder::set_synapse_model_( DictionaryDatum syn_params, size_t synapse_indx )
 {
@@ -584,11 +591,27 @@ nest::OneToOneBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      if ( loop_over_targets_() and loop_over_thread_local_targets_() )
+      {
+        NodeCollection::const_iterator target_it = targets_->local_begin();
+        for ( ; target_it < targets_->end(); ++target_it )
+        {
+          const size_t tnode_id = ( *target_it ).node_id;
+
+          // one-to-one, thus we can use target idx for source as well
+          const size_t snode_id = ( *sources_ )[ targets_->get_lid( tnode_id ) ];
+          if ( not allow_autapses_ and snode_id == tnode_id )
+          {
+            continue;
+          }
+
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          assert( not target->is_proxy() );
+          single_connect_( snode_id, *target, tid, rng );
+        }
+      }
+      else if ( loop_over_targets_() )
       {
-        // A more efficient way of doing this might be to use NodeCollection's local_begin(). For this to work we would
-        // need to change some of the logic, sources and targets might not be on the same process etc., so therefore
-        // we are not doing it at the moment. This also applies to other ConnBuilders below.
         NodeCollection::const_iterator target_it = targets_->begin();
         NodeCollection::const_iterator source_it = sources_->begin();
         for ( ; target_it < targets_->end(); ++target_it, ++source_it )
@@ -798,7 +821,30 @@ nest::AllToAllBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      if ( loop_over_targets_() and targets_->has_proxies() )
+      {
+        // Each target consumes one value per source from array parameters, so values for the targets on other
+        // virtual processes between two local targets can be skipped in one go.
+        const bool skip = not parameters_requiring_skipping_.empty();
+        size_t next_lid = 0;
+
+        NodeCollection::const_iterator target_it = targets_->local_begin();
+        for ( ; target_it < targets_->end(); ++target_it )
+        {
+          const size_t tnode_id = ( *target_it ).node_id;
+          if ( skip )
+          {
+            const size_t lid = targets_->get_lid( tnode_id );
+            skip_conn_parameter_( tid, ( lid - next_lid ) * sources_->size() );
+            next_lid = lid + 1;
+          }
+
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          assert( not target->is_proxy() );
+          inner_connect_( tid, rng, target, tnode_id, skip );
+        }
+      }
+      else if ( loop_over_targets_() )
       {
         NodeCollection::const_iterator target_it = targets_->begin();
         for ( ; target_it < targets_->end(); ++target_it )
@@ -1015,6 +1061,7 @@ nest::FixedInDegreeBuilder::FixedInDegreeBuilder( NodeCollectionPTR sources,
   const DictionaryDatum& conn_spec,
   const std::vector< DictionaryDatum >& syn_specs )
   : ConnBuilder( sources, targets, conn_spec, syn_specs )
+  , indegree_is_constant_( false )
 {
   // check for potential errors
   long n_sources = static_cast< long >( sources_->size() );
@@ -1033,6 +1080,7 @@ nest::FixedInDegreeBuilder::FixedInDegreeBuilder( NodeCollectionPTR sources,
     // Assume indegree is a scalar
     const long value = ( *conn_spec )[ names::indegree ];
     indegree_ = std::shared_ptr< Parameter >( new ConstantParameter( value ) );
+    indegree_is_constant_ = true;
 
     // verify that indegree is not larger than source population if multapses are disabled
     if ( not allow_multapses_ )
@@ -1078,7 +1126,22 @@ nest::FixedInDegreeBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      // A random indegree is drawn for every target, including targets on other virtual processes, so
+      // visiting only local targets would change the random numbers drawn and thus the connections.
+      if ( loop_over_targets_() and loop_over_thread_local_targets_() and indegree_is_constant_ )
+      {
+        NodeCollection::const_iterator target_it = targets_->local_begin();
+        for ( ; target_it < targets_->end(); ++target_it )
+        {
+          const size_t tnode_id = ( *target_it ).node_id;
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          assert( not target->is_proxy() );
+
+          const long indegree_value = std::round( indegree_->value( rng, target ) );
+          inner_connect_( tid, rng, target, tnode_id, false, indegree_value );
+        }
+      }
+      else if ( loop_over_targets_() )
       {
         NodeCollection::const_iterator target_it = targets_->begin();
         for ( ; target_it < targets_->end(); ++target_it )
@@ -1479,12 +1542,36 @@ nest::BernoulliBuilder::BernoulliBuilder( NodeCollectionPTR sources,
   const DictionaryDatum& conn_spec,
   const std::vector< DictionaryDatum >& syn_specs )
   : ConnBuilder( sources, targets, conn_spec, syn_specs )
+  , p_is_constant_( false )
+  , use_skip_sampling_( false )
+  , p_max_( 1.0 )
 {
+  updateValue< bool >( conn_spec, names::use_skip_sampling, use_skip_sampling_ );
+
   ParameterDatum* pd = dynamic_cast< ParameterDatum* >( ( *conn_spec )[ names::p ].datum() );
   if ( pd )
   {
     p_ = *pd;
     // TODO: Checks of parameter range
+
+    if ( use_skip_sampling_ )
+    {
+      if ( not updateValue< double >( conn_spec, names::p_max, p_max_ ) )
+      {
+        throw BadProperty( "Skip sampling with a parameter as connection probability requires p_max." );
+      }
+      if ( p_max_ < 0 or 1 < p_max_ )
+      {
+        throw BadProperty( "Upper bound of connection probability 0 <= p_max <= 1 required." );
+      }
+      // Candidates are thinned by p / p_max, so p must never exceed p_max. Checking this here ensures that
+      // no connections are created if it does.
+      if ( p_->upper_bound() > p_max_ )
+      {
+        throw BadProperty(
+          "Skip sampling requires a parameter as connection probability that is known not to exceed p_max." );
+      }
+    }
   }
   else
   {
@@ -1495,6 +1582,8 @@ nest::BernoulliBuilder::BernoulliBuilder( NodeCollectionPTR sources,
       throw BadProperty( "Connection probability 0 <= p <= 1 required." );
     }
     p_ = std::shared_ptr< Parameter >( new ConstantParameter( value ) );
+    p_is_constant_ = true;
+    p_max_ = value;
   }
 }
 
@@ -1511,7 +1600,26 @@ nest::BernoulliBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      if ( loop_over_targets_() and loop_over_thread_local_targets_() )
+      {
+        NodeCollection::const_iterator target_it = targets_->local_begin();
+        for ( ; target_it < targets_->end(); ++target_it )
+        {
+          const size_t tnode_id = ( *target_it ).node_id;
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          assert( not target->is_proxy() );
+
+          if ( use_skip_sampling_ )
+          {
+            inner_connect_skip_sampling_( tid, rng, target, tnode_id );
+          }
+          else
+          {
+            inner_connect_( tid, rng, target, tnode_id );
+          }
+        }
+      }
+      else if ( loop_over_targets_() )
       {
         NodeCollection::const_iterator target_it = targets_->begin();
         for ( ; target_it < targets_->end(); ++target_it )
@@ -1525,7 +1633,14 @@ nest::BernoulliBuilder::connect_()
             continue;
           }
 
-          inner_connect_( tid, rng, target, tnode_id );
+          if ( use_skip_sampling_ )
+          {
+            inner_connect_skip_sampling_( tid, rng, target, tnode_id );
+          }
+          else
+          {
+            inner_connect_( tid, rng, target, tnode_id );
+          }
         }
       }
 
@@ -1543,7 +1658,14 @@ nest::BernoulliBuilder::connect_()
             continue;
           }
 
-          inner_connect_( tid, rng, n->get_node(), tnode_id );
+          if ( use_skip_sampling_ )
+          {
+            inner_connect_skip_sampling_( tid, rng, n->get_node(), tnode_id );
+          }
+          else
+          {
+            inner_connect_( tid, rng, n->get_node(), tnode_id );
+          }
         }
       }
     }
@@ -1588,6 +1710,59 @@ nest::BernoulliBuilder::inner_connect_( const int tid, RngPtr rng, Node* target,
   }
 }
 
+void
+nest::BernoulliBuilder::inner_connect_skip_sampling_( const int tid, RngPtr rng, Node* target, size_t tnode_id )
+{
+  const size_t target_thread = target->get_thread();
+
+  // check whether the target is on our thread
+  if ( static_cast< size_t >( tid ) != target_thread )
+  {
+    return;
+  }
+
+  if ( p_max_ == 0.0 )
+  {
+    return;
+  }
+
+  // The number of sources skipped before the next candidate source is geometrically distributed with success
+  // probability p_max. It is drawn by inversion, so that the work per target scales with the number of
+  // connections instead of the number of sources. For p_max == 1, log_q is -inf and no source is skipped.
+  const double log_q = std::log1p( -p_max_ );
+  const size_t num_sources = sources_->size();
+
+  size_t source_index = 0;
+  while ( true )
+  {
+    const double skip = std::floor( std::log1p( -rng->drand() ) / log_q );
+    if ( skip >= static_cast< double >( num_sources - source_index ) )
+    {
+      break;
+    }
+    source_index += static_cast< size_t >( skip );
+
+    const size_t snode_id = ( *sources_ )[ source_index ];
+    ++source_index;
+
+    if ( not allow_autapses_ and snode_id == tnode_id )
+    {
+      continue;
+    }
+
+    // Thin candidates to the actual connection probability if it varies between pairs.
+    if ( not p_is_constant_ )
+    {
+      if ( rng->drand() * p_max_ >= p_->value( rng, target ) )
+      {
+        continue;
+      }
+    }
+
+    single_connect_( snode_id, *target, target_thread, rng );
+  }
+}
+
 
 nest::PoissonBuilder::PoissonBuilder( NodeCollectionPTR sources,
   NodeCollectionPTR targets,
@@ -1628,7 +1803,19 @@ nest::PoissonBuilder::connect_()
     {
       RngPtr rng = get_vp_specific_rng( tid );
 
-      if ( loop_over_targets_() )
+      if ( loop_over_targets_() and loop_over_thread_local_targets_() )
+      {
+        NodeCollection::const_iterator target_it = targets_->local_begin();
+        for ( ; target_it < targets_->end(); ++target_it )
+        {
+          const size_t tnode_id = ( *target_it ).node_id;
+          Node* const target = kernel().node_manager.get_node_or_proxy( tnode_id, tid );
+          assert( not target->is_proxy() );
+
+          inner_connect_( tid, rng, target, tnode_id );
+        }
+      }
+      else if ( loop_over_targets_() )
       {
         NodeCollection::const_iterator target_it = targets_->begin();
         for ( ; target_it < targets_->end(); ++target_it )
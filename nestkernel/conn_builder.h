@@ -204,6 +204,17 @@ protected:
    */
   bool loop_over_targets_() const;
 
+  /**
+   * Returns true if each thread only needs to visit the targets on its own virtual process.
+   *
+   * This is the case if all targets exist on a single virtual process only, i.e., have proxies,
+   * and no connection parameter requires skipping of values for targets on other virtual processes.
+   * Threads then iterate from NodeCollection::local_begin() instead of visiting all targets.
+   *
+   * @return true if only thread-local targets are to be visited
+   */
+  bool loop_over_thread_local_targets_() const;
+
   NodeCollectionPTR sources_;
   NodeCollectionPTR targets_;
 
@@ -406,6 +417,7 @@ protected:
 private:
   void inner_connect_( const int, RngPtr, Node*, size_t, bool, long );
   ParameterDatum indegree_;
+  bool indegree_is_constant_; //!< true if indegree is the same for all targets
 };
 
 class FixedOutDegreeBuilder : public ConnBuilder
@@ -451,7 +463,11 @@ protected:
 
 private:
   void inner_connect_( const int, RngPtr, Node*, size_t );
-  ParameterDatum p_; //!< connection probability
+  void inner_connect_skip_sampling_( const int, RngPtr, Node*, size_t );
+  ParameterDatum p_;       //!< connection probability
+  bool p_is_constant_;     //!< true if p is the same for all pairs
+  bool use_skip_sampling_; //!< jump between created connections instead of drawing for each pair
+  double p_max_;           //!< upper bound of p, used to draw the jumps
 };
 
 class PoissonBuilder : public ConnBuilder
@@ -30,9 +30,14 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
   : allow_autapses_( true )
   , allow_multapses_( true )
   , allow_oversized_( false )
+  , use_local_source_positions_( false )
   , number_of_connections_()
   , mask_()
   , kernel_()
+  , kernel_program_()
+  , weight_programs_()
+  , delay_programs_()
+  , synapse_programs_use_displacement_( false )
   , synapse_model_()
   , weight_()
   , delay_()
@@ -43,6 +48,7 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
   updateValue< bool >( dict, names::allow_autapses, allow_autapses_ );
   updateValue< bool >( dict, names::allow_multapses, allow_multapses_ );
   updateValue< bool >( dict, names::allow_oversized_mask, allow_oversized_ );
+  updateValue< bool >( dict, names::use_local_source_positions, use_local_source_positions_ );
 
   // Need to store number of connections in a temporary variable to be able to detect negative values.
 
@@ -72,6 +78,12 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
   if ( dict->known( names::kernel ) )
   {
     kernel_ = NestModule::create_parameter( ( *dict )[ names::kernel ] );
+
+    // Kernels that are not spatial have the same value for all sources and gain nothing from batches.
+    if ( kernel_->is_spatial() and not kernel_->compile( kernel_program_ ) )
+    {
+      kernel_program_.clear();
+    }
   }
   if ( dict->known( names::synapse_parameters ) )
   {
@@ -123,6 +135,8 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
     }
   }
 
+  compile_synapse_parameters_();
+
   if ( connection_type == names::pairwise_bernoulli_on_source )
   {
 
@@ -144,6 +158,11 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
 
     if ( dict->known( names::number_of_connections ) )
     {
+      // All MPI processes draw the targets of every source with the same random numbers.
+      if ( use_local_source_positions_ )
+      {
+        throw BadProperty( "use_local_source_positions cannot be used with rule fixed_outdegree." );
+      }
       type_ = Fixed_outdegree;
     }
     else
@@ -157,6 +176,31 @@ ConnectionCreator::ConnectionCreator( DictionaryDatum dict )
   }
 }
 
+void
+ConnectionCreator::compile_synapse_parameters_()
+{
+  bool compiled = true;
+  bool any_spatial = false;
+  weight_programs_.resize( weight_.size() );
+  delay_programs_.resize( delay_.size() );
+  for ( size_t indx = 0; indx < weight_.size() and compiled; ++indx )
+  {
+    compiled =
+      weight_[ indx ]->compile( weight_programs_[ indx ] ) and delay_[ indx ]->compile( delay_programs_[ indx ] );
+    any_spatial |= weight_[ indx ]->is_spatial() or delay_[ indx ]->is_spatial();
+    synapse_programs_use_displacement_ |=
+      weight_programs_[ indx ].uses_displacement() or delay_programs_[ indx ].uses_displacement();
+  }
+
+  // Weights and delays that are the same for all sources gain nothing from batches.
+  if ( not( compiled and any_spatial ) )
+  {
+    weight_programs_.clear();
+    delay_programs_.clear();
+    synapse_programs_use_displacement_ = false;
+  }
+}
+
 void
 ConnectionCreator::extract_params_( const DictionaryDatum& dict_datum, std::vector< DictionaryDatum >& params )
 {
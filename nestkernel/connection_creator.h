@@ -24,12 +24,14 @@
 #define CONNECTION_CREATOR_H
 
 // C++ includes:
+#include <memory>
 #include <vector>
 
 // Includes from nestkernel:
 #include "kernel_manager.h"
 #include "nest_names.h"
 #include "nestmodule.h"
+#include "parameter_program.h"
 
 // Includes from spatial:
 #include "mask.h"
@@ -82,6 +84,8 @@ public:
    * - "allow_autapses": Boolean, true if autapses are allowed.
    * - "allow_multapses": Boolean, true if multapses are allowed.
    * - "allow_oversized": Boolean, true if oversized masks are allowed.
+   * - "use_local_source_positions": Boolean, true if each MPI process only
+   *   gathers positions of sources inside the mask of its local targets.
    * - "number_of_connections": Integer, number of connections to make
    *   for each source or target.
    * - "mask": Mask definition (dictionary or masktype).
@@ -122,21 +126,68 @@ private:
     PoolWrapper_();
     ~PoolWrapper_();
     void define( MaskedLayer< D >* );
-    void define( std::vector< std::pair< Position< D >, size_t > >* );
+    void define( std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > > );
 
-    typename Ntree< D, size_t >::masked_iterator masked_begin( const Position< D >& pos ) const;
-    typename Ntree< D, size_t >::masked_iterator masked_end() const;
+    void get_nodes( const Position< D >& pos, std::vector< std::pair< Position< D >, size_t > >& nodes ) const;
 
     typename std::vector< std::pair< Position< D >, size_t > >::iterator begin() const;
     typename std::vector< std::pair< Position< D >, size_t > >::iterator end() const;
 
   private:
     MaskedLayer< D >* masked_layer_;
-    std::vector< std::pair< Position< D >, size_t > >* positions_;
+    std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > > positions_;
   };
 
   void extract_params_( const DictionaryDatum& dict_datum, std::vector< DictionaryDatum >& params );
 
+  /**
+   * Create a MaskedLayer of the sources, for applying the mask at the positions of the targets.
+   *
+   * If use_local_source_positions_ is set, only sources inside the mask of
+   * targets on this MPI process are gathered. Otherwise, all sources are.
+   *
+   * @param converse if true, the mask is mirrored and the periodic b.c. of the target layer are used
+   * @returns new MaskedLayer, which the caller must delete
+   */
+  template < int D >
+  MaskedLayer< D >* create_masked_source_( Layer< D >& source,
+    NodeCollectionPTR source_nc,
+    Layer< D >& target,
+    NodeCollectionPTR target_nc,
+    const bool converse ) const;
+
+  /**
+   * Compile weights and delays into weight_programs_ and delay_programs_ if all of them can be compiled.
+   */
+  void compile_synapse_parameters_();
+
+  /**
+   * Whether the kernel is evaluated by kernel_program_ for layers with D dimensions.
+   */
+  template < int D >
+  bool use_kernel_program_() const;
+
+  /**
+   * Whether weights and delays are evaluated by weight_programs_ and delay_programs_ for layers with D dimensions.
+   */
+  template < int D >
+  bool use_synapse_programs_() const;
+
+  /**
+   * Fill batch with all sources in [from, to) and the target at target_pos.
+   *
+   * Iterators must point to pairs of source position and node ID.
+   * @param with_displacement whether to compute displacements, as needed by some programs
+   * @param batch batch to fill, reused between calls to avoid allocations
+   */
+  template < typename Iterator, int D >
+  void fill_parameter_batch_( Iterator from,
+    Iterator to,
+    const std::vector< double >& target_pos,
+    const Layer< D >& source,
+    const bool with_displacement,
+    ParameterBatch& batch ) const;
+
   template < typename Iterator, int D >
   void connect_to_target_( Iterator from,
     Iterator to,
@@ -181,9 +232,30 @@ private:
   bool allow_autapses_;
   bool allow_multapses_;
   bool allow_oversized_;
+
+  //! Whether MaskedLayers of sources only hold sources that can be inside the mask of local targets
+  bool use_local_source_positions_;
+
   std::shared_ptr< Parameter > number_of_connections_;
   std::shared_ptr< AbstractMask > mask_;
   std::shared_ptr< Parameter > kernel_;
+
+  //! Compiled spatial kernel, evaluated on batches of sources. Empty if the kernel cannot be compiled.
+  ParameterProgram kernel_program_;
+
+  //! Number of candidate sources for which the compiled kernel is evaluated together
+  static constexpr size_t kernel_batch_size_ = 256;
+
+  /**
+   * Compiled weights and delays, one per synapse specification, evaluated on batches of connected sources.
+   * Empty unless all weights and delays can be compiled and at least one of them is spatial.
+   */
+  std::vector< ParameterProgram > weight_programs_;
+  std::vector< ParameterProgram > delay_programs_;
+
+  //! Whether any of weight_programs_ and delay_programs_ uses displacements
+  bool synapse_programs_use_displacement_;
+
   std::vector< size_t > synapse_model_;
   std::vector< std::vector< DictionaryDatum > > param_dicts_;
   std::vector< std::shared_ptr< Parameter > > weight_;
@@ -26,6 +26,9 @@
 #include "connection_creator.h"
 
 // C++ includes:
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <vector>
 
 // Includes from nestkernel:
@@ -73,6 +76,54 @@ ConnectionCreator::connect( Layer< D >& source,
   }
 }
 
+template < int D >
+bool
+ConnectionCreator::use_kernel_program_() const
+{
+  // If the kernel refers to dimensions the layer does not have, it is evaluated
+  // per connection so that the error is reported as usual.
+  return not kernel_program_.empty() and kernel_program_.get_num_dimensions() <= D;
+}
+
+template < int D >
+bool
+ConnectionCreator::use_synapse_programs_() const
+{
+  for ( size_t indx = 0; indx < weight_programs_.size(); ++indx )
+  {
+    if ( weight_programs_[ indx ].get_num_dimensions() > D or delay_programs_[ indx ].get_num_dimensions() > D )
+    {
+      return false;
+    }
+  }
+  return not weight_programs_.empty();
+}
+
+template < typename Iterator, int D >
+void
+ConnectionCreator::fill_parameter_batch_( Iterator from,
+  Iterator to,
+  const std::vector< double >& target_pos,
+  const Layer< D >& source,
+  const bool with_displacement,
+  ParameterBatch& batch ) const
+{
+  batch.clear();
+  batch.target_pos = target_pos;
+
+  std::vector< double > source_pos( D );
+  std::vector< double > displacement( with_displacement ? D : 0 );
+  for ( Iterator iter = from; iter != to; ++iter )
+  {
+    iter->first.get_vector( source_pos );
+    for ( size_t dim = 0; dim < displacement.size(); ++dim )
+    {
+      displacement[ dim ] = source.compute_displacement( source_pos, target_pos, dim );
+    }
+    batch.add( source_pos, displacement );
+  }
+}
+
 template < typename Iterator, int D >
 void
 ConnectionCreator::connect_to_target_( Iterator from,
@@ -90,6 +141,105 @@ ConnectionCreator::connect_to_target_( Iterator from,
   std::vector< double > source_pos( D );
   const std::vector< double > target_pos = tgt_pos.get_vector();
 
+  const bool use_kernel_program = use_kernel_program_< D >();
+  const bool use_synapse_programs = use_synapse_programs_< D >();
+  if ( use_kernel_program or use_synapse_programs )
+  {
+    // Evaluate the compiled kernel for batches of sources first, and the
+    // compiled weights and delays for the sources connected to. Compiled
+    // parameters draw no random numbers, so the same numbers are drawn as
+    // below.
+    ParameterBatch batch( D );
+    std::vector< std::pair< Position< D >, size_t > > candidates;
+    candidates.reserve( kernel_batch_size_ );
+    std::vector< std::pair< Position< D >, size_t > > connected;
+    std::vector< double > probabilities;
+    std::vector< std::vector< double > > weights( weight_programs_.size() );
+    std::vector< std::vector< double > > delays( delay_programs_.size() );
+
+    Iterator iter = from;
+    while ( iter != to )
+    {
+      candidates.clear();
+      for ( ; iter != to and candidates.size() < kernel_batch_size_; ++iter )
+      {
+        if ( allow_autapses_ or ( iter->second != tgt_ptr->get_node_id() ) )
+        {
+          candidates.push_back( *iter );
+        }
+      }
+      if ( use_kernel_program )
+      {
+        fill_parameter_batch_(
+          candidates.begin(), candidates.end(), target_pos, source, kernel_program_.uses_displacement(), batch );
+        kernel_program_.evaluate( batch, probabilities );
+      }
+
+      connected.clear();
+      for ( size_t i = 0; i < candidates.size(); ++i )
+      {
+        if ( use_kernel_program )
+        {
+          if ( not( rng->drand() < probabilities[ i ] ) )
+          {
+            continue;
+          }
+        }
+        else if ( kernel_ )
+        {
+          candidates[ i ].first.get_vector( source_pos );
+          if ( not( rng->drand() < kernel_->value( rng, source_pos, target_pos, source, tgt_ptr ) ) )
+          {
+            continue;
+          }
+        }
+
+        if ( use_synapse_programs )
+        {
+          connected.push_back( candidates[ i ] );
+          continue;
+        }
+        candidates[ i ].first.get_vector( source_pos );
+        for ( size_t indx = 0; indx < synapse_model_.size(); ++indx )
+        {
+          kernel().connection_manager.connect( candidates[ i ].second,
+            tgt_ptr,
+            tgt_thread,
+            synapse_model_[ indx ],
+            param_dicts_[ indx ][ tgt_thread ],
+            delay_[ indx ]->value( rng, source_pos, target_pos, source, tgt_ptr ),
+            weight_[ indx ]->value( rng, source_pos, target_pos, source, tgt_ptr ) );
+        }
+      }
+
+      if ( connected.empty() )
+      {
+        continue;
+      }
+      fill_parameter_batch_(
+        connected.begin(), connected.end(), target_pos, source, synapse_programs_use_displacement_, batch );
+      for ( size_t indx = 0; indx < synapse_model_.size(); ++indx )
+      {
+        delay_programs_[ indx ].evaluate( batch, delays[ indx ] );
+        weight_programs_[ indx ].evaluate( batch, weights[ indx ] );
+      }
+      for ( size_t i = 0; i < connected.size(); ++i )
+      {
+        for ( size_t indx = 0; indx < synapse_model_.size(); ++indx )
+        {
+          kernel().connection_manager.connect( connected[ i ].second,
+            tgt_ptr,
+            tgt_thread,
+            synapse_model_[ indx ],
+            param_dicts_[ indx ][ tgt_thread ],
+            delays[ indx ][ i ],
+            weights[ indx ][ i ] );
+        }
+      }
+    }
+    return;
+  }
+
   for ( Iterator iter = from; iter != to; ++iter )
   {
     if ( not allow_autapses_ and ( iter->second == tgt_ptr->get_node_id() ) )
@@ -162,7 +312,7 @@ ConnectionCreator::connect_to_target_poisson_( Iterator from,
 template < int D >
 ConnectionCreator::PoolWrapper_< D >::PoolWrapper_()
   : masked_layer_( 0 )
-  , positions_( 0 )
+  , positions_()
 {
 }
 
@@ -180,33 +330,27 @@ void
 ConnectionCreator::PoolWrapper_< D >::define( MaskedLayer< D >* ml )
 {
   assert( masked_layer_ == 0 );
-  assert( positions_ == 0 );
+  assert( not positions_ );
   assert( ml != 0 );
   masked_layer_ = ml;
 }
 
 template < int D >
 void
-ConnectionCreator::PoolWrapper_< D >::define( std::vector< std::pair< Position< D >, size_t > >* pos )
+ConnectionCreator::PoolWrapper_< D >::define( std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > > pos )
 {
   assert( masked_layer_ == 0 );
-  assert( positions_ == 0 );
-  assert( pos != 0 );
+  assert( not positions_ );
+  assert( pos );
   positions_ = pos;
 }
 
 template < int D >
-typename Ntree< D, size_t >::masked_iterator
-ConnectionCreator::PoolWrapper_< D >::masked_begin( const Position< D >& pos ) const
-{
-  return masked_layer_->begin( pos );
-}
-
-template < int D >
-typename Ntree< D, size_t >::masked_iterator
-ConnectionCreator::PoolWrapper_< D >::masked_end() const
+void
+ConnectionCreator::PoolWrapper_< D >::get_nodes( const Position< D >& pos,
+  std::vector< std::pair< Position< D >, size_t > >& nodes ) const
 {
-  return masked_layer_->end();
+  masked_layer_->get_nodes( pos, nodes );
 }
 
 template < int D >
@@ -224,6 +368,49 @@ ConnectionCreator::PoolWrapper_< D >::end() const
 }
 
 
+template < int D >
+MaskedLayer< D >*
+ConnectionCreator::create_masked_source_( Layer< D >& source,
+  NodeCollectionPTR source_nc,
+  Layer< D >& target,
+  NodeCollectionPTR target_nc,
+  const bool converse ) const
+{
+  if ( not use_local_source_positions_ )
+  {
+    if ( converse )
+    {
+      return new MaskedLayer< D >( source, mask_, allow_oversized_, target, source_nc );
+    }
+    return new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc );
+  }
+
+  // The mask is applied at the positions of the targets on this MPI process.
+  Box< D > anchor_box;
+  for ( int i = 0; i < D; ++i )
+  {
+    anchor_box.lower_left[ i ] = std::numeric_limits< double >::infinity();
+    anchor_box.upper_right[ i ] = -std::numeric_limits< double >::infinity();
+  }
+  NodeCollection::const_iterator target_begin =
+    target_nc->has_proxies() ? target_nc->MPI_local_begin() : target_nc->begin();
+  for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_nc->end(); ++tgt_it )
+  {
+    const Position< D > target_pos = target.get_position( ( *tgt_it ).lid );
+    for ( int i = 0; i < D; ++i )
+    {
+      anchor_box.lower_left[ i ] = std::min( anchor_box.lower_left[ i ], target_pos[ i ] );
+      anchor_box.upper_right[ i ] = std::max( anchor_box.upper_right[ i ], target_pos[ i ] );
+    }
+  }
+
+  if ( converse )
+  {
+    return new MaskedLayer< D >( source, mask_, allow_oversized_, target, source_nc, anchor_box );
+  }
+  return new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc, anchor_box );
+}
+
 template < int D >
 void
 ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
@@ -241,7 +428,7 @@ ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
   PoolWrapper_< D > pool;
   if ( mask_.get() ) // MaskedLayer will be freed by PoolWrapper d'tor
   {
-    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc ) );
+    pool.define( create_masked_source_( source, source_nc, target, target_nc, false ) );
   }
   else
   {
@@ -255,7 +442,11 @@ ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
     const int thread_id = kernel().vp_manager.get_thread_id();
     try
     {
-      NodeCollection::const_iterator target_begin = target_nc->begin();
+      std::vector< std::pair< Position< D >, size_t > > masked_positions;
+
+      // Nodes with proxies exist on a single virtual process only, so each thread only visits its own targets.
+      NodeCollection::const_iterator target_begin =
+        target_nc->has_proxies() ? target_nc->local_begin() : target_nc->begin();
       NodeCollection::const_iterator target_end = target_nc->end();
 
       for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
@@ -268,8 +459,10 @@ ConnectionCreator::pairwise_bernoulli_on_source_( Layer< D >& source,
 
           if ( mask_.get() )
           {
+            masked_positions.clear();
+            pool.get_nodes( target_pos, masked_positions );
             connect_to_target_(
-              pool.masked_begin( target_pos ), pool.masked_end(), tgt, target_pos, thread_id, source );
+              masked_positions.begin(), masked_positions.end(), tgt, target_pos, thread_id, source );
           }
           else
           {
@@ -318,7 +511,7 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
   {
     // By supplying the target layer to the MaskedLayer constructor, the
     // mask is mirrored so it may be applied to the source layer instead
-    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, target, source_nc ) );
+    pool.define( create_masked_source_( source, source_nc, target, target_nc, true ) );
   }
   else
   {
@@ -339,6 +532,7 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
     const int thread_id = kernel().vp_manager.get_thread_id();
     try
     {
+      std::vector< std::pair< Position< D >, size_t > > masked_positions;
       NodeCollection::const_iterator target_begin = target_nc->local_begin();
       NodeCollection::const_iterator target_end = target_nc->end();
 
@@ -354,7 +548,9 @@ ConnectionCreator::pairwise_bernoulli_on_target_( Layer< D >& source,
         {
           // We do the same as in the target driven case, except that we calculate displacements in the target layer.
           // We therefore send in target as last parameter.
-          connect_to_target_( pool.masked_begin( target_pos ), pool.masked_end(), tgt, target_pos, thread_id, target );
+          masked_positions.clear();
+          pool.get_nodes( target_pos, masked_positions );
+          connect_to_target_( masked_positions.begin(), masked_positions.end(), tgt, target_pos, thread_id, target );
         }
         else
         {
@@ -400,7 +596,7 @@ ConnectionCreator::pairwise_poisson_( Layer< D >& source,
   PoolWrapper_< D > pool;
   if ( mask_.get() ) // MaskedLayer will be freed by PoolWrapper d'tor
   {
-    pool.define( new MaskedLayer< D >( source, mask_, allow_oversized_, source_nc ) );
+    pool.define( create_masked_source_( source, source_nc, target, target_nc, false ) );
   }
   else
   {
@@ -414,7 +610,11 @@ ConnectionCreator::pairwise_poisson_( Layer< D >& source,
     const int thread_id = kernel().vp_manager.get_thread_id();
     try
     {
-      NodeCollection::const_iterator target_begin = target_nc->begin();
+      std::vector< std::pair< Position< D >, size_t > > masked_positions;
+
+      // Nodes with proxies exist on a single virtual process only, so each thread only visits its own targets.
+      NodeCollection::const_iterator target_begin =
+        target_nc->has_proxies() ? target_nc->local_begin() : target_nc->begin();
       NodeCollection::const_iterator target_end = target_nc->end();
 
       for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
@@ -427,8 +627,10 @@ ConnectionCreator::pairwise_poisson_( Layer< D >& source,
 
           if ( mask_.get() )
           {
+            masked_positions.clear();
+            pool.get_nodes( target_pos, masked_positions );
             connect_to_target_poisson_(
-              pool.masked_begin( target_pos ), pool.masked_end(), tgt, target_pos, thread_id, source );
+              masked_positions.begin(), masked_positions.end(), tgt, target_pos, thread_id, source );
           }
           else
           {
@@ -492,8 +694,8 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
 
   if ( mask_.get() )
   {
-    MaskedLayer< D > masked_source( source, mask_, allow_oversized_, source_nc );
-    const auto masked_source_end = masked_source.end();
+    std::unique_ptr< MaskedLayer< D > > masked_source(
+      create_masked_source_( source, source_nc, target, target_nc, false ) );
 
     std::vector< std::pair< Position< D >, size_t > > positions;
 
@@ -516,8 +718,8 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
         std::round( number_of_connections_->value( rng, source_pos_vector, target_pos_vector, source, tgt ) );
 
       // Get (position,node ID) pairs for sources inside mask
-      positions.resize( std::distance( masked_source.begin( target_pos ), masked_source_end ) );
-      std::copy( masked_source.begin( target_pos ), masked_source_end, positions.begin() );
+      positions.clear();
+      masked_source->get_nodes( target_pos, positions );
 
       // We will select `number_of_connections_` sources within the mask.
       // If there is no kernel, we can just draw uniform random numbers,
@@ -530,12 +732,22 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
         probabilities.reserve( positions.size() );
 
         // Collect probabilities for the sources
-        for ( typename std::vector< std::pair< Position< D >, size_t > >::iterator iter = positions.begin();
-              iter != positions.end();
-              ++iter )
+        if ( use_kernel_program_< D >() )
         {
-          iter->first.get_vector( source_pos_vector );
-          probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source, tgt ) );
+          ParameterBatch batch( D );
+          fill_parameter_batch_(
+            positions.begin(), positions.end(), target_pos_vector, source, kernel_program_.uses_displacement(), batch );
+          kernel_program_.evaluate( batch, probabilities );
+        }
+        else
+        {
+          for ( typename std::vector< std::pair< Position< D >, size_t > >::iterator iter = positions.begin();
+                iter != positions.end();
+                ++iter )
+          {
+            iter->first.get_vector( source_pos_vector );
+            probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source, tgt ) );
+          }
         }
 
         if ( positions.empty()
@@ -629,7 +841,7 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
     // no mask
 
     // Get (position,node ID) pairs for all nodes in source layer
-    std::vector< std::pair< Position< D >, size_t > >* positions = source.get_global_positions_vector( source_nc );
+    const auto positions = source.get_global_positions_vector( source_nc );
 
     for ( NodeCollection::const_iterator tgt_it = target_begin; tgt_it < target_end; ++tgt_it )
     {
@@ -663,12 +875,26 @@ ConnectionCreator::fixed_indegree_( Layer< D >& source,
         probabilities.reserve( positions->size() );
 
         // Collect probabilities for the sources
-        for ( typename std::vector< std::pair< Position< D >, size_t > >::iterator iter = positions->begin();
-              iter != positions->end();
-              ++iter )
+        if ( use_kernel_program_< D >() )
+        {
+          ParameterBatch batch( D );
+          fill_parameter_batch_( positions->begin(),
+            positions->end(),
+            target_pos_vector,
+            source,
+            kernel_program_.uses_displacement(),
+            batch );
+          kernel_program_.evaluate( batch, probabilities );
+        }
+        else
         {
-          iter->first.get_vector( source_pos_vector );
-          probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source, tgt ) );
+          for ( typename std::vector< std::pair< Position< D >, size_t > >::iterator iter = positions->begin();
+                iter != positions->end();
+                ++iter )
+          {
+            iter->first.get_vector( source_pos_vector );
+            probabilities.push_back( kernel_->value( rng, source_pos_vector, target_pos_vector, source, tgt ) );
+          }
         }
 
         // A discrete_distribution draws random integers with a non-uniform
@@ -787,7 +1013,6 @@ ConnectionCreator::fixed_outdegree_( Layer< D >& source,
   // 3. Draw connections to make using global rng
 
   MaskedLayer< D > masked_target( target, mask_, allow_oversized_, target_nc );
-  const auto masked_target_end = masked_target.end();
 
   // We create a target positions vector here that can be updated with the
   // position and node ID pairs. This is done to avoid creating and destroying
@@ -811,8 +1036,8 @@ ConnectionCreator::fixed_outdegree_( Layer< D >& source,
 
     // Find potential targets and probabilities
     RngPtr grng = get_rank_synced_rng();
-    target_pos_node_id_pairs.resize( std::distance( masked_target.begin( source_pos ), masked_target_end ) );
-    std::copy( masked_target.begin( source_pos ), masked_target_end, target_pos_node_id_pairs.begin() );
+    target_pos_node_id_pairs.clear();
+    masked_target.get_nodes( source_pos, target_pos_node_id_pairs );
 
     probabilities.reserve( target_pos_node_id_pairs.size() );
     if ( kernel_ )
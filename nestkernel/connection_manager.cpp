@@ -30,6 +30,7 @@
 #include <cassert>
 #include <cmath>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <set>
 #include <vector>
@@ -53,12 +54,14 @@
 #include "kernel_manager.h"
 #include "mpi_manager_impl.h"
 #include "nest_names.h"
+#include "network_snapshot.h"
 #include "node.h"
 #include "sonata_connector.h"
 #include "target_table_devices_impl.h"
 #include "vp_manager_impl.h"
 
 // Includes from sli:
+#include "arraydatum.h"
 #include "dictutils.h"
 #include "sliexceptions.h"
 #include "token.h"
@@ -69,10 +72,14 @@ nest::ConnectionManager::ConnectionManager()
   : connruledict_( new Dictionary() )
   , connbuilder_factories_()
   , min_delay_( 1 )
+  , min_connection_delay_( 1 )
+  , spike_communication_overlapped_( false )
   , max_delay_( 1 )
   , keep_source_table_( true )
   , connections_have_changed_( false )
   , get_connections_has_been_called_( false )
+  , full_update_required_( true )
+  , incremental_update_( false )
   , use_compressed_spikes_( true )
   , has_primary_connections_( false )
   , check_primary_connections_()
@@ -117,6 +124,8 @@ nest::ConnectionManager::initialize( const bool adjust_number_of_threads_or_rng_
     use_compressed_spikes_ = true;
     stdp_eps_ = 1.0e-6;
     min_delay_ = max_delay_ = 1;
+    min_connection_delay_ = 1;
+    spike_communication_overlapped_ = false;
     sw_construction_connect.reset();
   }
 
@@ -125,6 +134,10 @@ nest::ConnectionManager::initialize( const bool adjust_number_of_threads_or_rng_
   secondary_recv_buffer_pos_.resize( num_threads );
   compressed_spike_data_.resize( 0 );
 
+  // The first update builds the connection infrastructure from scratch.
+  full_update_required_ = true;
+  incremental_update_ = false;
+
   has_primary_connections_ = false;
   check_primary_connections_.initialize( num_threads, false );
   secondary_connections_exist_ = false;
@@ -190,7 +203,10 @@ nest::ConnectionManager::set_status( const DictionaryDatum& d )
       "to false." );
   }
 
-  updateValue< bool >( d, names::use_compressed_spikes, use_compressed_spikes_ );
+  if ( updateValue< bool >( d, names::use_compressed_spikes, use_compressed_spikes_ ) )
+  {
+    full_update_required_ = true;
+  }
 
   //  Need to update the saved values if we have changed the delay bounds.
   if ( d->known( names::min_delay ) or d->known( names::max_delay ) )
@@ -209,7 +225,7 @@ void
 nest::ConnectionManager::get_status( DictionaryDatum& dict )
 {
   update_delay_extrema_();
-  def< double >( dict, names::min_delay, Time( Time::step( min_delay_ ) ).get_ms() );
+  def< double >( dict, names::min_delay, Time( Time::step( min_connection_delay_ ) ).get_ms() );
   def< double >( dict, names::max_delay, Time( Time::step( max_delay_ ) ).get_ms() );
 
   const size_t n = get_num_connections();
@@ -322,6 +338,204 @@ nest::ConnectionManager::set_synapse_status( const size_t source_node_id,
   }
 }
 
+void
+nest::ConnectionManager::group_connections_( const std::vector< ConnectionID >& conns,
+  std::vector< std::vector< std::vector< size_t > > >& positions,
+  std::vector< size_t >& device_positions ) const
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  positions.assign(
+    num_threads, std::vector< std::vector< size_t > >( kernel().model_manager.get_num_connection_models() ) );
+
+  for ( size_t i = 0; i < conns.size(); ++i )
+  {
+    const ConnectionID& conn = conns[ i ];
+    if ( conn.get_target_thread() < 0 or static_cast< size_t >( conn.get_target_thread() ) >= num_threads )
+    {
+      throw BadParameter( String::compose( "Invalid target thread %1 of connection.", conn.get_target_thread() ) );
+    }
+    const size_t tid = conn.get_target_thread();
+    const synindex syn_id = conn.get_synapse_model_id();
+    kernel().model_manager.assert_valid_syn_id( syn_id, tid );
+
+    const Node* source = kernel().node_manager.get_node_or_proxy( conn.get_source_node_id(), tid );
+    const Node* target = kernel().node_manager.get_node_or_proxy( conn.get_target_node_id(), tid );
+
+    // synapses from neurons to neurons and from neurons to globally
+    // receiving devices, see get_synapse_status()
+    if ( source->has_proxies() and ( target->has_proxies() or not target->local_receiver() )
+      and connections_[ tid ][ syn_id ] )
+    {
+      if ( static_cast< size_t >( conn.get_port() ) >= connections_[ tid ][ syn_id ]->size() )
+      {
+        throw BadParameter( String::compose( "Invalid port %1 of connection.", conn.get_port() ) );
+      }
+      positions[ tid ][ syn_id ].push_back( i );
+    }
+    else
+    {
+      device_positions.push_back( i );
+    }
+  }
+}
+
+void
+nest::ConnectionManager::get_connection_values( const std::vector< ConnectionID >& conns,
+  const Name& name,
+  double* values ) const
+{
+  std::vector< std::vector< std::vector< size_t > > > positions;
+  std::vector< size_t > device_positions;
+  group_connections_( conns, positions, device_positions );
+
+  // Reading the status creates datums, which is not thread-safe, so all threads' connections are read here.
+  std::vector< size_t > lcids;
+  std::vector< double > syn_values;
+  for ( size_t tid = 0; tid < positions.size(); ++tid )
+  {
+    for ( synindex syn_id = 0; syn_id < positions[ tid ].size(); ++syn_id )
+    {
+      const std::vector< size_t >& syn_positions = positions[ tid ][ syn_id ];
+      if ( syn_positions.empty() )
+      {
+        continue;
+      }
+
+      lcids.clear();
+      syn_values.clear();
+      for ( const size_t i : syn_positions )
+      {
+        lcids.push_back( conns[ i ].get_port() );
+      }
+      connections_[ tid ][ syn_id ]->get_synapse_values( name, lcids, syn_values );
+      for ( size_t j = 0; j < syn_positions.size(); ++j )
+      {
+        values[ syn_positions[ j ] ] = syn_values[ j ];
+      }
+    }
+  }
+
+  for ( const size_t i : device_positions )
+  {
+    const ConnectionID& conn = conns[ i ];
+    const DictionaryDatum dict = get_synapse_status( conn.get_source_node_id(),
+      conn.get_target_node_id(),
+      conn.get_target_thread(),
+      conn.get_synapse_model_id(),
+      conn.get_port() );
+    values[ i ] = getValue< double >( dict->lookup2( name ) );
+  }
+}
+
+void
+nest::ConnectionManager::set_connection_values( const std::vector< ConnectionID >& conns,
+  const std::vector< Name >& names,
+  const double* values )
+{
+  std::vector< std::vector< std::vector< size_t > > > positions;
+  std::vector< size_t > device_positions;
+  group_connections_( conns, positions, device_positions );
+
+  const size_t n = conns.size();
+  for ( const size_t i : device_positions )
+  {
+    const ConnectionID& conn = conns[ i ];
+    DictionaryDatum dict( new Dictionary );
+    for ( size_t k = 0; k < names.size(); ++k )
+    {
+      def< double >( dict, names[ k ], values[ k * n + i ] );
+    }
+    set_synapse_status( conn.get_source_node_id(),
+      conn.get_target_node_id(),
+      conn.get_target_thread(),
+      conn.get_synapse_model_id(),
+      conn.get_port(),
+      dict );
+    ALL_ENTRIES_ACCESSED( *dict, "SetStatus", "Unread dictionary entries: " );
+  }
+
+  // Datums cannot be created in parallel, so each thread gets its own dictionary whose entries are changed in place.
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  std::vector< DictionaryDatum > param_dicts;
+  std::vector< std::vector< DoubleDatum* > > param_entries( num_threads );
+  for ( size_t tid = 0; tid < num_threads; ++tid )
+  {
+    param_dicts.emplace_back( new Dictionary );
+    for ( const Name& name : names )
+    {
+      ( *param_dicts[ tid ] )[ name ] = Token( new DoubleDatum( 0.0 ) );
+      param_entries[ tid ].push_back( static_cast< DoubleDatum* >( ( *param_dicts[ tid ] )[ name ].datum() ) );
+    }
+  }
+
+  // Vector for storing exceptions raised by threads.
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
+
+#pragma omp parallel
+  {
+    const size_t tid = kernel().vp_manager.get_thread_id();
+    try
+    {
+      std::vector< size_t > lcids;
+      std::vector< double > syn_values;
+      for ( synindex syn_id = 0; syn_id < positions[ tid ].size(); ++syn_id )
+      {
+        const std::vector< size_t >& syn_positions = positions[ tid ][ syn_id ];
+        if ( syn_positions.empty() )
+        {
+          continue;
+        }
+
+        lcids.clear();
+        syn_values.clear();
+        for ( const size_t i : syn_positions )
+        {
+          lcids.push_back( conns[ i ].get_port() );
+        }
+        for ( size_t k = 0; k < names.size(); ++k )
+        {
+          for ( const size_t i : syn_positions )
+          {
+            syn_values.push_back( values[ k * n + i ] );
+          }
+        }
+
+        ConnectorModel& cm = kernel().model_manager.get_connection_model( syn_id, tid );
+        param_dicts[ tid ]->clear_access_flags();
+        try
+        {
+          connections_[ tid ][ syn_id ]->set_synapse_values(
+            lcids, param_entries[ tid ], syn_values, param_dicts[ tid ], cm );
+        }
+        catch ( BadProperty& e )
+        {
+          throw BadProperty(
+            String::compose( "Setting status of '%1' connections: %2", cm.get_name(), e.message() ) );
+        }
+
+        ALL_ENTRIES_ACCESSED2( *param_dicts[ tid ],
+          "SetStatus",
+          "Unread dictionary entries: ",
+          "Maybe you tried to set common synapse properties through an individual "
+          "synapse?" );
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at the end of the catch block.
+      exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  }
+  // check if any exceptions have been raised
+  for ( size_t tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
+}
+
 void
 nest::ConnectionManager::delete_connections_()
 {
@@ -532,6 +746,17 @@ nest::ConnectionManager::update_delay_extrema_()
   {
     min_delay_ = Time::get_resolution().get_steps();
   }
+
+  // Spikes emitted in one slice are delivered at the beginning of the slice after next if spike
+  // communication is overlapped with the update. Slices must then not be longer than half the
+  // smallest delay.
+  min_connection_delay_ = min_delay_;
+  spike_communication_overlapped_ =
+    kernel().event_delivery_manager.get_overlap_spike_communication() and min_delay_ > 1;
+  if ( spike_communication_overlapped_ )
+  {
+    min_delay_ /= 2;
+  }
 }
 
 // node ID node thread syn_id dict delay weight
@@ -608,6 +833,102 @@ nest::ConnectionManager::connect( const size_t snode_id,
   return connected;
 }
 
+void
+nest::ConnectionManager::sort_connections_by_target_thread_( const long* sources,
+  const long* targets,
+  const size_t n,
+  std::vector< size_t >& order,
+  std::vector< size_t >& bucket_begin )
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+  // Connections to nodes without proxies go to the last bucket, connections to targets on other processes to none.
+  const size_t shared_bucket = num_threads;
+  const size_t no_bucket = num_threads + 1;
+  std::vector< size_t > bucket( n );
+
+  // Each thread handles a contiguous chunk of the connections. The entries first hold the number of connections
+  // per chunk and bucket, then the position at which the chunk writes its next connection of the bucket.
+  std::vector< std::vector< size_t > > chunk_offsets( num_threads, std::vector< size_t >( num_threads + 1, 0 ) );
+
+  // Vector for storing exceptions raised by threads.
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
+
+#pragma omp parallel
+  {
+    const size_t tid = kernel().vp_manager.get_thread_id();
+    try
+    {
+      for ( size_t i = n * tid / num_threads; i < n * ( tid + 1 ) / num_threads; ++i )
+      {
+        if ( 0 >= sources[ i ] or static_cast< size_t >( sources[ i ] ) > kernel().node_manager.size() )
+        {
+          throw UnknownNode( sources[ i ] );
+        }
+        if ( 0 >= targets[ i ] or static_cast< size_t >( targets[ i ] ) > kernel().node_manager.size() )
+        {
+          throw UnknownNode( targets[ i ] );
+        }
+
+        if ( not kernel().modelrange_manager.get_model_of_node_id( targets[ i ] )->has_proxies() )
+        {
+          bucket[ i ] = shared_bucket;
+        }
+        else
+        {
+          const size_t vp = kernel().vp_manager.node_id_to_vp( targets[ i ] );
+          bucket[ i ] = kernel().vp_manager.is_local_vp( vp ) ? kernel().vp_manager.vp_to_thread( vp ) : no_bucket;
+        }
+
+        if ( bucket[ i ] != no_bucket )
+        {
+          ++chunk_offsets[ tid ][ bucket[ i ] ];
+        }
+      }
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at the end of the catch block.
+      exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  }
+  // check if any exceptions have been raised
+  for ( size_t tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
+
+  bucket_begin.assign( num_threads + 2, 0 );
+  size_t position = 0;
+  for ( size_t b = 0; b <= shared_bucket; ++b )
+  {
+    bucket_begin[ b ] = position;
+    for ( size_t chunk = 0; chunk < num_threads; ++chunk )
+    {
+      const size_t count = chunk_offsets[ chunk ][ b ];
+      chunk_offsets[ chunk ][ b ] = position;
+      position += count;
+    }
+  }
+  bucket_begin[ shared_bucket + 1 ] = position;
+  order.resize( position );
+
+#pragma omp parallel
+  {
+    const size_t tid = kernel().vp_manager.get_thread_id();
+    for ( size_t i = n * tid / num_threads; i < n * ( tid + 1 ) / num_threads; ++i )
+    {
+      if ( bucket[ i ] != no_bucket )
+      {
+        order[ chunk_offsets[ tid ][ bucket[ i ] ]++ ] = i;
+      }
+    }
+  }
+}
+
 void
 nest::ConnectionManager::connect_arrays( long* sources,
   long* targets,
@@ -621,148 +942,128 @@ nest::ConnectionManager::connect_arrays( long* sources,
   // only place, where stopwatch sw_construction_connect is needed in addition to nestmodule.cpp
   sw_construction_connect.start();
 
-  // Mapping pointers to the first parameter value of each parameter to their respective names.
-  // The bool indicates whether the value is an integer or not, and is determined at a later point.
-  std::map< Name, std::pair< double*, bool > > param_pointers;
-  if ( p_keys.size() != 0 )
-  {
-    size_t i = 0;
-    for ( auto& key : p_keys )
-    {
-      // Shifting the pointer to the first value of the parameter.
-      param_pointers[ key ] = std::make_pair( p_values + i * n, false );
-      ++i;
-    }
-  }
-
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
   const auto synapse_model_id = kernel().model_manager.get_synapse_model_id( syn_model );
   const auto syn_model_defaults = kernel().model_manager.get_connector_defaults( synapse_model_id );
 
-  // Dictionary holding additional synapse parameters, passed to the connect call.
+  // Pointers to the first value of each parameter, separated by type. The type is given by the default value of the
+  // parameter. For each thread, the datums of the dictionary holding the additional synapse parameters are resolved
+  // once in the same order, so that their values can be changed in place for each connection.
+  std::vector< const double* > double_columns;
+  std::vector< const double* > integer_columns;
+  std::vector< Name > integer_names;
   std::vector< DictionaryDatum > param_dicts;
-  param_dicts.reserve( kernel().vp_manager.get_num_threads() );
-  for ( size_t i = 0; i < kernel().vp_manager.get_num_threads(); ++i )
+  std::vector< std::vector< DoubleDatum* > > double_datums( num_threads );
+  std::vector< std::vector< IntegerDatum* > > integer_datums( num_threads );
+  param_dicts.reserve( num_threads );
+  for ( size_t tid = 0; tid < num_threads; ++tid )
   {
     param_dicts.emplace_back( new Dictionary );
-    for ( auto& param_key : p_keys )
+  }
+
+  for ( size_t k = 0; k < p_keys.size(); ++k )
+  {
+    const Name param_name = p_keys[ k ]; // Convert string to Name
+    // Check that the parameter exists for the synapse model.
+    const auto syn_model_default_it = syn_model_defaults->find( param_name );
+    if ( syn_model_default_it == syn_model_defaults->end() )
     {
-      const Name param_name = param_key; // Convert string to Name
-      // Check that the parameter exists for the synapse model.
-      const auto syn_model_default_it = syn_model_defaults->find( param_name );
-      if ( syn_model_default_it == syn_model_defaults->end() )
-      {
-        throw BadParameter( syn_model + " does not have parameter " + param_key );
-      }
+      throw BadParameter( syn_model + " does not have parameter " + p_keys[ k ] );
+    }
+    if ( param_dicts[ 0 ]->known( param_name ) )
+    {
+      throw BadParameter( "Parameter " + p_keys[ k ] + " is given more than once." );
+    }
 
-      // If the default value is an integer, the synapse parameter must also be an integer.
-      if ( dynamic_cast< IntegerDatum* >( syn_model_default_it->second.datum() ) )
+    // If the default value is an integer, the synapse parameter must also be an integer.
+    const bool is_integer = dynamic_cast< IntegerDatum* >( syn_model_default_it->second.datum() );
+    if ( is_integer )
+    {
+      integer_columns.push_back( p_values + k * n );
+      integer_names.push_back( param_name );
+    }
+    else
+    {
+      double_columns.push_back( p_values + k * n );
+    }
+
+    for ( size_t tid = 0; tid < num_threads; ++tid )
+    {
+      if ( is_integer )
       {
-        param_pointers[ param_key ].second = true;
-        ( *param_dicts[ i ] )[ param_key ] = Token( new IntegerDatum( 0 ) );
+        IntegerDatum* id = new IntegerDatum( 0 );
+        ( *param_dicts[ tid ] )[ param_name ] = Token( id );
+        integer_datums[ tid ].push_back( id );
       }
       else
       {
-        ( *param_dicts[ i ] )[ param_key ] = Token( new DoubleDatum( 0.0 ) );
+        DoubleDatum* dd = new DoubleDatum( 0.0 );
+        ( *param_dicts[ tid ] )[ param_name ] = Token( dd );
+        double_datums[ tid ].push_back( dd );
       }
     }
   }
 
-  // Increments pointers to weight and delay, if they are specified.
-  auto increment_wd = [ weights, delays ]( decltype( weights ) & w, decltype( delays ) & d )
-  {
-    if ( weights )
-    {
-      ++w;
-    }
-    if ( delays )
-    {
-      ++d;
-    }
-  };
+  // Each thread only handles the connections to its own targets, and the connections to nodes without proxies,
+  // which exist on every thread. Both are given by consecutive ranges of order.
+  std::vector< size_t > order;
+  std::vector< size_t > bucket_begin;
+  sort_connections_by_target_thread_( sources, targets, n, order, bucket_begin );
 
   // Set flag before entering parallel section in case we have fewer connections than ranks.
   set_connections_have_changed();
 
   // Vector for storing exceptions raised by threads.
-  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( kernel().vp_manager.get_num_threads() );
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
 
 #pragma omp parallel
   {
     const auto tid = kernel().vp_manager.get_thread_id();
     try
     {
-      auto s = sources;
-      auto t = targets;
-      auto w = weights;
-      auto d = delays;
-      double weight_buffer = numerics::nan;
-      double delay_buffer = numerics::nan;
-      int index_counter = 0; // Index of the current connection, for connection parameters
+      auto own = order.cbegin() + bucket_begin[ tid ];
+      const auto own_end = order.cbegin() + bucket_begin[ tid + 1 ];
+      auto shared = order.cbegin() + bucket_begin[ num_threads ];
+      const auto shared_end = order.cbegin() + bucket_begin[ num_threads + 1 ];
 
-      for ( ; s != sources + n; ++s, ++t, ++index_counter )
+      // Both ranges are sorted by index, so merging them creates the connections in the order they are given.
+      while ( own != own_end or shared != shared_end )
       {
-        if ( 0 >= *s or static_cast< size_t >( *s ) > kernel().node_manager.size() )
-        {
-          throw UnknownNode( *s );
-        }
-        if ( 0 >= *t or static_cast< size_t >( *t ) > kernel().node_manager.size() )
-        {
-          throw UnknownNode( *t );
-        }
-        auto target_node = kernel().node_manager.get_node_or_proxy( *t, tid );
+        const size_t i = ( shared == shared_end or ( own != own_end and *own < *shared ) ) ? *own++ : *shared++;
+
+        auto target_node = kernel().node_manager.get_node_or_proxy( targets[ i ], tid );
         if ( target_node->is_proxy() )
         {
-          increment_wd( w, d );
           continue;
         }
 
-        // If weights or delays are specified, the buffers are replaced with the values.
-        // If not, the buffers will be NaN and replaced by a default value by the connect function.
-        if ( weights )
-        {
-          weight_buffer = *w;
-        }
-        if ( delays )
+        // If weights or delays are not specified, NaN is replaced by a default value by the connect function.
+        const double weight = weights ? weights[ i ] : numerics::nan;
+        const double delay = delays ? delays[ i ] : numerics::nan;
+
+        // Change values of dictionary entries without allocating new datums.
+        for ( size_t k = 0; k < double_columns.size(); ++k )
         {
-          delay_buffer = *d;
+          ( *double_datums[ tid ][ k ] ) = double_columns[ k ][ i ];
         }
-
-        // Store the key-value pair of each parameter in the Dictionary.
-        for ( auto& param_pointer_pair : param_pointers )
+        for ( size_t k = 0; k < integer_columns.size(); ++k )
         {
-          // Increment the pointer to the parameter value.
-          const auto param_pointer = param_pointer_pair.second.first;
-          const auto is_int = param_pointer_pair.second.second;
-          auto* param = param_pointer + index_counter;
+          const double value = integer_columns[ k ][ i ];
+          const auto rtype_as_long = static_cast< long >( value );
 
-          // Integer parameters are stored as IntegerDatums.
-          if ( is_int )
+          if ( value > 1L << 31 or std::abs( value - rtype_as_long ) > 0 ) // To avoid rounding errors
           {
-            const auto rtype_as_long = static_cast< long >( *param );
-
-            if ( *param > 1L << 31 or std::abs( *param - rtype_as_long ) > 0 ) // To avoid rounding errors
-            {
-              const auto msg = std::string( "Expected integer value for " ) + param_pointer_pair.first.toString()
-                + ", but got double.";
-              throw BadParameter( msg );
-            }
-
-            // Change value of dictionary entry without allocating new datum.
-            auto id = static_cast< IntegerDatum* >( ( ( *param_dicts[ tid ] )[ param_pointer_pair.first ] ).datum() );
-            ( *id ) = rtype_as_long;
-          }
-          else
-          {
-            auto dd = static_cast< DoubleDatum* >( ( ( *param_dicts[ tid ] )[ param_pointer_pair.first ] ).datum() );
-            ( *dd ) = *param;
+            const auto msg =
+              std::string( "Expected integer value for " ) + integer_names[ k ].toString() + ", but got double.";
+            throw BadParameter( msg );
           }
+
+          ( *integer_datums[ tid ][ k ] ) = rtype_as_long;
         }
 
-        connect( *s, target_node, tid, synapse_model_id, param_dicts[ tid ], delay_buffer, weight_buffer );
+        connect( sources[ i ], target_node, tid, synapse_model_id, param_dicts[ tid ], delay, weight );
 
         ALL_ENTRIES_ACCESSED( *param_dicts[ tid ], "connect_arrays", "Unread dictionary entries: " );
-
-        increment_wd( w, d );
       }
     }
     catch ( std::exception& err )
@@ -772,7 +1073,7 @@ nest::ConnectionManager::connect_arrays( long* sources,
     }
   }
   // check if any exceptions have been raised
-  for ( size_t tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+  for ( size_t tid = 0; tid < num_threads; ++tid )
   {
     if ( exceptions_raised.at( tid ).get() )
     {
@@ -961,6 +1262,92 @@ nest::ConnectionManager::increase_connection_count( const size_t tid, const syni
   }
 }
 
+void
+nest::ConnectionManager::write_snapshot( const size_t tid, std::ostream& os )
+{
+  if ( source_table_.is_cleared() )
+  {
+    throw KernelException( "Network snapshots require the kernel attribute keep_source_table to be true." );
+  }
+
+  std::vector< synindex > syn_ids;
+  size_t num_connections = 0;
+  for ( synindex syn_id = 0; syn_id < connections_[ tid ].size(); ++syn_id )
+  {
+    if ( syn_id < num_connections_[ tid ].size() )
+    {
+      num_connections += num_connections_[ tid ][ syn_id ];
+    }
+    if ( connections_[ tid ][ syn_id ] and connections_[ tid ][ syn_id ]->size() > 0 )
+    {
+      const ConnectorModel& conn_model = kernel().model_manager.get_connection_model( syn_id, tid );
+      if ( not conn_model.supports_snapshots() )
+      {
+        throw NotImplemented(
+          String::compose( "Connections of synapse model %1 cannot be saved.", conn_model.get_name() ) );
+      }
+      syn_ids.push_back( syn_id );
+    }
+  }
+
+  write_binary< uint64_t >( os, syn_ids.size() );
+  size_t num_written = 0;
+  for ( const synindex syn_id : syn_ids )
+  {
+    write_binary< uint64_t >( os, syn_id );
+    num_written += connections_[ tid ][ syn_id ]->write_snapshot(
+      tid, source_table_.get_thread_local_sources( tid )[ syn_id ], os );
+  }
+
+  // Connections to and from devices are counted, but not stored in connectors.
+  if ( num_written != num_connections )
+  {
+    throw NotImplemented(
+      "Connections to or from devices cannot be saved. Create them after loading the network." );
+  }
+}
+
+void
+nest::ConnectionManager::read_snapshot( const size_t tid, std::istream& is, const std::vector< synindex >& syn_ids )
+{
+  std::vector< size_t > source_node_ids;
+
+  const size_t num_syn_ids = read_binary< uint64_t >( is );
+  for ( size_t i = 0; i < num_syn_ids; ++i )
+  {
+    const synindex syn_id = syn_ids.at( read_binary< uint64_t >( is ) );
+    ConnectorModel& conn_model = kernel().model_manager.get_connection_model( syn_id, tid );
+    const bool is_primary = conn_model.has_property( ConnectionModelProperties::IS_PRIMARY );
+
+    source_node_ids.clear();
+    conn_model.read_snapshot( is, tid, connections_[ tid ], syn_id, source_node_ids );
+
+    for ( const size_t source_node_id : source_node_ids )
+    {
+      source_table_.add_source( tid, syn_id, source_node_id, is_primary );
+      increase_connection_count( tid, syn_id );
+    }
+
+    if ( source_node_ids.empty() )
+    {
+      continue;
+    }
+
+    if ( check_primary_connections_[ tid ].is_false() and is_primary )
+    {
+#pragma omp atomic write
+      has_primary_connections_ = true;
+      check_primary_connections_.set_true( tid );
+    }
+    else if ( check_secondary_connections_[ tid ].is_false() and not is_primary )
+    {
+#pragma omp atomic write
+      secondary_connections_exist_ = true;
+      check_secondary_connections_.set_true( tid );
+    }
+  }
+}
+
 size_t
 nest::ConnectionManager::find_connection( const size_t tid,
   const synindex syn_id,
@@ -1006,6 +1393,9 @@ nest::ConnectionManager::disconnect( const size_t tid,
   source_table_.disable_connection( tid, syn_id, lcid );
 
   --num_connections_[ tid ][ syn_id ];
+
+#pragma omp atomic write
+  full_update_required_ = true;
 }
 
 void
@@ -1014,14 +1404,15 @@ nest::ConnectionManager::trigger_update_weight( const long vt_id,
   const double t_trig )
 {
   const size_t tid = kernel().vp_manager.get_thread_id();
+  const std::vector< ConnectorModel* >& cm = kernel().model_manager.get_connection_models( tid );
 
+  // Connectors of synapse models not bound to the volume transmitter return immediately.
   for ( std::vector< ConnectorBase* >::iterator it = connections_[ tid ].begin(); it != connections_[ tid ].end();
         ++it )
   {
     if ( *it )
     {
-      ( *it )->trigger_update_weight(
-        vt_id, tid, dopa_spikes, t_trig, kernel().model_manager.get_connection_models( tid ) );
+      ( *it )->trigger_update_weight( vt_id, tid, dopa_spikes, t_trig, cm );
     }
   }
 }
@@ -1073,7 +1464,88 @@ nest::ConnectionManager::get_num_connections( const synindex syn_id ) const
 ArrayDatum
 nest::ConnectionManager::get_connections( const DictionaryDatum& params )
 {
-  std::deque< ConnectionID > connectome;
+  std::vector< std::vector< ConnectionID > > connectome;
+  collect_connections_( params, connectome );
+
+  size_t num_connections = 0;
+  for ( const auto& segment : connectome )
+  {
+    num_connections += segment.size();
+  }
+
+  ArrayDatum result;
+  result.reserve( num_connections );
+
+  for ( auto& segment : connectome )
+  {
+    for ( const auto& conn_id : segment )
+    {
+      result.push_back( ConnectionDatum( conn_id ) );
+    }
+    // Release the memory of each segment as soon as it has been copied.
+    std::vector< ConnectionID >().swap( segment );
+  }
+
+  return result;
+}
+
+DictionaryDatum
+nest::ConnectionManager::get_connection_columns( const DictionaryDatum& params )
+{
+  std::vector< std::vector< ConnectionID > > connectome;
+  collect_connections_( params, connectome );
+
+  // Position of the first connection of each segment in the columns.
+  std::vector< size_t > offsets( connectome.size() + 1, 0 );
+  for ( size_t i = 0; i < connectome.size(); ++i )
+  {
+    offsets[ i + 1 ] = offsets[ i ] + connectome[ i ].size();
+  }
+  const size_t num_connections = offsets.back();
+
+  IntVectorDatum sources( new std::vector< long >( num_connections ) );
+  IntVectorDatum targets( new std::vector< long >( num_connections ) );
+  IntVectorDatum target_threads( new std::vector< long >( num_connections ) );
+  IntVectorDatum synapse_ids( new std::vector< long >( num_connections ) );
+  IntVectorDatum ports( new std::vector< long >( num_connections ) );
+
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+#pragma omp parallel
+  {
+    const size_t tid = kernel().vp_manager.get_thread_id();
+
+    // Each thread copies the segments it has collected to their place in the columns.
+    for ( size_t i = tid; i < connectome.size(); i += num_threads )
+    {
+      size_t index = offsets[ i ];
+      for ( const auto& conn_id : connectome[ i ] )
+      {
+        ( *sources )[ index ] = conn_id.get_source_node_id();
+        ( *targets )[ index ] = conn_id.get_target_node_id();
+        ( *target_threads )[ index ] = conn_id.get_target_thread();
+        ( *synapse_ids )[ index ] = conn_id.get_synapse_model_id();
+        ( *ports )[ index ] = conn_id.get_port();
+        ++index;
+      }
+      std::vector< ConnectionID >().swap( connectome[ i ] );
+    }
+  }
+
+  DictionaryDatum result( new Dictionary );
+  ( *result )[ names::source ] = sources;
+  ( *result )[ names::target ] = targets;
+  ( *result )[ names::target_thread ] = target_threads;
+  ( *result )[ names::synapse_id ] = synapse_ids;
+  ( *result )[ names::port ] = ports;
+
+  return result;
+}
+
+void
+nest::ConnectionManager::collect_connections_( const DictionaryDatum& params,
+  std::vector< std::vector< ConnectionID > >& connectome )
+{
   const Token& source_t = params->lookup( names::source );
   const Token& target_t = params->lookup( names::target );
   const Token& syn_model_t = params->lookup( names::synapse_model );
@@ -1121,48 +1593,32 @@ nest::ConnectionManager::get_connections( const DictionaryDatum& params )
   }
 
   // We check, whether a synapse model is given. If not, we will iterate all.
-  size_t syn_id = 0;
+  std::vector< synindex > syn_ids;
   if ( not syn_model_t.empty() )
   {
     const std::string synmodel_name = getValue< std::string >( syn_model_t );
     // The following throws UnknownSynapseType for invalid synmodel_name
-    syn_id = kernel().model_manager.get_synapse_model_id( synmodel_name );
-    get_connections( connectome, source_a, target_a, syn_id, synapse_label );
+    syn_ids.push_back( kernel().model_manager.get_synapse_model_id( synmodel_name ) );
   }
   else
   {
-    for ( syn_id = 0; syn_id < kernel().model_manager.get_num_connection_models(); ++syn_id )
+    for ( synindex syn_id = 0; syn_id < kernel().model_manager.get_num_connection_models(); ++syn_id )
     {
-      get_connections( connectome, source_a, target_a, syn_id, synapse_label );
+      syn_ids.push_back( syn_id );
     }
   }
 
-  ArrayDatum result;
-  result.reserve( connectome.size() );
-
-  while ( not connectome.empty() )
+  // Connections are collected in one segment per synapse type and thread, ordered by synapse type first.
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  connectome.reserve( syn_ids.size() * num_threads );
+  for ( const synindex syn_id : syn_ids )
   {
-    result.push_back( ConnectionDatum( connectome.front() ) );
-    connectome.pop_front();
+    std::vector< std::vector< ConnectionID > > conns_per_thread( num_threads );
+    get_connections( conns_per_thread, source_a, target_a, syn_id, synapse_label );
+    std::move( conns_per_thread.begin(), conns_per_thread.end(), std::back_inserter( connectome ) );
   }
 
   get_connections_has_been_called_ = true;
-
-  return result;
-}
-
-// Helper method which removes ConnectionIDs from input deque and
-// appends them to output deque.
-static inline std::deque< nest::ConnectionID >&
-extend_connectome( std::deque< nest::ConnectionID >& out, std::deque< nest::ConnectionID >& in )
-{
-  while ( not in.empty() )
-  {
-    out.push_back( in.front() );
-    in.pop_front();
-  }
-
-  return out;
 }
 
 void
@@ -1188,10 +1644,13 @@ nest::ConnectionManager::split_to_neuron_device_vectors_( const size_t tid,
       device_node_ids.push_back( node_id );
     }
   }
+
+  // Sorted node IDs allow the connectors to test targets by binary search.
+  std::sort( neuron_node_ids.begin(), neuron_node_ids.end() );
 }
 
 void
-nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome,
+nest::ConnectionManager::get_connections( std::vector< std::vector< ConnectionID > >& connectome,
   NodeCollectionPTR source,
   NodeCollectionPTR target,
   synindex syn_id,
@@ -1217,13 +1676,14 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
     {
       size_t tid = kernel().vp_manager.get_thread_id();
 
-      std::deque< ConnectionID > conns_in_thread;
+      std::vector< ConnectionID >& conns_in_thread = connectome[ tid ];
 
       ConnectorBase* connections = connections_[ tid ][ syn_id ];
       if ( connections )
       {
         // Passing target_node_id = 0 ignores target_node_id while getting connections.
         const size_t num_connections_in_thread = connections->size();
+        conns_in_thread.reserve( num_connections_in_thread );
         for ( size_t lcid = 0; lcid < num_connections_in_thread; ++lcid )
         {
           const size_t source_node_id = source_table_.get_node_id( tid, syn_id, lcid );
@@ -1232,14 +1692,6 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
       }
 
       target_table_devices_.get_connections( 0, 0, tid, syn_id, synapse_label, conns_in_thread );
-
-      if ( conns_in_thread.size() > 0 )
-      {
-#pragma omp critical( get_connections )
-        {
-          extend_connectome( connectome, conns_in_thread );
-        }
-      }
     } // of omp parallel
     return;
   } // if
@@ -1249,7 +1701,7 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
     {
       size_t tid = kernel().vp_manager.get_thread_id();
 
-      std::deque< ConnectionID > conns_in_thread;
+      std::vector< ConnectionID >& conns_in_thread = connectome[ tid ];
 
       // Split targets into neuron- and device-vectors.
       std::vector< size_t > target_neuron_node_ids;
@@ -1282,14 +1734,6 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
         target_table_devices_.get_connections_to_devices_(
           0, t_device_id, tid, syn_id, synapse_label, conns_in_thread );
       }
-
-      if ( conns_in_thread.size() > 0 )
-      {
-#pragma omp critical( get_connections )
-        {
-          extend_connectome( connectome, conns_in_thread );
-        }
-      }
     } // of omp parallel
     return;
   } // else if
@@ -1299,7 +1743,7 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
     {
       size_t tid = kernel().vp_manager.get_thread_id();
 
-      std::deque< ConnectionID > conns_in_thread;
+      std::vector< ConnectionID >& conns_in_thread = connectome[ tid ];
 
       // Split targets into neuron- and device-vectors.
       std::vector< size_t > target_neuron_node_ids;
@@ -1362,14 +1806,6 @@ nest::ConnectionManager::get_connections( std::deque< ConnectionID >& connectome
           }
         }
       }
-
-      if ( conns_in_thread.size() > 0 )
-      {
-#pragma omp critical( get_connections )
-        {
-          extend_connectome( connectome, conns_in_thread );
-        }
-      }
     } // of omp parallel
     return;
   } // else if
@@ -1444,13 +1880,52 @@ nest::ConnectionManager::sort_connections( const size_t tid )
     {
       if ( connections_[ tid ][ syn_id ] )
       {
-        connections_[ tid ][ syn_id ]->sort_connections( source_table_.get_thread_local_sources( tid )[ syn_id ] );
+        BlockVector< Source >& sources = source_table_.get_thread_local_sources( tid )[ syn_id ];
+        if ( incremental_update_ )
+        {
+          connections_[ tid ][ syn_id ]->sort_new_connections( sources );
+        }
+        else
+        {
+          connections_[ tid ][ syn_id ]->sort_connections( sources );
+        }
       }
     }
     remove_disabled_connections( tid );
   }
 }
 
+void
+nest::ConnectionManager::check_incremental_update()
+{
+  incremental_update_ =
+    not kernel().mpi_manager.any_true( full_update_required_ or secondary_connections_exist_ );
+}
+
+void
+nest::ConnectionManager::restructure_connection_tables( const size_t tid )
+{
+  assert( not source_table_.is_cleared() );
+
+  if ( incremental_update_ )
+  {
+    // Compressed spike data refer to connections by their position, which changes when new connections are
+    // sorted in. Sources already known on the presynaptic side must keep their index.
+    if ( use_compressed_spikes_ )
+    {
+#pragma omp single
+      {
+        source_table_.collect_known_source_indices( compressed_spike_data_ );
+      } // of omp single; implicit barrier
+    }
+  }
+  else
+  {
+    target_table_.clear( tid );
+    source_table_.reset_processed_flags( tid );
+  }
+}
+
 void
 nest::ConnectionManager::compute_target_data_buffer_size()
 {
@@ -1458,9 +1933,20 @@ nest::ConnectionManager::compute_target_data_buffer_size()
   // has its own data structures, we need to count connections on every
   // thread separately to compute the total number of sources.
   size_t num_target_data = 0;
-  for ( size_t tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+  if ( incremental_update_ and use_compressed_spikes_ )
+  {
+    // Only sources new to the presynaptic side are communicated.
+    for ( const auto& source_index_map : source_table_.compressed_spike_data_map_ )
+    {
+      num_target_data += source_index_map.size();
+    }
+  }
+  else
   {
-    num_target_data += get_num_target_data( tid );
+    for ( size_t tid = 0; tid < kernel().vp_manager.get_num_threads(); ++tid )
+    {
+      num_target_data += get_num_target_data( tid );
+    }
   }
 
   // Determine maximum number of target data across all ranks, because
@@ -1763,6 +2249,7 @@ void
 nest::ConnectionManager::unset_connections_have_changed()
 {
   connections_have_changed_ = false;
+  full_update_required_ = false;
 }
 
 
@@ -1882,21 +2369,6 @@ nest::ConnectionManager::fill_target_buffer( const size_t tid,
   iteration_state_.at( tid ) =
     std::pair< size_t, std::map< size_t, CSDMapEntry >::const_iterator >( syn_id, source_2_idx );
 
-  // Mark end of data for this round
-  for ( size_t rank = rank_start; rank < rank_end; ++rank )
-  {
-    if ( send_buffer_position.idx( rank ) > send_buffer_position.begin( rank ) )
-    {
-      // We have written data for the rank, mark last written entry with END marker
-      send_buffer_target_data.at( send_buffer_position.idx( rank ) - 1 ).set_end_marker();
-    }
-    else
-    {
-      // We have not written anything, mark beginning of chunk with INVALID marker
-      send_buffer_target_data.at( send_buffer_position.begin( rank ) ).set_invalid_marker();
-    }
-  }
-
   // If we get here, this thread has written everything.
   return true;
 }
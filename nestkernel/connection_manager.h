@@ -24,6 +24,8 @@
 #define CONNECTION_MANAGER_H
 
 // C++ includes:
+#include <istream>
+#include <ostream>
 #include <string>
 
 // Includes from libnestutil:
@@ -196,6 +198,20 @@ public:
 
   size_t find_connection( const size_t tid, const synindex syn_id, const size_t snode_id, const size_t tnode_id );
 
+  /**
+   * Write all connections of thread tid to a network snapshot.
+   *
+   * @see NetworkSnapshot
+   */
+  void write_snapshot( const size_t tid, std::ostream& os );
+
+  /**
+   * Create the connections of thread tid stored in a network snapshot.
+   *
+   * @param syn_ids Maps the synapse model IDs of the snapshot to those of the kernel
+   */
+  void read_snapshot( const size_t tid, std::istream& is, const std::vector< synindex >& syn_ids );
+
   void disconnect( const size_t tid, const synindex syn_id, const size_t snode_id, const size_t tnode_id );
 
   /**
@@ -222,6 +238,25 @@ public:
     const size_t lcid,
     const DictionaryDatum& dict );
 
+  /**
+   * Write the value of parameter name of each connection in conns to values.
+   *
+   * Connections between neurons are read once per thread and synapse type.
+   * The parameter must be of type double.
+   */
+  void get_connection_values( const std::vector< ConnectionID >& conns, const Name& name, double* values ) const;
+
+  /**
+   * Set parameters of the connections in conns.
+   *
+   * The value of parameter names[ k ] for connection conns[ i ] is
+   * values[ k * conns.size() + i ]. Connections between neurons are updated
+   * in parallel, once per thread and synapse type.
+   */
+  void set_connection_values( const std::vector< ConnectionID >& conns,
+    const std::vector< Name >& names,
+    const double* values );
+
   /**
    * Return connections between pairs of neurons.
    *
@@ -239,7 +274,20 @@ public:
    */
   ArrayDatum get_connections( const DictionaryDatum& params );
 
-  void get_connections( std::deque< ConnectionID >& connectome,
+  /**
+   * Return the connections selected by params as columns.
+   *
+   * The dictionary contains an IntVectorDatum for each of source, target,
+   * target_thread, synapse_id and port, with entries in the same order as
+   * returned by get_connections(). No ConnectionDatum is created.
+   */
+  DictionaryDatum get_connection_columns( const DictionaryDatum& params );
+
+  /**
+   * Collect the connections of type syn_id, where thread tid appends its
+   * connections to connectome[ tid ].
+   */
+  void get_connections( std::vector< std::vector< ConnectionID > >& connectome,
     NodeCollectionPTR source,
     NodeCollectionPTR target,
     synindex syn_id,
@@ -284,6 +332,21 @@ public:
    */
   long get_min_delay() const;
 
+  /**
+   * Return smallest delay permitted for connections created after simulation has started.
+   *
+   * This equals get_min_delay() unless spike communication is overlapped with the update, in which case
+   * each slice covers at most half the smallest delay.
+   */
+  long get_min_permitted_delay() const;
+
+  /**
+   * Return true if spike communication is overlapped with the update of the next slice.
+   *
+   * This is decided by update_delay_extrema_().
+   */
+  bool spike_communication_overlapped() const;
+
   /**
    * Return maximal connection delay, which is precomputed by
    * update_delay_extrema_().
@@ -368,6 +431,11 @@ public:
 
   void add_target( const size_t tid, const size_t target_rank, const TargetData& target_data );
 
+  /**
+   * Marks all ranks to which local neurons send spikes; is_target_rank must have one entry per rank.
+   */
+  void get_target_ranks( std::vector< bool >& is_target_rank ) const;
+
   /**
    * Returns whether spikes should be compressed.
    *
@@ -404,6 +472,17 @@ public:
    */
   void unset_connections_have_changed();
 
+  /**
+   * Determines on all MPI processes whether the connection
+   * infrastructure can be updated incrementally.
+   *
+   * An incremental update retains the TargetTable and communicates only
+   * connections created since the last update. This is not possible if
+   * connections have been removed, spike compression has been switched,
+   * or secondary connections exist on any process.
+   */
+  void check_incremental_update();
+
   /**
    * Deletes TargetTable and resets processed flags of
    * SourceTable.
@@ -412,6 +491,10 @@ public:
    * created after connections have been communicated previously. It
    * basically restores the connection infrastructure to a state where
    * all information only exists on the postsynaptic side.
+   *
+   * During incremental updates, the TargetTable is retained and only
+   * the indices of sources already known on the presynaptic side are
+   * recorded.
    */
   void restructure_connection_tables( const size_t tid );
 
@@ -469,9 +552,43 @@ private:
     const size_t tnode_id,
     std::vector< size_t >& sources );
 
+  /**
+   * Sort the indices of n connections given by sources and targets by the
+   * thread of the target, using a parallel counting sort.
+   *
+   * Indices of connections to targets on thread tid are stored in order
+   * from bucket_begin[ tid ] to bucket_begin[ tid + 1 ], those of
+   * connections to nodes without proxies, which exist on all threads, from
+   * bucket_begin[ num_threads ] to bucket_begin[ num_threads + 1 ]. Indices
+   * are ascending within each range. Connections to targets on other
+   * processes are left out.
+   *
+   * @throws UnknownNode if a source or target does not exist.
+   */
+  void sort_connections_by_target_thread_( const long* sources,
+    const long* targets,
+    const size_t n,
+    std::vector< size_t >& order,
+    std::vector< size_t >& bucket_begin );
+
+  /**
+   * Sort the positions in conns of connections stored in connections_ by
+   * thread and synapse type into positions[ tid ][ syn_id ]. Positions of
+   * connections from or to devices are added to device_positions.
+   */
+  void group_connections_( const std::vector< ConnectionID >& conns,
+    std::vector< std::vector< std::vector< size_t > > >& positions,
+    std::vector< size_t >& device_positions ) const;
+
+  /**
+   * Collect the connections selected by params in segments, one per synapse
+   * type and thread.
+   */
+  void collect_connections_( const DictionaryDatum& params, std::vector< std::vector< ConnectionID > >& connectome );
+
   /**
    * Splits a TokenArray of node IDs to two vectors containing node IDs of neurons and
-   * node IDs of devices.
+   * node IDs of devices. Node IDs of neurons are sorted.
    */
   void split_to_neuron_device_vectors_( const size_t tid,
     NodeCollectionPTR nodecollection,
@@ -640,7 +757,12 @@ private:
   //! ConnBuilder factories, indexed by connruledict_ elements.
   std::vector< GenericConnBuilderFactory* > connbuilder_factories_;
 
-  long min_delay_; //!< Value of the smallest delay in the network.
+  long min_delay_; //!< Value of the smallest delay in the network, halved if spike communication is overlapped.
+
+  long min_connection_delay_; //!< Value of the smallest delay in the network in steps.
+
+  //! Whether spike communication is overlapped with the update of the next slice.
+  bool spike_communication_overlapped_;
 
   long max_delay_; //!< Value of the largest delay in the network in steps.
 
@@ -654,6 +776,14 @@ private:
   //! true if GetConnections has been called.
   bool get_connections_has_been_called_;
 
+  //! True if the connection infrastructure cannot be updated incrementally,
+  //! because it has not been built yet or connections have been removed
+  //! since the last update.
+  bool full_update_required_;
+
+  //! True during incremental updates of the connection infrastructure.
+  bool incremental_update_;
+
   /**
    *  Whether to use spike compression; if a neuron has targets on
    *  multiple threads of a process, this switch makes sure that only
@@ -697,6 +827,18 @@ ConnectionManager::get_min_delay() const
   return min_delay_;
 }
 
+inline long
+ConnectionManager::get_min_permitted_delay() const
+{
+  return spike_communication_overlapped_ ? 2 * min_delay_ : min_delay_;
+}
+
+inline bool
+ConnectionManager::spike_communication_overlapped() const
+{
+  return spike_communication_overlapped_;
+}
+
 inline long
 ConnectionManager::get_max_delay() const
 {
@@ -799,6 +941,12 @@ ConnectionManager::add_target( const size_t tid, const size_t target_rank, const
   target_table_.add_target( tid, target_rank, target_data );
 }
 
+inline void
+ConnectionManager::get_target_ranks( std::vector< bool >& is_target_rank ) const
+{
+  target_table_.get_target_ranks( is_target_rank );
+}
+
 inline bool
 ConnectionManager::get_next_target_data( const size_t tid,
   const size_t rank_start,
@@ -883,14 +1031,6 @@ ConnectionManager::send( const size_t tid,
   connections_[ tid ][ syn_id ]->send( tid, lcid, cm, e );
 }
 
-inline void
-ConnectionManager::restructure_connection_tables( const size_t tid )
-{
-  assert( not source_table_.is_cleared() );
-  target_table_.clear( tid );
-  source_table_.reset_processed_flags( tid );
-}
-
 inline void
 ConnectionManager::set_source_has_more_targets( const size_t tid,
   const synindex syn_id,
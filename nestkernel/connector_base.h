@@ -27,7 +27,10 @@
 #include "config.h"
 
 // C++ includes:
+#include <algorithm>
 #include <cstdlib>
+#include <ostream>
+#include <type_traits>
 #include <vector>
 
 // Includes from libnestutil:
@@ -42,6 +45,7 @@
 #include "event.h"
 #include "nest_datums.h"
 #include "nest_names.h"
+#include "network_snapshot.h"
 #include "node.h"
 #include "source.h"
 #include "spikecounter.h"
@@ -49,10 +53,26 @@
 // Includes from sli:
 #include "arraydatum.h"
 #include "dictutils.h"
+#include "doubledatum.h"
 
 namespace nest
 {
 
+/**
+ * True if connections of type ConnectionT provide get_weight(), so that their weights and delays can be read
+ * without get_status().
+ */
+template < typename ConnectionT, typename = void >
+struct has_get_weight : std::false_type
+{
+};
+
+template < typename ConnectionT >
+struct has_get_weight< ConnectionT, std::void_t< decltype( std::declval< const ConnectionT& >().get_weight() ) > >
+  : std::true_type
+{
+};
+
 /**
  * Base class to allow storing Connectors for different synapse types
  * in vectors. We define the interface here to avoid casting.
@@ -93,6 +113,27 @@ public:
    */
   virtual void set_synapse_status( const size_t lcid, const DictionaryDatum& dict, ConnectorModel& cm ) = 0;
 
+  /**
+   * Write the value of parameter name of the connections at positions
+   * lcids to values. The parameter must be of type double.
+   */
+  virtual void
+  get_synapse_values( const Name& name, const std::vector< size_t >& lcids, std::vector< double >& values ) const = 0;
+
+  /**
+   * Set the parameters of the connections at positions lcids.
+   *
+   * Before the connection at position lcids[ i ] is updated from dict, the
+   * DoubleDatum entries[ k ] contained in dict is set to
+   * values[ k * lcids.size() + i ]. Changing the existing datums instead of
+   * creating new ones allows several threads to set values concurrently.
+   */
+  virtual void set_synapse_values( const std::vector< size_t >& lcids,
+    const std::vector< DoubleDatum* >& entries,
+    const std::vector< double >& values,
+    const DictionaryDatum& dict,
+    ConnectorModel& cm ) = 0;
+
   /**
    * Add ConnectionID with given source_node_id and lcid to conns. If
    * target_node_id is given, only add connection if target_node_id matches
@@ -103,19 +144,19 @@ public:
     const size_t tid,
     const size_t lcid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const = 0;
+    std::vector< ConnectionID >& conns ) const = 0;
 
   /**
-   * Add ConnectionID with given source_node_id and lcid to conns. If
-   * target_neuron_node_ids is given, only add connection if
-   * target_neuron_node_ids contains the node ID of the target of the connection.
+   * Add ConnectionID with given source_node_id and lcid to conns, if the
+   * sorted vector target_neuron_node_ids contains the node ID of the target of
+   * the connection.
    */
   virtual void get_connection_with_specified_targets( const size_t source_node_id,
     const std::vector< size_t >& target_neuron_node_ids,
     const size_t tid,
     const size_t lcid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const = 0;
+    std::vector< ConnectionID >& conns ) const = 0;
 
   /**
    * Add ConnectionIDs with given source_node_id to conns, looping over
@@ -126,7 +167,7 @@ public:
     const size_t target_node_id,
     const size_t tid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const = 0;
+    std::vector< ConnectionID >& conns ) const = 0;
 
   /**
    * For a given target_node_id add lcids of all connections with matching
@@ -178,6 +219,12 @@ public:
    */
   virtual void sort_connections( BlockVector< Source >& ) = 0;
 
+  /**
+   * Sort connections according to source node IDs, assuming that
+   * only connections created after the last sort are out of order.
+   */
+  virtual void sort_new_connections( BlockVector< Source >& ) = 0;
+
   /**
    * Set a flag in the connection indicating whether the following
    * connection belongs to the same source.
@@ -211,6 +258,17 @@ public:
    * Remove disabled connections from the connector.
    */
   virtual void remove_disabled_connections( const size_t first_disabled_index ) = 0;
+
+  /**
+   * Write all enabled connections to a network snapshot.
+   *
+   * For each connection, the node IDs of source and target are written,
+   * followed by the binary representation of the connection.
+   *
+   * @param sources Sources of the connections, as stored in the SourceTable
+   * @return the number of connections written
+   */
+  virtual size_t write_snapshot( const size_t tid, const BlockVector< Source >& sources, std::ostream& os ) const = 0;
 };
 
 /**
@@ -266,6 +324,66 @@ public:
     C_[ lcid ].set_status( dict, static_cast< GenericConnectorModel< ConnectionT >& >( cm ) );
   }
 
+  void
+  get_synapse_values( const Name& name, const std::vector< size_t >& lcids, std::vector< double >& values ) const override
+  {
+    values.reserve( values.size() + lcids.size() );
+
+    // Connections providing get_weight() report weight and delay as stored, so both are read directly. Other
+    // connections may report a delay different from get_delay(), e.g., cont_delay_synapse.
+    if constexpr ( has_get_weight< ConnectionT >::value )
+    {
+      if ( name == names::weight or name == names::delay )
+      {
+        const bool weight = name == names::weight;
+        for ( const size_t lcid : lcids )
+        {
+          assert( lcid < C_.size() );
+          values.push_back( weight ? C_[ lcid ].get_weight() : C_[ lcid ].get_delay() );
+        }
+        return;
+      }
+    }
+
+    // Connections of one type always write the same entries, so the dictionary can be reused
+    DictionaryDatum dict( new Dictionary );
+    for ( const size_t lcid : lcids )
+    {
+      assert( lcid < C_.size() );
+
+      C_[ lcid ].get_status( dict );
+      const DoubleDatum* value = dynamic_cast< const DoubleDatum* >( dict->lookup2( name ).datum() );
+      if ( not value )
+      {
+        throw TypeMismatch(
+          DoubleDatum().gettypename().toString(), dict->lookup2( name )->gettypename().toString() );
+      }
+      values.push_back( value->get() );
+    }
+  }
+
+  void
+  set_synapse_values( const std::vector< size_t >& lcids,
+    const std::vector< DoubleDatum* >& entries,
+    const std::vector< double >& values,
+    const DictionaryDatum& dict,
+    ConnectorModel& cm ) override
+  {
+    assert( values.size() == entries.size() * lcids.size() );
+
+    auto& model = static_cast< GenericConnectorModel< ConnectionT >& >( cm );
+    for ( size_t i = 0; i < lcids.size(); ++i )
+    {
+      assert( lcids[ i ] < C_.size() );
+
+      for ( size_t k = 0; k < entries.size(); ++k )
+      {
+        ( *entries[ k ] ) = values[ k * lcids.size() + i ];
+      }
+      C_[ lcids[ i ] ].set_status( dict, model );
+    }
+  }
+
   void
   push_back( const ConnectionT& c )
   {
@@ -284,7 +402,7 @@ public:
     const size_t tid,
     const size_t lcid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const override
+    std::vector< ConnectionID >& conns ) const override
   {
     if ( not C_[ lcid ].is_disabled() )
     {
@@ -293,8 +411,7 @@ public:
         const size_t current_target_node_id = C_[ lcid ].get_target( tid )->get_node_id();
         if ( current_target_node_id == target_node_id or target_node_id == 0 )
         {
-          conns.push_back(
-            ConnectionDatum( ConnectionID( source_node_id, current_target_node_id, tid, syn_id_, lcid ) ) );
+          conns.push_back( ConnectionID( source_node_id, current_target_node_id, tid, syn_id_, lcid ) );
         }
       }
     }
@@ -306,18 +423,17 @@ public:
     const size_t tid,
     const size_t lcid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const override
+    std::vector< ConnectionID >& conns ) const override
   {
     if ( not C_[ lcid ].is_disabled() )
     {
       if ( synapse_label == UNLABELED_CONNECTION or C_[ lcid ].get_label() == synapse_label )
       {
         const size_t current_target_node_id = C_[ lcid ].get_target( tid )->get_node_id();
-        if ( std::find( target_neuron_node_ids.begin(), target_neuron_node_ids.end(), current_target_node_id )
-          != target_neuron_node_ids.end() )
+        if ( std::binary_search(
+               target_neuron_node_ids.begin(), target_neuron_node_ids.end(), current_target_node_id ) )
         {
-          conns.push_back(
-            ConnectionDatum( ConnectionID( source_node_id, current_target_node_id, tid, syn_id_, lcid ) ) );
+          conns.push_back( ConnectionID( source_node_id, current_target_node_id, tid, syn_id_, lcid ) );
         }
       }
     }
@@ -328,7 +444,7 @@ public:
     const size_t target_node_id,
     const size_t tid,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const override
+    std::vector< ConnectionID >& conns ) const override
   {
     for ( size_t lcid = 0; lcid < C_.size(); ++lcid )
     {
@@ -436,25 +552,40 @@ public:
     const double t_trig,
     const std::vector< ConnectorModel* >& cm ) override
   {
+    // The volume transmitter is a common property of the synapse model, so either all or none of the connections
+    // in this connector are bound to it.
+    const typename ConnectionT::CommonPropertiesType& cp =
+      static_cast< GenericConnectorModel< ConnectionT >* >( cm[ syn_id_ ] )->get_common_properties();
+    if ( cp.get_vt_node_id() != vt_node_id )
+    {
+      return;
+    }
+
     for ( size_t i = 0; i < C_.size(); ++i )
     {
-      if ( static_cast< GenericConnectorModel< ConnectionT >* >( cm[ syn_id_ ] )
-             ->get_common_properties()
-             .get_vt_node_id()
-        == vt_node_id )
-      {
-        C_[ i ].trigger_update_weight( tid,
-          dopa_spikes,
-          t_trig,
-          static_cast< GenericConnectorModel< ConnectionT >* >( cm[ syn_id_ ] )->get_common_properties() );
-      }
+      C_[ i ].trigger_update_weight( tid, dopa_spikes, t_trig, cp );
     }
   }
 
   void
   sort_connections( BlockVector< Source >& sources ) override
   {
-    nest::sort( sources, C_ );
+    nest::radix_sort( sources, C_, []( const Source& s ) { return s.get_node_id(); } );
+  }
+
+  void
+  sort_new_connections( BlockVector< Source >& sources ) override
+  {
+    // Merging copies the new connections, so sort all connections if most of them are new.
+    const size_t num_sorted = nest::sorted_prefix_size( sources );
+    if ( 2 * num_sorted < sources.size() )
+    {
+      sort_connections( sources );
+    }
+    else
+    {
+      nest::sort_tail_and_merge( sources, C_, num_sorted );
+    }
   }
 
   void
@@ -512,6 +643,36 @@ public:
     assert( C_[ first_disabled_index ].is_disabled() );
     C_.erase( C_.begin() + first_disabled_index, C_.end() );
   }
+
+  size_t
+  write_snapshot( const size_t tid, const BlockVector< Source >& sources, std::ostream& os ) const override
+  {
+    if constexpr ( std::is_trivially_copyable< ConnectionT >::value )
+    {
+      size_t num_enabled = 0;
+      for ( size_t lcid = 0; lcid < C_.size(); ++lcid )
+      {
+        num_enabled += not C_[ lcid ].is_disabled();
+      }
+
+      write_binary< uint64_t >( os, sizeof( ConnectionT ) );
+      write_binary< uint64_t >( os, num_enabled );
+      for ( size_t lcid = 0; lcid < C_.size(); ++lcid )
+      {
+        if ( not C_[ lcid ].is_disabled() )
+        {
+          write_binary< uint64_t >( os, sources[ lcid ].get_node_id() );
+          write_binary< uint64_t >( os, C_[ lcid ].get_target( tid )->get_node_id() );
+          write_binary( os, C_[ lcid ] );
+        }
+      }
+      return num_enabled;
+    }
+    else
+    {
+      throw NotImplemented( "Connections of this synapse model cannot be saved." );
+    }
+  }
 };
 
 } // of namespace nest
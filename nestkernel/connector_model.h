@@ -25,7 +25,10 @@
 
 // C++ includes:
 #include <cmath>
+#include <istream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // Includes from libnestutil:
 #include "numerics.h"
@@ -58,7 +61,8 @@ enum class ConnectionModelProperties : unsigned
   REQUIRES_SYMMETRIC = 1 << 5,
   REQUIRES_CLOPATH_ARCHIVING = 1 << 6,
   REQUIRES_URBANCZIK_ARCHIVING = 1 << 7,
-  REQUIRES_EPROP_ARCHIVING = 1 << 8
+  REQUIRES_EPROP_ARCHIVING = 1 << 8,
+  SUPPORTS_MULTIPLICITY = 1 << 9
 };
 
 template <>
@@ -101,6 +105,32 @@ public:
     const double delay = NAN,
     const double weight = NAN ) = 0;
 
+  /**
+   * Returns true if connections of this model can be stored in network snapshots.
+   *
+   * Snapshots contain the binary representation of connections, which requires
+   * the connection type to be trivially copyable.
+   */
+  virtual bool supports_snapshots() const = 0;
+
+  /**
+   * Returns the size of a single connection of this model in bytes.
+   */
+  virtual size_t get_connection_size() const = 0;
+
+  /**
+   * Create connections stored in a network snapshot.
+   *
+   * Reads connections written by ConnectorBase::write_snapshot() and connects
+   * them on thread tid. The node IDs of their sources are appended to
+   * source_node_ids in the order in which the connections are created.
+   */
+  virtual void read_snapshot( std::istream& is,
+    const size_t tid,
+    std::vector< ConnectorBase* >& hetconn,
+    const synindex syn_id,
+    std::vector< size_t >& source_node_ids ) = 0;
+
   virtual ConnectorModel* clone( std::string, synindex syn_id ) const = 0;
 
   virtual void calibrate( const TimeConverter& tc ) = 0;
@@ -181,6 +211,24 @@ public:
     const double delay,
     const double weight ) override;
 
+  bool
+  supports_snapshots() const override
+  {
+    return std::is_trivially_copyable< ConnectionT >::value;
+  }
+
+  size_t
+  get_connection_size() const override
+  {
+    return sizeof( ConnectionT );
+  }
+
+  void read_snapshot( std::istream& is,
+    const size_t tid,
+    std::vector< ConnectorBase* >& hetconn,
+    const synindex syn_id,
+    std::vector< size_t >& source_node_ids ) override;
+
   ConnectorModel* clone( std::string, synindex ) const override;
 
   void calibrate( const TimeConverter& tc ) override;
@@ -35,9 +35,11 @@
 // Includes from nestkernel:
 #include "connector_base.h"
 #include "delay_checker.h"
+#include "exceptions.h"
 #include "kernel_manager.h"
 #include "nest_time.h"
 #include "nest_timeconverter.h"
+#include "network_snapshot.h"
 #include "secondary_event_impl.h"
 
 // Includes from sli:
@@ -293,6 +295,76 @@ GenericConnectorModel< ConnectionT >::add_connection( Node& src,
 }
 
 
+template < typename ConnectionT >
+void
+GenericConnectorModel< ConnectionT >::read_snapshot( std::istream& is,
+  const size_t tid,
+  std::vector< ConnectorBase* >& thread_local_connectors,
+  const synindex syn_id,
+  std::vector< size_t >& source_node_ids )
+{
+  if constexpr ( std::is_trivially_copyable< ConnectionT >::value )
+  {
+    if ( read_binary< uint64_t >( is ) != sizeof( ConnectionT ) )
+    {
+      throw KernelException( String::compose(
+        "Network snapshot contains connections of synapse model %1 with a different binary layout.", get_name() ) );
+    }
+
+    const size_t num_connections = read_binary< uint64_t >( is );
+    source_node_ids.reserve( source_node_ids.size() + num_connections );
+
+    ConnectionT connection;
+    for ( size_t i = 0; i < num_connections; ++i )
+    {
+      const size_t source_node_id = read_binary< uint64_t >( is );
+      const size_t target_node_id = read_binary< uint64_t >( is );
+      read_binary( is, connection );
+      connection.set_syn_id( syn_id );
+
+      if ( has_property( ConnectionModelProperties::HAS_DELAY ) )
+      {
+        kernel().connection_manager.get_delay_checker().assert_valid_delay_ms( connection.get_delay() );
+      }
+
+      // Checking the connection again registers it with the target and sets the target pointer. The snapshot
+      // stores the port, so the receptor types the target model may have mapped to this port are tried in
+      // turn.
+      Node& src = *kernel().node_manager.get_node_or_proxy( source_node_id, tid );
+      Node& tgt = *kernel().node_manager.get_node_or_proxy( target_node_id, tid );
+      const std::vector< size_t > receptor_types = tgt.get_receptor_types_of_port( connection.get_rport() );
+      for ( auto receptor_type = receptor_types.begin();; ++receptor_type )
+      {
+        try
+        {
+          add_connection_( src, tgt, thread_local_connectors, syn_id, connection, *receptor_type );
+          break;
+        }
+        catch ( UnknownReceptorType& )
+        {
+          if ( receptor_type + 1 == receptor_types.end() )
+          {
+            throw;
+          }
+        }
+        catch ( IncompatibleReceptorType& )
+        {
+          if ( receptor_type + 1 == receptor_types.end() )
+          {
+            throw;
+          }
+        }
+      }
+
+      source_node_ids.push_back( source_node_id );
+    }
+  }
+  else
+  {
+    throw NotImplemented( String::compose( "Connections of synapse model %1 cannot be loaded.", get_name() ) );
+  }
+}
+
 template < typename ConnectionT >
 void
 GenericConnectorModel< ConnectionT >::add_connection_( Node& src,
@@ -48,10 +48,21 @@ namespace nest
 
 EventDeliveryManager::EventDeliveryManager()
   : off_grid_spiking_( false )
+  , sort_spikes_by_thread_( false )
+  , recv_buffer_sorted_by_thread_( false )
+  , overlap_spike_communication_( false )
+  , spike_exchange_mode_( SpikeExchangeMode::ALLTOALL )
+  , spike_data_neighbors_valid_( false )
+  , spike_data_exchange_pending_( false )
+  , pending_recv_buffer_sorted_by_thread_( false )
   , moduli_()
   , slice_moduli_()
   , emitted_spikes_register_()
   , off_grid_emitted_spikes_register_()
+  , pending_emitted_spikes_register_()
+  , pending_off_grid_emitted_spikes_register_()
+  , local_spikes_register_()
+  , off_grid_local_spikes_register_()
   , send_buffer_secondary_events_()
   , recv_buffer_secondary_events_()
   , local_spike_counter_()
@@ -59,6 +70,19 @@ EventDeliveryManager::EventDeliveryManager()
   , recv_buffer_spike_data_()
   , send_buffer_off_grid_spike_data_()
   , recv_buffer_off_grid_spike_data_()
+  , pending_send_buffer_spike_data_()
+  , pending_recv_buffer_spike_data_()
+  , pending_send_buffer_off_grid_spike_data_()
+  , pending_recv_buffer_off_grid_spike_data_()
+  , spike_write_positions_()
+  , spike_write_positions_per_thread_()
+  , num_spikes_per_rank_()
+  , max_spikes_per_assigned_rank_()
+  , spike_thread_offsets_()
+  , pending_spike_thread_offsets_()
+  , send_counts_spike_data_()
+  , recv_counts_spike_data_()
+  , recv_displacements_spike_data_()
   , send_buffer_target_data_()
   , recv_buffer_target_data_()
   , buffer_size_target_data_has_changed_( false )
@@ -86,6 +110,13 @@ EventDeliveryManager::initialize( const bool adjust_number_of_threads_or_rng_onl
 
     // Ensures that ResetKernel resets off_grid_spiking_
     off_grid_spiking_ = false;
+    sort_spikes_by_thread_ = false;
+    recv_buffer_sorted_by_thread_ = false;
+    overlap_spike_communication_ = false;
+    spike_exchange_mode_ = SpikeExchangeMode::ALLTOALL;
+    spike_data_neighbors_valid_ = false;
+    spike_data_exchange_pending_ = false;
+    pending_recv_buffer_sorted_by_thread_ = false;
     buffer_size_target_data_has_changed_ = false;
     send_recv_buffer_shrink_limit_ = 0.2;
     send_recv_buffer_shrink_spare_ = 0.1;
@@ -99,6 +130,17 @@ EventDeliveryManager::initialize( const bool adjust_number_of_threads_or_rng_onl
   reset_counters();
   emitted_spikes_register_.resize( num_threads );
   off_grid_emitted_spikes_register_.resize( num_threads );
+  pending_emitted_spikes_register_.resize( num_threads );
+  pending_off_grid_emitted_spikes_register_.resize( num_threads );
+  spike_write_positions_per_thread_.resize( num_threads );
+  max_spikes_per_assigned_rank_.resize( num_threads, 0 );
+  local_spikes_register_.resize( 2 );
+  off_grid_local_spikes_register_.resize( 2 );
+  for ( size_t toggle = 0; toggle < 2; ++toggle )
+  {
+    local_spikes_register_[ toggle ].resize( num_threads );
+    off_grid_local_spikes_register_[ toggle ].resize( num_threads );
+  }
   gather_completed_checker_.initialize( num_threads, false );
 
 #pragma omp parallel
@@ -114,6 +156,30 @@ EventDeliveryManager::initialize( const bool adjust_number_of_threads_or_rng_onl
     {
       off_grid_emitted_spikes_register_[ tid ] = new std::vector< OffGridSpikeDataWithRank >();
     }
+
+    if ( not pending_emitted_spikes_register_[ tid ] )
+    {
+      pending_emitted_spikes_register_[ tid ] = new std::vector< SpikeDataWithRank >();
+    }
+
+    if ( not pending_off_grid_emitted_spikes_register_[ tid ] )
+    {
+      pending_off_grid_emitted_spikes_register_[ tid ] = new std::vector< OffGridSpikeDataWithRank >();
+    }
+
+    for ( size_t toggle = 0; toggle < 2; ++toggle )
+    {
+      if ( not local_spikes_register_[ toggle ][ tid ] )
+      {
+        local_spikes_register_[ toggle ][ tid ] = new std::vector< std::vector< SpikeData > >( num_threads );
+      }
+
+      if ( not off_grid_local_spikes_register_[ toggle ][ tid ] )
+      {
+        off_grid_local_spikes_register_[ toggle ][ tid ] =
+          new std::vector< std::vector< OffGridSpikeData > >( num_threads );
+      }
+    }
   } // of omp parallel
 }
 
@@ -133,18 +199,111 @@ EventDeliveryManager::finalize( const bool )
   }
   off_grid_emitted_spikes_register_.clear();
 
+  for ( auto& vec_spikedata_ptr : pending_emitted_spikes_register_ )
+  {
+    delete vec_spikedata_ptr;
+  }
+  pending_emitted_spikes_register_.clear();
+
+  for ( auto& vec_spikedata_ptr : pending_off_grid_emitted_spikes_register_ )
+  {
+    delete vec_spikedata_ptr;
+  }
+  pending_off_grid_emitted_spikes_register_.clear();
+
+  for ( auto& local_spikes_register_for_toggle : local_spikes_register_ )
+  {
+    for ( auto& vec_spikedata_ptr : local_spikes_register_for_toggle )
+    {
+      delete vec_spikedata_ptr;
+    }
+  }
+  local_spikes_register_.clear();
+
+  for ( auto& local_spikes_register_for_toggle : off_grid_local_spikes_register_ )
+  {
+    for ( auto& vec_spikedata_ptr : local_spikes_register_for_toggle )
+    {
+      delete vec_spikedata_ptr;
+    }
+  }
+  off_grid_local_spikes_register_.clear();
+
   send_buffer_secondary_events_.clear();
   recv_buffer_secondary_events_.clear();
   send_buffer_spike_data_.clear();
   recv_buffer_spike_data_.clear();
   send_buffer_off_grid_spike_data_.clear();
   recv_buffer_off_grid_spike_data_.clear();
+  pending_send_buffer_spike_data_.clear();
+  pending_recv_buffer_spike_data_.clear();
+  pending_send_buffer_off_grid_spike_data_.clear();
+  pending_recv_buffer_off_grid_spike_data_.clear();
+  spike_write_positions_.clear();
+  spike_write_positions_per_thread_.clear();
+  num_spikes_per_rank_.clear();
+  max_spikes_per_assigned_rank_.clear();
+  spike_thread_offsets_.clear();
+  pending_spike_thread_offsets_.clear();
+  send_counts_spike_data_.clear();
+  recv_counts_spike_data_.clear();
+  recv_displacements_spike_data_.clear();
 }
 
 void
 EventDeliveryManager::set_status( const DictionaryDatum& dict )
 {
   updateValue< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+  updateValue< bool >( dict, names::sort_spikes_by_thread, sort_spikes_by_thread_ );
+
+  bool overlap = overlap_spike_communication_;
+  if ( updateValue< bool >( dict, names::overlap_spike_communication, overlap ) )
+  {
+    if ( overlap != overlap_spike_communication_ and kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property overlap_spike_communication cannot be changed after Simulate has been called." );
+    }
+  }
+
+  SpikeExchangeMode mode = spike_exchange_mode_;
+  std::string mode_name;
+  if ( updateValue< std::string >( dict, names::spike_exchange_mode, mode_name ) )
+  {
+    if ( mode_name == "alltoall" )
+    {
+      mode = SpikeExchangeMode::ALLTOALL;
+    }
+    else if ( mode_name == "alltoallv" )
+    {
+      mode = SpikeExchangeMode::ALLTOALLV;
+    }
+    else if ( mode_name == "neighbor_alltoallv" )
+    {
+      mode = SpikeExchangeMode::NEIGHBOR_ALLTOALLV;
+    }
+    else
+    {
+      throw BadProperty(
+        "spike_exchange_mode must be one of 'alltoall', 'alltoallv' and 'neighbor_alltoallv', got '" + mode_name + "'." );
+    }
+
+    if ( mode != spike_exchange_mode_ and kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property spike_exchange_mode cannot be changed after Simulate has been called." );
+    }
+  }
+
+  if ( overlap and mode != SpikeExchangeMode::ALLTOALL )
+  {
+    throw BadProperty( "overlap_spike_communication requires spike_exchange_mode 'alltoall'." );
+  }
+
+  overlap_spike_communication_ = overlap;
+  if ( mode != spike_exchange_mode_ )
+  {
+    spike_exchange_mode_ = mode;
+    spike_data_neighbors_valid_ = false;
+  }
 
   double bsl = send_recv_buffer_shrink_limit_;
   if ( updateValue< double >( dict, names::spike_buffer_shrink_limit, bsl ) )
@@ -181,6 +340,20 @@ void
 EventDeliveryManager::get_status( DictionaryDatum& dict )
 {
   def< bool >( dict, names::off_grid_spiking, off_grid_spiking_ );
+  def< bool >( dict, names::sort_spikes_by_thread, sort_spikes_by_thread_ );
+  def< bool >( dict, names::overlap_spike_communication, overlap_spike_communication_ );
+  switch ( spike_exchange_mode_ )
+  {
+  case SpikeExchangeMode::ALLTOALL:
+    def< std::string >( dict, names::spike_exchange_mode, "alltoall" );
+    break;
+  case SpikeExchangeMode::ALLTOALLV:
+    def< std::string >( dict, names::spike_exchange_mode, "alltoallv" );
+    break;
+  case SpikeExchangeMode::NEIGHBOR_ALLTOALLV:
+    def< std::string >( dict, names::spike_exchange_mode, "neighbor_alltoallv" );
+    break;
+  }
   def< unsigned long >(
     dict, names::local_spike_counter, std::accumulate( local_spike_counter_.begin(), local_spike_counter_.end(), 0 ) );
   def< double >( dict, names::spike_buffer_shrink_limit, send_recv_buffer_shrink_limit_ );
@@ -216,6 +389,15 @@ EventDeliveryManager::resize_send_recv_buffers_spike_data_()
     send_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
     recv_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
   }
+
+  if ( kernel().connection_manager.spike_communication_overlapped()
+    and kernel().mpi_manager.get_buffer_size_spike_data() > pending_send_buffer_spike_data_.size() )
+  {
+    pending_send_buffer_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
+    pending_recv_buffer_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
+    pending_send_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
+    pending_recv_buffer_off_grid_spike_data_.resize( kernel().mpi_manager.get_buffer_size_spike_data() );
+  }
 }
 
 void
@@ -227,8 +409,34 @@ EventDeliveryManager::configure_spike_data_buffers()
 
   send_buffer_spike_data_.clear();
   send_buffer_off_grid_spike_data_.clear();
+  pending_send_buffer_spike_data_.clear();
+  pending_send_buffer_off_grid_spike_data_.clear();
 
   resize_send_recv_buffers_spike_data_();
+  num_spikes_per_rank_.resize( kernel().mpi_manager.get_num_processes(), 0 );
+
+  if ( kernel().connection_manager.spike_communication_overlapped() )
+  {
+    // Nothing has been exchanged yet when the first slice after the next is delivered.
+    clear_recv_buffer_spike_data_( recv_buffer_spike_data_ );
+    clear_recv_buffer_spike_data_( pending_recv_buffer_spike_data_ );
+    clear_recv_buffer_spike_data_( recv_buffer_off_grid_spike_data_ );
+    clear_recv_buffer_spike_data_( pending_recv_buffer_off_grid_spike_data_ );
+    recv_buffer_sorted_by_thread_ = false;
+    pending_recv_buffer_sorted_by_thread_ = false;
+    spike_data_exchange_pending_ = false;
+  }
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::clear_recv_buffer_spike_data_( std::vector< SpikeDataT >& recv_buffer ) const
+{
+  const SendBufferPosition send_buffer_position;
+  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  {
+    recv_buffer[ send_buffer_position.begin( rank ) ].set_invalid_marker();
+  }
 }
 
 void
@@ -238,6 +446,20 @@ EventDeliveryManager::configure_spike_register()
   {
     const size_t tid = kernel().vp_manager.get_thread_id();
     reset_spike_register_( tid );
+    pending_emitted_spikes_register_[ tid ]->clear();
+    pending_off_grid_emitted_spikes_register_[ tid ]->clear();
+
+    for ( size_t toggle = 0; toggle < 2; ++toggle )
+    {
+      for ( auto& spikes : *local_spikes_register_[ toggle ][ tid ] )
+      {
+        spikes.clear();
+      }
+      for ( auto& spikes : *off_grid_local_spikes_register_[ toggle ][ tid ] )
+      {
+        spikes.clear();
+      }
+    }
   }
 }
 
@@ -358,38 +580,355 @@ EventDeliveryManager::deliver_secondary_events( const size_t tid, const bool cal
 }
 
 void
-EventDeliveryManager::gather_spike_data()
+EventDeliveryManager::gather_spike_data( const size_t tid )
+{
+  if ( kernel().connection_manager.spike_communication_overlapped() )
+  {
+    if ( off_grid_spiking_ )
+    {
+      gather_spike_data_overlapped_( tid,
+        send_buffer_off_grid_spike_data_,
+        recv_buffer_off_grid_spike_data_,
+        pending_send_buffer_off_grid_spike_data_,
+        pending_recv_buffer_off_grid_spike_data_ );
+    }
+    else
+    {
+      gather_spike_data_overlapped_( tid,
+        send_buffer_spike_data_,
+        recv_buffer_spike_data_,
+        pending_send_buffer_spike_data_,
+        pending_recv_buffer_spike_data_ );
+    }
+  }
+  else if ( spike_exchange_mode_ != SpikeExchangeMode::ALLTOALL )
+  {
+#pragma omp master
+    {
+      if ( off_grid_spiking_ )
+      {
+        gather_spike_data_sparse_( send_buffer_off_grid_spike_data_, recv_buffer_off_grid_spike_data_ );
+      }
+      else
+      {
+        gather_spike_data_sparse_( send_buffer_spike_data_, recv_buffer_spike_data_ );
+      }
+    } // of omp master (no barrier)
+#pragma omp barrier
+  }
+  else
+  {
+    if ( off_grid_spiking_ )
+    {
+      gather_spike_data_( tid, send_buffer_off_grid_spike_data_, recv_buffer_off_grid_spike_data_ );
+    }
+    else
+    {
+      gather_spike_data_( tid, send_buffer_spike_data_, recv_buffer_spike_data_ );
+    }
+  }
+}
+
+void
+EventDeliveryManager::complete_spike_data_exchange()
 {
   if ( off_grid_spiking_ )
   {
-    gather_spike_data_( send_buffer_off_grid_spike_data_, recv_buffer_off_grid_spike_data_ );
+    complete_spike_data_exchange_( pending_send_buffer_off_grid_spike_data_, pending_recv_buffer_off_grid_spike_data_ );
   }
   else
   {
-    gather_spike_data_( send_buffer_spike_data_, recv_buffer_spike_data_ );
+    complete_spike_data_exchange_( pending_send_buffer_spike_data_, pending_recv_buffer_spike_data_ );
   }
 }
 
+bool
+EventDeliveryManager::use_thread_sorted_spikes_() const
+{
+  // Spikes carry the target thread only if spike compression is not used.
+  return sort_spikes_by_thread_ and not kernel().connection_manager.use_compressed_spikes();
+}
+
 template < typename SpikeDataT >
 void
-EventDeliveryManager::gather_spike_data_( std::vector< SpikeDataT >& send_buffer,
+EventDeliveryManager::gather_spike_data_( const size_t tid,
+  std::vector< SpikeDataT >& send_buffer,
   std::vector< SpikeDataT >& recv_buffer )
 {
   // NOTE: For meaning and logic of SpikeData flags for detecting complete transmission
   //       and information for shrink/grow, see comment in spike_data.h.
 
-  const size_t old_buff_size_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+#pragma omp master
+  {
+    const size_t old_buff_size_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+
+    if ( global_max_spikes_per_rank_ < send_recv_buffer_shrink_limit_ * old_buff_size_per_rank )
+    {
+      const size_t new_buff_size_per_rank =
+        std::max( 2UL, static_cast< size_t >( ( 1 + send_recv_buffer_shrink_spare_ ) * global_max_spikes_per_rank_ ) );
+      kernel().mpi_manager.set_buffer_size_spike_data(
+        kernel().mpi_manager.get_num_processes() * new_buff_size_per_rank );
+      resize_send_recv_buffers_spike_data_();
+      send_recv_buffer_resize_log_.add_entry( global_max_spikes_per_rank_, new_buff_size_per_rank );
+    }
+  } // of omp master (no barrier)
+#pragma omp barrier
+
+  exchange_spike_data_( tid, emitted_spikes_register_, off_grid_emitted_spikes_register_, send_buffer, recv_buffer );
+
+#pragma omp master
+  {
+    recv_buffer_sorted_by_thread_ = use_thread_sorted_spikes_();
+    if ( recv_buffer_sorted_by_thread_ )
+    {
+      set_thread_offsets_spike_data_( recv_buffer, spike_thread_offsets_ );
+    }
+  } // of omp master (no barrier)
+#pragma omp barrier
+
+  // We cannot shrink buffers here, because they first need to be read out by
+  // deliver events. Shrinking will happen at beginning of next gather.
+
+  /* emitted_spike_register is cleared by deliver_events in a thread-parallel context.
+     We could in principle clear it here, but since it can conveniently be done thread-parallel,
+     it is best to postpone.
+   */
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::gather_spike_data_sparse_( std::vector< SpikeDataT >& send_buffer,
+  std::vector< SpikeDataT >& recv_buffer )
+{
+#ifdef TIMER_DETAILED
+  sw_collocate_spike_data_.start();
+#endif
+
+  const size_t num_processes = kernel().mpi_manager.get_num_processes();
+  const bool sort_by_thread = use_thread_sorted_spikes_();
+  const size_t num_bins_per_rank = sort_by_thread ? kernel().vp_manager.get_num_threads() : 1;
+
+  spike_write_positions_.assign( num_processes * num_bins_per_rank, 0 );
+  for ( size_t tid = 0; tid < emitted_spikes_register_.size(); ++tid )
+  {
+    count_spikes_( *emitted_spikes_register_[ tid ], spike_write_positions_, sort_by_thread );
+    if ( off_grid_spiking_ )
+    {
+      count_spikes_( *off_grid_emitted_spikes_register_[ tid ], spike_write_positions_, sort_by_thread );
+    }
+  }
+
+  // Exclusive prefix sum turns counts into write positions, so that spikes for each rank are stored contiguously.
+  send_counts_spike_data_.assign( num_processes, 0 );
+  size_t write_pos = 0;
+  for ( size_t rank = 0; rank < num_processes; ++rank )
+  {
+    for ( size_t bin = rank * num_bins_per_rank; bin < ( rank + 1 ) * num_bins_per_rank; ++bin )
+    {
+      const size_t num_spikes = spike_write_positions_[ bin ];
+      spike_write_positions_[ bin ] = write_pos;
+      write_pos += num_spikes;
+      send_counts_spike_data_[ rank ] += num_spikes;
+    }
+  }
+
+  if ( send_buffer.size() < write_pos )
+  {
+    send_buffer.resize( write_pos );
+  }
+
+  // The send buffer has been resized to hold all spikes, so none need to be left out.
+  const size_t max_spikes_per_rank = std::numeric_limits< size_t >::max();
+  for ( size_t tid = 0; tid < emitted_spikes_register_.size(); ++tid )
+  {
+    collocate_spike_data_buffers_( *emitted_spikes_register_[ tid ],
+      send_buffer,
+      spike_write_positions_,
+      sort_by_thread,
+      send_counts_spike_data_,
+      max_spikes_per_rank );
+    if ( off_grid_spiking_ )
+    {
+      collocate_spike_data_buffers_( *off_grid_emitted_spikes_register_[ tid ],
+        send_buffer,
+        spike_write_positions_,
+        sort_by_thread,
+        send_counts_spike_data_,
+        max_spikes_per_rank );
+    }
+  }
+
+#ifdef TIMER_DETAILED
+  sw_collocate_spike_data_.stop();
+  sw_communicate_spike_data_.start();
+#endif
+
+  if ( spike_exchange_mode_ == SpikeExchangeMode::NEIGHBOR_ALLTOALLV )
+  {
+    if ( not spike_data_neighbors_valid_ )
+    {
+      std::vector< bool > is_target_rank( num_processes, false );
+      kernel().connection_manager.get_target_ranks( is_target_rank );
+      kernel().mpi_manager.set_spike_data_neighbors( is_target_rank );
+      spike_data_neighbors_valid_ = true;
+    }
+    kernel().mpi_manager.communicate_spike_data_Neighbor_alltoallv(
+      send_buffer, recv_buffer, send_counts_spike_data_, recv_counts_spike_data_ );
+  }
+  else
+  {
+    kernel().mpi_manager.communicate_spike_data_Alltoallv(
+      send_buffer, recv_buffer, send_counts_spike_data_, recv_counts_spike_data_ );
+  }
+
+#ifdef TIMER_DETAILED
+  sw_communicate_spike_data_.stop();
+#endif
+
+  recv_displacements_spike_data_.resize( num_processes );
+  size_t recv_displacement = 0;
+  for ( size_t rank = 0; rank < num_processes; ++rank )
+  {
+    recv_displacements_spike_data_[ rank ] = recv_displacement;
+    recv_displacement += recv_counts_spike_data_[ rank ];
+  }
+
+  recv_buffer_sorted_by_thread_ = sort_by_thread;
+  if ( recv_buffer_sorted_by_thread_ )
+  {
+    set_thread_offsets_spike_data_( recv_buffer, spike_thread_offsets_ );
+  }
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::gather_spike_data_overlapped_( const size_t tid,
+  std::vector< SpikeDataT >& send_buffer,
+  std::vector< SpikeDataT >& recv_buffer,
+  std::vector< SpikeDataT >& pending_send_buffer,
+  std::vector< SpikeDataT >& pending_recv_buffer )
+{
+#pragma omp master
+  {
+    // Spikes from the previous slice must be available for delivery at the beginning of the next slice.
+    complete_spike_data_exchange_( pending_send_buffer, pending_recv_buffer );
+
+    // The receive buffer has been delivered at the beginning of this slice and the spike register holding
+    // the spikes sent with it is no longer needed. They take the place of the completed buffers and registers,
+    // while the latter are delivered at the beginning of the next slice and cleared by deliver_events().
+    send_buffer.swap( pending_send_buffer );
+    recv_buffer.swap( pending_recv_buffer );
+    spike_thread_offsets_.swap( pending_spike_thread_offsets_ );
+    std::swap( recv_buffer_sorted_by_thread_, pending_recv_buffer_sorted_by_thread_ );
+    emitted_spikes_register_.swap( pending_emitted_spikes_register_ );
+    off_grid_emitted_spikes_register_.swap( pending_off_grid_emitted_spikes_register_ );
+  } // of omp master (no barrier)
+#pragma omp barrier
+
+#ifdef TIMER_DETAILED
+  if ( tid == 0 )
+  {
+    sw_collocate_spike_data_.start();
+  }
+#endif
+
+  collocate_spike_data_(
+    tid, pending_emitted_spikes_register_, pending_off_grid_emitted_spikes_register_, pending_send_buffer );
+
+#ifdef TIMER_DETAILED
+  if ( tid == 0 )
+  {
+    sw_collocate_spike_data_.stop();
+  }
+#endif
+
+#pragma omp master
+  {
+    pending_recv_buffer_sorted_by_thread_ = use_thread_sorted_spikes_();
+
+#ifdef TIMER_DETAILED
+    sw_communicate_spike_data_.start();
+#endif
+
+    if ( off_grid_spiking_ )
+    {
+      kernel().mpi_manager.communicate_off_grid_spike_data_Ialltoall( pending_send_buffer, pending_recv_buffer );
+    }
+    else
+    {
+      kernel().mpi_manager.communicate_spike_data_Ialltoall( pending_send_buffer, pending_recv_buffer );
+    }
+    spike_data_exchange_pending_ = true;
+
+#ifdef TIMER_DETAILED
+    sw_communicate_spike_data_.stop();
+#endif
+  } // of omp master (no barrier)
+#pragma omp barrier
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::complete_spike_data_exchange_( std::vector< SpikeDataT >& pending_send_buffer,
+  std::vector< SpikeDataT >& pending_recv_buffer )
+{
+  if ( not spike_data_exchange_pending_ )
+  {
+    return;
+  }
+
+#ifdef TIMER_DETAILED
+  sw_communicate_spike_data_.start();
+#endif
+  kernel().mpi_manager.wait_spike_data_Ialltoall();
+  spike_data_exchange_pending_ = false;
+#ifdef TIMER_DETAILED
+  sw_communicate_spike_data_.stop();
+#endif
+
+  global_max_spikes_per_rank_ = get_global_max_spikes_per_rank_( SendBufferPosition(), pending_recv_buffer );
 
-  if ( global_max_spikes_per_rank_ < send_recv_buffer_shrink_limit_ * old_buff_size_per_rank )
+  // Buffers can only be resized once no exchange is in flight. Resizing changes the layout of the buffers,
+  // so the exchange needs to be repeated in that case, now in blocking mode.
+  const size_t old_buff_size_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+  size_t new_buff_size_per_rank = old_buff_size_per_rank;
+  if ( global_max_spikes_per_rank_ > old_buff_size_per_rank )
+  {
+    new_buff_size_per_rank = static_cast< size_t >( ( 1 + send_recv_buffer_grow_extra_ ) * global_max_spikes_per_rank_ );
+  }
+  else if ( global_max_spikes_per_rank_ < send_recv_buffer_shrink_limit_ * old_buff_size_per_rank )
   {
-    const size_t new_buff_size_per_rank =
+    new_buff_size_per_rank =
       std::max( 2UL, static_cast< size_t >( ( 1 + send_recv_buffer_shrink_spare_ ) * global_max_spikes_per_rank_ ) );
+  }
+
+  if ( new_buff_size_per_rank != old_buff_size_per_rank )
+  {
     kernel().mpi_manager.set_buffer_size_spike_data(
       kernel().mpi_manager.get_num_processes() * new_buff_size_per_rank );
     resize_send_recv_buffers_spike_data_();
     send_recv_buffer_resize_log_.add_entry( global_max_spikes_per_rank_, new_buff_size_per_rank );
+
+    exchange_spike_data_( pending_emitted_spikes_register_,
+      pending_off_grid_emitted_spikes_register_,
+      pending_send_buffer,
+      pending_recv_buffer );
+    pending_recv_buffer_sorted_by_thread_ = use_thread_sorted_spikes_();
+  }
+
+  if ( pending_recv_buffer_sorted_by_thread_ )
+  {
+    set_thread_offsets_spike_data_( pending_recv_buffer, pending_spike_thread_offsets_ );
   }
+}
 
+template < typename SpikeDataT >
+void
+EventDeliveryManager::exchange_spike_data_( std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+  std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+  std::vector< SpikeDataT >& send_buffer,
+  std::vector< SpikeDataT >& recv_buffer )
+{
   /* The following do-while loop is executed
    * - once if all spikes fit into current send buffers on all ranks
    * - twice if send buffer size needs to be increased to fit in all spikes
@@ -406,25 +945,7 @@ EventDeliveryManager::gather_spike_data_( std::vector< SpikeDataT >& send_buffer
     }
 #endif
 
-    // Set marker at end of each chunk to DEFAULT
-    reset_complete_marker_spike_data_( send_buffer_position, send_buffer );
-    std::vector< size_t > num_spikes_per_rank( kernel().mpi_manager.get_num_processes(), 0 );
-
-    // Collocate spikes to send buffer
-    collocate_spike_data_buffers_( send_buffer_position, emitted_spikes_register_, send_buffer, num_spikes_per_rank );
-
-    if ( off_grid_spiking_ )
-    {
-      collocate_spike_data_buffers_(
-        send_buffer_position, off_grid_emitted_spikes_register_, send_buffer, num_spikes_per_rank );
-    }
-
-    // Largest number of spikes sent from this rank to any other rank.
-    const auto local_max_spikes_per_rank = *std::max_element( num_spikes_per_rank.begin(), num_spikes_per_rank.end() );
-
-    // At this point, all send_buffer entries with spikes to be transmitted, as well
-    // as all chunk-end entries, have marker DEFAULT.
-    set_end_marker_( send_buffer_position, send_buffer, local_max_spikes_per_rank );
+    collocate_spike_data_( send_buffer_position, emitted_spikes_register, off_grid_emitted_spikes_register, send_buffer );
 
 #ifdef TIMER_DETAILED
     {
@@ -466,93 +987,335 @@ EventDeliveryManager::gather_spike_data_( std::vector< SpikeDataT >& send_buffer
     }
 
   } while ( not all_spikes_transmitted );
-
-  // We cannot shrink buffers here, because they first need to be read out by
-  // deliver events. Shrinking will happen at beginning of next gather.
-
-  /* emitted_spike_register is cleared by deliver_events in a thread-parallel context.
-     We could in principle clear it here, but since it can conveniently be done thread-parallel,
-     it is best to postpone.
-   */
 }
 
-template < typename SpikeDataWithRankT, typename SpikeDataT >
+template < typename SpikeDataT >
 void
-EventDeliveryManager::collocate_spike_data_buffers_( SendBufferPosition& send_buffer_position,
-  std::vector< std::vector< SpikeDataWithRankT >* >& emitted_spikes_register,
+EventDeliveryManager::exchange_spike_data_( const size_t tid,
+  std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+  std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
   std::vector< SpikeDataT >& send_buffer,
-  std::vector< size_t >& num_spikes_per_rank )
+  std::vector< SpikeDataT >& recv_buffer )
 {
-  // First dimension: loop over writing thread
-  for ( auto& emitted_spikes_per_thread : emitted_spikes_register )
+  // See exchange_spike_data_() above for the logic of the loop.
+  bool all_spikes_transmitted = false;
+  do
   {
-    // Second dimension: loop over entries
-    for ( auto& emitted_spike : *emitted_spikes_per_thread )
+    // Buffer size before the master thread possibly grows buffers below
+    const size_t buff_size_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+
+#ifdef TIMER_DETAILED
+    if ( tid == 0 )
     {
-      const size_t rank = emitted_spike.rank;
+      sw_collocate_spike_data_.start();
+    }
+#endif
 
-      // We need to count here even though send_buffer_position also counts,
-      // but send_buffer_position will only count spikes actually written,
-      // we need all spikes to have information for buffer resizing.
-      ++num_spikes_per_rank[ rank ];
+    collocate_spike_data_( tid, emitted_spikes_register, off_grid_emitted_spikes_register, send_buffer );
 
-      // We do not break if condition is false, because there may be spikes that
-      // can be sent to other ranks than the one that is full.
-      if ( not send_buffer_position.is_chunk_filled( rank ) )
+#ifdef TIMER_DETAILED
+    if ( tid == 0 )
+    {
+      sw_collocate_spike_data_.stop();
+    }
+#endif
+
+#pragma omp master
+    {
+#ifdef TIMER_DETAILED
+      sw_communicate_spike_data_.start();
+#endif
+
+      if ( off_grid_spiking_ )
       {
-        send_buffer[ send_buffer_position.idx( rank ) ] = emitted_spike.spike_data;
-        send_buffer_position.increase( rank );
+        kernel().mpi_manager.communicate_off_grid_spike_data_Alltoall( send_buffer, recv_buffer );
       }
-    }
-  }
+      else
+      {
+        kernel().mpi_manager.communicate_spike_data_Alltoall( send_buffer, recv_buffer );
+      }
+
+#ifdef TIMER_DETAILED
+      sw_communicate_spike_data_.stop();
+#endif
+
+      global_max_spikes_per_rank_ = get_global_max_spikes_per_rank_( SendBufferPosition(), recv_buffer );
+
+      if ( global_max_spikes_per_rank_ > buff_size_per_rank )
+      {
+        const size_t new_buff_size_per_rank =
+          static_cast< size_t >( ( 1 + send_recv_buffer_grow_extra_ ) * global_max_spikes_per_rank_ );
+
+        kernel().mpi_manager.set_buffer_size_spike_data(
+          kernel().mpi_manager.get_num_processes() * new_buff_size_per_rank );
+        resize_send_recv_buffers_spike_data_();
+        send_recv_buffer_resize_log_.add_entry( global_max_spikes_per_rank_, new_buff_size_per_rank );
+      }
+    } // of omp master (no barrier)
+#pragma omp barrier
+
+    all_spikes_transmitted = global_max_spikes_per_rank_ <= buff_size_per_rank;
+
+  } while ( not all_spikes_transmitted );
 }
 
 template < typename SpikeDataT >
 void
-EventDeliveryManager::set_end_marker_( const SendBufferPosition& send_buffer_position,
-  std::vector< SpikeDataT >& send_buffer,
-  size_t local_max_spikes_per_rank )
+EventDeliveryManager::collocate_spike_data_( const SendBufferPosition& send_buffer_position,
+  std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+  std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+  std::vector< SpikeDataT >& send_buffer )
 {
-  // See comment in spike_data.h for logic.
-  const bool collocate_complete = local_max_spikes_per_rank
-    <= static_cast< size_t >( kernel().mpi_manager.get_send_recv_count_spike_data_per_rank() );
+  const size_t num_processes = kernel().mpi_manager.get_num_processes();
+  const size_t send_recv_count_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+  const bool sort_by_thread = use_thread_sorted_spikes_();
+  const size_t num_bins_per_rank = sort_by_thread ? kernel().vp_manager.get_num_threads() : 1;
 
-  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  // Set marker at end of each chunk to DEFAULT
+  reset_complete_marker_spike_data_( send_buffer_position, send_buffer );
+
+  // Counting sort: all spikes must be counted before we know where to write them.
+  spike_write_positions_.assign( num_processes * num_bins_per_rank, 0 );
+  for ( size_t tid = 0; tid < emitted_spikes_register.size(); ++tid )
   {
-    const size_t end_idx = send_buffer_position.end( rank ) - 1;
-    if ( not collocate_complete )
+    count_spikes_( *emitted_spikes_register[ tid ], spike_write_positions_, sort_by_thread );
+    if ( off_grid_spiking_ )
     {
-      SpikeDataT dummy;
-      dummy.set_lcid( local_max_spikes_per_rank );
-      dummy.set_invalid_marker();
-      send_buffer[ end_idx ] = dummy;
-      continue;
+      count_spikes_( *off_grid_emitted_spikes_register[ tid ], spike_write_positions_, sort_by_thread );
     }
+  }
 
-    const size_t next_write_idx = send_buffer_position.idx( rank );
-    if ( next_write_idx == send_buffer_position.begin( rank ) )
+  std::vector< size_t > num_spikes_per_rank( num_processes, 0 );
+  set_spike_write_positions_( send_buffer_position, num_bins_per_rank, num_spikes_per_rank );
+
+  for ( size_t tid = 0; tid < emitted_spikes_register.size(); ++tid )
+  {
+    collocate_spike_data_buffers_( *emitted_spikes_register[ tid ],
+      send_buffer,
+      spike_write_positions_,
+      sort_by_thread,
+      num_spikes_per_rank,
+      send_recv_count_per_rank );
+    if ( off_grid_spiking_ )
     {
-      // No spikes for this rank, mark by INVALID in begin
-      send_buffer[ send_buffer_position.begin( rank ) ].set_invalid_marker();
+      collocate_spike_data_buffers_( *off_grid_emitted_spikes_register[ tid ],
+        send_buffer,
+        spike_write_positions_,
+        sort_by_thread,
+        num_spikes_per_rank,
+        send_recv_count_per_rank );
     }
-    else
+  }
+
+  // Largest number of spikes sent from this rank to any other rank.
+  const size_t local_max_spikes_per_rank =
+    *std::max_element( num_spikes_per_rank.begin(), num_spikes_per_rank.end() );
+  // See comment in spike_data.h for logic.
+  const bool collocate_complete = local_max_spikes_per_rank <= send_recv_count_per_rank;
+
+  // At this point, all send_buffer entries with spikes to be transmitted, as well
+  // as all chunk-end entries, have marker DEFAULT.
+  for ( size_t rank = 0; rank < num_processes; ++rank )
+  {
+    const size_t begin = send_buffer_position.begin( rank );
+    set_end_marker_( begin,
+      send_buffer_position.end( rank ),
+      begin + num_spikes_per_rank[ rank ],
+      send_buffer,
+      collocate_complete,
+      local_max_spikes_per_rank );
+  }
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::collocate_spike_data_( const size_t tid,
+  std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+  std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+  std::vector< SpikeDataT >& send_buffer )
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  const size_t send_recv_count_per_rank = kernel().mpi_manager.get_send_recv_count_spike_data_per_rank();
+  const AssignedRanks assigned_ranks = kernel().vp_manager.get_assigned_ranks( tid );
+  const bool sort_by_thread = use_thread_sorted_spikes_();
+  const size_t num_bins_per_rank = sort_by_thread ? num_threads : 1;
+  const SendBufferPosition send_buffer_position;
+
+  // Count spikes emitted by this thread
+  std::vector< size_t >& write_positions = spike_write_positions_per_thread_[ tid ];
+  write_positions.assign( kernel().mpi_manager.get_num_processes() * num_bins_per_rank, 0 );
+  count_spikes_( *emitted_spikes_register[ tid ], write_positions, sort_by_thread );
+  if ( off_grid_spiking_ )
+  {
+    count_spikes_( *off_grid_emitted_spikes_register[ tid ], write_positions, sort_by_thread );
+  }
+#pragma omp barrier
+
+  // Exclusive prefix sum over bins and writing threads for the assigned ranks. Spikes to a given rank and
+  // thread are thus stored contiguously, in the order of the threads that emitted them.
+  size_t max_spikes_per_rank = 0;
+  for ( size_t rank = assigned_ranks.begin; rank < assigned_ranks.end; ++rank )
+  {
+    size_t write_pos = send_buffer_position.begin( rank );
+    for ( size_t bin = rank * num_bins_per_rank; bin < ( rank + 1 ) * num_bins_per_rank; ++bin )
     {
-      // At least one spike, set END on last position written to
-      send_buffer[ next_write_idx - 1 ].set_end_marker();
+      for ( auto& spike_write_positions : spike_write_positions_per_thread_ )
+      {
+        const size_t num_spikes = spike_write_positions[ bin ];
+        spike_write_positions[ bin ] = write_pos;
+        write_pos += num_spikes;
+      }
     }
+    num_spikes_per_rank_[ rank ] = write_pos - send_buffer_position.begin( rank );
+    max_spikes_per_rank = std::max( max_spikes_per_rank, num_spikes_per_rank_[ rank ] );
+
+    // Set marker at end of chunk to DEFAULT
+    send_buffer[ send_buffer_position.end( rank ) - 1 ].reset_marker();
+  }
+  max_spikes_per_assigned_rank_[ tid ] = max_spikes_per_rank;
+#pragma omp barrier
+
+  collocate_spike_data_buffers_( *emitted_spikes_register[ tid ],
+    send_buffer,
+    write_positions,
+    sort_by_thread,
+    num_spikes_per_rank_,
+    send_recv_count_per_rank );
+  if ( off_grid_spiking_ )
+  {
+    collocate_spike_data_buffers_( *off_grid_emitted_spikes_register[ tid ],
+      send_buffer,
+      write_positions,
+      sort_by_thread,
+      num_spikes_per_rank_,
+      send_recv_count_per_rank );
+  }
+
+  // Largest number of spikes sent from this rank to any other rank.
+  const size_t local_max_spikes_per_rank =
+    *std::max_element( max_spikes_per_assigned_rank_.begin(), max_spikes_per_assigned_rank_.end() );
+  const bool collocate_complete = local_max_spikes_per_rank <= send_recv_count_per_rank;
+#pragma omp barrier
+
+  for ( size_t rank = assigned_ranks.begin; rank < assigned_ranks.end; ++rank )
+  {
+    const size_t begin = send_buffer_position.begin( rank );
+    set_end_marker_( begin,
+      send_buffer_position.end( rank ),
+      begin + num_spikes_per_rank_[ rank ],
+      send_buffer,
+      collocate_complete,
+      local_max_spikes_per_rank );
+  }
+#pragma omp barrier
+}
 
-    if ( next_write_idx < end_idx + 1 )
+template < typename SpikeDataWithRankT >
+size_t
+EventDeliveryManager::get_spike_bin_( const SpikeDataWithRankT& emitted_spike,
+  const bool sort_by_thread,
+  const size_t num_threads ) const
+{
+  return sort_by_thread ? emitted_spike.rank * num_threads + emitted_spike.spike_data.get_tid() : emitted_spike.rank;
+}
+
+template < typename SpikeDataWithRankT >
+void
+EventDeliveryManager::count_spikes_( const std::vector< SpikeDataWithRankT >& emitted_spikes,
+  std::vector< size_t >& spike_counts,
+  const bool sort_by_thread ) const
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+  for ( const auto& emitted_spike : emitted_spikes )
+  {
+    ++spike_counts[ get_spike_bin_( emitted_spike, sort_by_thread, num_threads ) ];
+  }
+}
+
+template < typename SpikeDataWithRankT, typename SpikeDataT >
+void
+EventDeliveryManager::collocate_spike_data_buffers_( const std::vector< SpikeDataWithRankT >& emitted_spikes,
+  std::vector< SpikeDataT >& send_buffer,
+  std::vector< size_t >& write_positions,
+  const bool sort_by_thread,
+  const std::vector< size_t >& num_spikes_per_rank,
+  const size_t max_spikes_per_rank ) const
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+  for ( const auto& emitted_spike : emitted_spikes )
+  {
+    // If the chunk cannot hold all spikes, nothing written to it will be used. We do not break, because
+    // there may be spikes to other ranks whose chunks are not full.
+    if ( num_spikes_per_rank[ emitted_spike.rank ] <= max_spikes_per_rank )
     {
-      // at least one spike written, but none to end_idx, thus we need complete marker
-      // and size information
-      SpikeDataT dummy;
-      dummy.set_lcid( local_max_spikes_per_rank );
-      dummy.set_complete_marker();
-      send_buffer[ end_idx ] = dummy;
+      send_buffer[ write_positions[ get_spike_bin_( emitted_spike, sort_by_thread, num_threads ) ]++ ] =
+        emitted_spike.spike_data;
     }
   }
 }
 
+void
+EventDeliveryManager::set_spike_write_positions_( const SendBufferPosition& send_buffer_position,
+  const size_t num_bins_per_rank,
+  std::vector< size_t >& num_spikes_per_rank )
+{
+  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  {
+    // exclusive prefix sum over bins, i.e., target threads if spikes are sorted by thread
+    size_t write_pos = send_buffer_position.begin( rank );
+    for ( size_t bin = rank * num_bins_per_rank; bin < ( rank + 1 ) * num_bins_per_rank; ++bin )
+    {
+      const size_t num_spikes = spike_write_positions_[ bin ];
+      spike_write_positions_[ bin ] = write_pos;
+      write_pos += num_spikes;
+    }
+    num_spikes_per_rank[ rank ] += write_pos - send_buffer_position.begin( rank );
+  }
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::set_end_marker_( const size_t begin,
+  const size_t end,
+  const size_t next_write_idx,
+  std::vector< SpikeDataT >& send_buffer,
+  const bool collocate_complete,
+  const size_t local_max_spikes_per_rank ) const
+{
+  const size_t end_idx = end - 1;
+  if ( not collocate_complete )
+  {
+    SpikeDataT dummy;
+    dummy.set_lcid( local_max_spikes_per_rank );
+    dummy.set_invalid_marker();
+    send_buffer[ end_idx ] = dummy;
+    return;
+  }
+
+  if ( next_write_idx == begin )
+  {
+    // No spikes for this rank, mark by INVALID in begin
+    send_buffer[ begin ].set_invalid_marker();
+  }
+  else
+  {
+    // At least one spike, set END on last position written to
+    send_buffer[ next_write_idx - 1 ].set_end_marker();
+  }
+
+  if ( next_write_idx < end_idx + 1 )
+  {
+    // at least one spike written, but none to end_idx, thus we need complete marker
+    // and size information
+    SpikeDataT dummy;
+    dummy.set_lcid( local_max_spikes_per_rank );
+    dummy.set_complete_marker();
+    send_buffer[ end_idx ] = dummy;
+  }
+}
+
 template < typename SpikeDataT >
 void
 EventDeliveryManager::reset_complete_marker_spike_data_( const SendBufferPosition& send_buffer_position,
@@ -591,6 +1354,60 @@ EventDeliveryManager::get_global_max_spikes_per_rank_( const SendBufferPosition&
   return maximum;
 }
 
+template < typename SpikeDataT >
+void
+EventDeliveryManager::get_recv_range_spike_data_( const size_t rank,
+  const std::vector< SpikeDataT >& recv_buffer,
+  size_t& begin,
+  size_t& end ) const
+{
+  if ( spike_exchange_mode_ != SpikeExchangeMode::ALLTOALL )
+  {
+    begin = recv_displacements_spike_data_[ rank ];
+    end = begin + recv_counts_spike_data_[ rank ];
+    return;
+  }
+
+  const SendBufferPosition send_buffer_position;
+  begin = send_buffer_position.begin( rank );
+  end = begin;
+  if ( not recv_buffer[ begin ].is_invalid_marker() )
+  {
+    while ( not recv_buffer[ end ].is_end_marker() )
+    {
+      ++end;
+    }
+    ++end; // entry with end marker contains valid spike
+  }
+}
+
+template < typename SpikeDataT >
+void
+EventDeliveryManager::set_thread_offsets_spike_data_( const std::vector< SpikeDataT >& recv_buffer,
+  std::vector< size_t >& spike_thread_offsets )
+{
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  spike_thread_offsets.resize( kernel().mpi_manager.get_num_processes() * ( num_threads + 1 ) );
+
+  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  {
+    size_t begin = 0;
+    size_t end = 0;
+    get_recv_range_spike_data_( rank, recv_buffer, begin, end );
+
+    // Spikes in [begin, end) are sorted by target thread, so we can bisect for the thread boundaries.
+    auto it = recv_buffer.begin() + begin;
+    const auto it_end = recv_buffer.begin() + end;
+    for ( size_t tid = 0; tid < num_threads; ++tid )
+    {
+      it = std::lower_bound(
+        it, it_end, tid, []( const SpikeDataT& spike_data, const size_t t ) { return spike_data.get_tid() < t; } );
+      spike_thread_offsets[ rank * ( num_threads + 1 ) + tid ] = it - recv_buffer.begin();
+    }
+    spike_thread_offsets[ rank * ( num_threads + 1 ) + num_threads ] = end;
+  }
+}
+
 void
 EventDeliveryManager::deliver_events( const size_t tid )
 {
@@ -602,6 +1419,8 @@ EventDeliveryManager::deliver_events( const size_t tid )
   {
     deliver_events_( tid, recv_buffer_spike_data_ );
   }
+  deliver_local_events_( tid, local_spikes_register_ );
+  deliver_local_events_( tid, off_grid_local_spikes_register_ );
   reset_spike_register_( tid );
 }
 
@@ -619,34 +1438,70 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
   const std::vector< ConnectorModel* >& cm = kernel().model_manager.get_connection_models( tid );
 
   // prepare Time objects for every possible time stamp within min_delay_
-  std::vector< Time > prepared_timestamps( kernel().connection_manager.get_min_delay() );
-  for ( size_t lag = 0; lag < static_cast< size_t >( kernel().connection_manager.get_min_delay() ); ++lag )
+  const long min_delay = kernel().connection_manager.get_min_delay();
+  // Spikes were emitted in the previous slice, or in the slice before if communication is overlapped with the update.
+  const long slice_lag = kernel().connection_manager.spike_communication_overlapped() ? 2 * min_delay : min_delay;
+  std::vector< Time > prepared_timestamps( min_delay );
+  for ( size_t lag = 0; lag < static_cast< size_t >( min_delay ); ++lag )
   {
-    // Subtract min_delay because spikes were emitted in previous time slice and we use current clock.
-    prepared_timestamps[ lag ] =
-      kernel().simulation_manager.get_clock() + Time::step( lag + 1 - kernel().connection_manager.get_min_delay() );
+    // Subtract slice_lag because spikes were emitted in an earlier time slice and we use current clock.
+    prepared_timestamps[ lag ] = kernel().simulation_manager.get_clock() + Time::step( lag + 1 - slice_lag );
   }
 
-  // Deliver spikes sent by each rank in order
-  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  if ( recv_buffer_sorted_by_thread_ )
   {
-    // Continue with next rank if no spikes were sent by current rank
-    if ( recv_buffer[ rank * spike_buffer_size_per_rank ].is_invalid_marker() )
+    // Each rank has sent the spikes for this thread as one contiguous block.
+    const size_t num_threads = kernel().vp_manager.get_num_threads();
+    SpikeEvent se;
+    for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
     {
-      continue;
+      const size_t begin = spike_thread_offsets_[ rank * ( num_threads + 1 ) + tid ];
+      const size_t end = spike_thread_offsets_[ rank * ( num_threads + 1 ) + tid + 1 ];
+      for ( size_t i = begin; i < end; ++i )
+      {
+        const SpikeDataT& spike_data = recv_buffer[ i ];
+        assert( spike_data.get_tid() == tid );
+        se.set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
+        se.set_offset( spike_data.get_offset() );
+        se.set_multiplicity( spike_data.get_multiplicity() );
+        se.set_sender_node_id_info( tid, spike_data.get_syn_id(), spike_data.get_lcid() );
+        deliver_spike_( tid, spike_data.get_syn_id(), spike_data.get_lcid(), cm, se );
+      }
     }
+    return;
+  }
 
-    // Find number of spikes received from current rank
+  // Deliver spikes sent by each rank in order
+  for ( size_t rank = 0; rank < kernel().mpi_manager.get_num_processes(); ++rank )
+  {
+    size_t rank_begin = 0;
     size_t num_spikes_received = 0;
-    for ( size_t i = 0; i < spike_buffer_size_per_rank; ++i )
+    if ( spike_exchange_mode_ != SpikeExchangeMode::ALLTOALL )
+    {
+      rank_begin = recv_displacements_spike_data_[ rank ];
+      num_spikes_received = recv_counts_spike_data_[ rank ];
+    }
+    else
     {
-      const SpikeDataT& spike_data = recv_buffer[ rank * spike_buffer_size_per_rank + i ];
+      rank_begin = rank * spike_buffer_size_per_rank;
 
-      // break if this was the last valid entry from this rank
-      if ( spike_data.is_end_marker() )
+      // Continue with next rank if no spikes were sent by current rank
+      if ( recv_buffer[ rank_begin ].is_invalid_marker() )
       {
-        num_spikes_received = i + 1;
-        break;
+        continue;
+      }
+
+      // Find number of spikes received from current rank
+      for ( size_t i = 0; i < spike_buffer_size_per_rank; ++i )
+      {
+        const SpikeDataT& spike_data = recv_buffer[ rank_begin + i ];
+
+        // break if this was the last valid entry from this rank
+        if ( spike_data.is_end_marker() )
+        {
+          num_spikes_received = i + 1;
+          break;
+        }
       }
     }
 
@@ -666,9 +1521,10 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       {
         for ( size_t j = 0; j < SPIKES_PER_BATCH; ++j )
         {
-          const SpikeDataT& spike_data = recv_buffer[ rank * spike_buffer_size_per_rank + i * SPIKES_PER_BATCH + j ];
+          const SpikeDataT& spike_data = recv_buffer[ rank_begin + i * SPIKES_PER_BATCH + j ];
           se_batch[ j ].set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
           se_batch[ j ].set_offset( spike_data.get_offset() );
+          se_batch[ j ].set_multiplicity( spike_data.get_multiplicity() );
           tid_batch[ j ] = spike_data.get_tid();
           syn_id_batch[ j ] = spike_data.get_syn_id();
           lcid_batch[ j ] = spike_data.get_lcid();
@@ -678,7 +1534,7 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
         {
           if ( tid_batch[ j ] == tid )
           {
-            kernel().connection_manager.send( tid_batch[ j ], syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
+            deliver_spike_( tid_batch[ j ], syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
           }
         }
       }
@@ -686,10 +1542,10 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       // Processed all regular-sized batches, now do remainder
       for ( size_t j = 0; j < num_remaining_entries; ++j )
       {
-        const SpikeDataT& spike_data =
-          recv_buffer[ rank * spike_buffer_size_per_rank + num_batches * SPIKES_PER_BATCH + j ];
+        const SpikeDataT& spike_data = recv_buffer[ rank_begin + num_batches * SPIKES_PER_BATCH + j ];
         se_batch[ j ].set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
         se_batch[ j ].set_offset( spike_data.get_offset() );
+        se_batch[ j ].set_multiplicity( spike_data.get_multiplicity() );
         tid_batch[ j ] = spike_data.get_tid();
         syn_id_batch[ j ] = spike_data.get_syn_id();
         lcid_batch[ j ] = spike_data.get_lcid();
@@ -699,7 +1555,7 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       {
         if ( tid_batch[ j ] == tid )
         {
-          kernel().connection_manager.send( tid_batch[ j ], syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
+          deliver_spike_( tid_batch[ j ], syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
         }
       }
     }
@@ -709,10 +1565,11 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       {
         for ( size_t j = 0; j < SPIKES_PER_BATCH; ++j )
         {
-          const SpikeDataT& spike_data = recv_buffer[ rank * spike_buffer_size_per_rank + i * SPIKES_PER_BATCH + j ];
+          const SpikeDataT& spike_data = recv_buffer[ rank_begin + i * SPIKES_PER_BATCH + j ];
 
           se_batch[ j ].set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
           se_batch[ j ].set_offset( spike_data.get_offset() );
+          se_batch[ j ].set_multiplicity( spike_data.get_multiplicity() );
 
           syn_id_batch[ j ] = spike_data.get_syn_id();
           // for compressed spikes lcid holds the index in the
@@ -739,7 +1596,7 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
         {
           if ( lcid_batch[ j ] != invalid_lcid )
           {
-            kernel().connection_manager.send( tid, syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
+            deliver_spike_( tid, syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
           }
         }
       }
@@ -747,10 +1604,10 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       // Processed all regular-sized batches, now do remainder
       for ( size_t j = 0; j < num_remaining_entries; ++j )
       {
-        const SpikeDataT& spike_data =
-          recv_buffer[ rank * spike_buffer_size_per_rank + num_batches * SPIKES_PER_BATCH + j ];
+        const SpikeDataT& spike_data = recv_buffer[ rank_begin + num_batches * SPIKES_PER_BATCH + j ];
         se_batch[ j ].set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
         se_batch[ j ].set_offset( spike_data.get_offset() );
+        se_batch[ j ].set_multiplicity( spike_data.get_multiplicity() );
         syn_id_batch[ j ] = spike_data.get_syn_id();
         // for compressed spikes lcid holds the index in the
         // compressed_spike_data structure
@@ -776,13 +1633,59 @@ EventDeliveryManager::deliver_events_( const size_t tid, const std::vector< Spik
       {
         if ( lcid_batch[ j ] != invalid_lcid )
         {
-          kernel().connection_manager.send( tid, syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
+          deliver_spike_( tid, syn_id_batch[ j ], lcid_batch[ j ], cm, se_batch[ j ] );
         }
       }
     } // if-else not compressed
   }   // for rank
 }
 
+template < typename SpikeDataT >
+void
+EventDeliveryManager::deliver_local_events_( const size_t tid,
+  const std::vector< std::vector< std::vector< std::vector< SpikeDataT > >* > >& local_spikes_register )
+{
+  // deliver only at beginning of time slice
+  if ( kernel().simulation_manager.get_from_step() > 0 )
+  {
+    return;
+  }
+
+  const std::vector< ConnectorModel* >& cm = kernel().model_manager.get_connection_models( tid );
+
+  // Local spikes are always delivered in the slice after they were emitted, also if communication is overlapped.
+  const long min_delay = kernel().connection_manager.get_min_delay();
+  std::vector< Time > prepared_timestamps( min_delay );
+  for ( size_t lag = 0; lag < static_cast< size_t >( min_delay ); ++lag )
+  {
+    prepared_timestamps[ lag ] = kernel().simulation_manager.get_clock() + Time::step( lag + 1 - min_delay );
+  }
+
+  const bool use_compressed_spikes = kernel().connection_manager.use_compressed_spikes();
+
+  // Spikes were registered by all threads for this thread in the previous slice
+  SpikeEvent se;
+  for ( auto& local_spikes : local_spikes_register[ read_toggle() ] )
+  {
+    std::vector< SpikeDataT >& spikes = ( *local_spikes )[ tid ];
+    for ( const SpikeDataT& spike_data : spikes )
+    {
+      const synindex syn_id = spike_data.get_syn_id();
+      // for compressed spikes lcid holds the index in the
+      // compressed_spike_data structure
+      const size_t lcid = use_compressed_spikes
+        ? kernel().connection_manager.get_compressed_spike_data( syn_id, spike_data.get_lcid() )[ tid ].get_lcid()
+        : spike_data.get_lcid();
+      se.set_stamp( prepared_timestamps[ spike_data.get_lag() ] );
+      se.set_offset( spike_data.get_offset() );
+      se.set_multiplicity( spike_data.get_multiplicity() );
+      se.set_sender_node_id_info( tid, syn_id, lcid );
+      deliver_spike_( tid, syn_id, lcid, cm, se );
+    }
+    spikes.clear();
+  }
+}
+
 
 void
 EventDeliveryManager::gather_target_data( const size_t tid )
@@ -1038,6 +1941,20 @@ EventDeliveryManager::collocate_target_data_buffers_compressed_( const size_t ti
   const bool is_source_table_read = kernel().connection_manager.fill_target_buffer(
     tid, assigned_ranks.begin, assigned_ranks.end, send_buffer_target_data_, send_buffer_position );
 
+  // Mark end of data for this round, also if the chunk of some rank has been filled before all
+  // targets were written. Otherwise, the receiving side reads stale entries from earlier rounds.
+  for ( size_t rank = assigned_ranks.begin; rank < assigned_ranks.end; ++rank )
+  {
+    if ( send_buffer_position.idx( rank ) > send_buffer_position.begin( rank ) )
+    {
+      send_buffer_target_data_[ send_buffer_position.idx( rank ) - 1 ].set_end_marker();
+    }
+    else
+    {
+      send_buffer_target_data_[ send_buffer_position.begin( rank ) ].set_invalid_marker();
+    }
+  }
+
   return is_source_table_read;
 }
 
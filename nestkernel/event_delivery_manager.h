@@ -52,10 +52,21 @@ namespace nest
 {
 typedef MPIManager::OffGridSpike OffGridSpike;
 
+class ConnectorModel;
 class TargetData;
 class SendBufferPosition;
 class TargetSendBufferPosition;
 
+/**
+ * Collective operation used to exchange spikes between MPI processes.
+ */
+enum class SpikeExchangeMode
+{
+  ALLTOALL,          //!< chunk of fixed size for every rank, see spike_data.h
+  ALLTOALLV,         //!< only spikes actually sent, after exchanging their number
+  NEIGHBOR_ALLTOALLV //!< as ALLTOALLV, but only between ranks connected according to the target table
+};
+
 
 class EventDeliveryManager : public ManagerInterface
 {
@@ -151,6 +162,22 @@ public:
    */
   void set_off_grid_communication( bool off_grid_spiking );
 
+  /**
+   * Return whether spike communication shall be overlapped with the update.
+   *
+   * Whether it actually is depends also on the smallest delay, see
+   * ConnectionManager::spike_communication_overlapped().
+   */
+  bool get_overlap_spike_communication() const;
+
+  /**
+   * Mark graph of ranks exchanging spikes as outdated.
+   *
+   * Must be called whenever the target table has changed. The graph is rebuilt on the next spike exchange
+   * if spike_exchange_mode is neighbor_alltoallv.
+   */
+  void reset_spike_data_neighbors();
+
   /**
    * Return 0 for even, 1 for odd time slices.
    *
@@ -202,8 +229,20 @@ public:
   /**
    * Collocates spikes from register to MPI buffers, communicates via
    * MPI and delivers events to targets.
+   *
+   * Must be called by all threads in a parallel region. Spikes are collocated thread-parallel
+   * unless only spikes actually sent are exchanged, while the master thread is responsible
+   * for communication and resizing of buffers.
    */
-  void gather_spike_data();
+  void gather_spike_data( const size_t tid );
+
+  /**
+   * Wait for completion of the spike exchange started by the last call to gather_spike_data().
+   *
+   * Only required if spike communication is overlapped with the update. The received spikes are delivered
+   * at the beginning of the next slice after the next call to gather_spike_data().
+   */
+  void complete_spike_data_exchange();
 
   /**
    * Collocates presynaptic connection information, communicates via
@@ -270,30 +309,163 @@ public:
 
 private:
   template < typename SpikeDataT >
-  void gather_spike_data_( std::vector< SpikeDataT >& send_buffer, std::vector< SpikeDataT >& recv_buffer );
+  void gather_spike_data_( const size_t tid,
+    std::vector< SpikeDataT >& send_buffer,
+    std::vector< SpikeDataT >& recv_buffer );
 
-  void resize_send_recv_buffers_spike_data_();
+  /**
+   * Exchange spikes while the next slice is updated.
+   *
+   * Completes the exchange started at the end of the previous slice, makes its result available for delivery
+   * and starts a non-blocking exchange of the spikes emitted during the current slice.
+   */
+  template < typename SpikeDataT >
+  void gather_spike_data_overlapped_( const size_t tid,
+    std::vector< SpikeDataT >& send_buffer,
+    std::vector< SpikeDataT >& recv_buffer,
+    std::vector< SpikeDataT >& pending_send_buffer,
+    std::vector< SpikeDataT >& pending_recv_buffer );
+
+  /**
+   * Wait for pending non-blocking spike exchange.
+   *
+   * If the MPI buffers turn out to be too large or too small, they are resized and the exchange is repeated
+   * in blocking mode.
+   */
+  template < typename SpikeDataT >
+  void complete_spike_data_exchange_( std::vector< SpikeDataT >& pending_send_buffer,
+    std::vector< SpikeDataT >& pending_recv_buffer );
+
+  /**
+   * Exchange spikes in given registers in blocking mode, growing MPI buffers until all spikes are transmitted.
+   */
+  template < typename SpikeDataT >
+  void exchange_spike_data_( std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+    std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+    std::vector< SpikeDataT >& send_buffer,
+    std::vector< SpikeDataT >& recv_buffer );
+
+  /**
+   * Exchange spikes in given registers in blocking mode, collocating spikes thread-parallel.
+   *
+   * Must be called by all threads.
+   */
+  template < typename SpikeDataT >
+  void exchange_spike_data_( const size_t tid,
+    std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+    std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+    std::vector< SpikeDataT >& send_buffer,
+    std::vector< SpikeDataT >& recv_buffer );
+
+  /**
+   * Write spikes from given registers to send buffer and set markers, on the calling thread only.
+   *
+   * Spikes are counted and written as by the thread-parallel version below, with all registers handled by
+   * the calling thread.
+   */
+  template < typename SpikeDataT >
+  void collocate_spike_data_( const SendBufferPosition& send_buffer_position,
+    std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+    std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+    std::vector< SpikeDataT >& send_buffer );
+
+  /**
+   * Write spikes from given registers to send buffer and set markers, thread-parallel.
+   *
+   * Must be called by all threads. Each thread counts the spikes it has emitted per target rank, or per target rank
+   * and thread if spikes are sorted by thread. An exclusive prefix sum over these counts then yields the position
+   * in the send buffer at which each thread writes its spikes. Prefix sums and markers for each rank are computed
+   * by the thread the rank is assigned to, see VPManager::get_assigned_ranks().
+   */
+  template < typename SpikeDataT >
+  void collocate_spike_data_( const size_t tid,
+    std::vector< std::vector< SpikeDataWithRank >* >& emitted_spikes_register,
+    std::vector< std::vector< OffGridSpikeDataWithRank >* >& off_grid_emitted_spikes_register,
+    std::vector< SpikeDataT >& send_buffer );
+
+  /**
+   * Return the bin of a spike in the send buffer, i.e., its target rank or its target rank and thread.
+   */
+  template < typename SpikeDataWithRankT >
+  size_t get_spike_bin_( const SpikeDataWithRankT& emitted_spike,
+    const bool sort_by_thread,
+    const size_t num_threads ) const;
 
   /**
-   * Moves spikes from on grid and off grid spike registers to correct
-   * locations in MPI buffers.
+   * Count spikes emitted by a single thread per bin, see get_spike_bin_().
    *
-   * Accumulates count of spikes to be sent to any rank in num_spikes_per_rank.
-   * Passed as argument, so that values accumulate as we call once for plain and once for offgrid spikes.
+   * Counts accumulate in spike_counts, so that we can call once for plain and once for offgrid spikes.
+   */
+  template < typename SpikeDataWithRankT >
+  void count_spikes_( const std::vector< SpikeDataWithRankT >& emitted_spikes,
+    std::vector< size_t >& spike_counts,
+    const bool sort_by_thread ) const;
+
+  /**
+   * Moves spikes emitted by a single thread to the positions in the send buffer given by write_positions.
+   *
+   * Spikes to ranks with more than max_spikes_per_rank spikes in num_spikes_per_rank are not written, since
+   * the exchange needs to be repeated with larger buffers.
    */
   template < typename SpikeDataWithRankT, typename SpikeDataT >
-  void collocate_spike_data_buffers_( SendBufferPosition& send_buffer_position,
-    std::vector< std::vector< SpikeDataWithRankT >* >& spike_register,
+  void collocate_spike_data_buffers_( const std::vector< SpikeDataWithRankT >& emitted_spikes,
     std::vector< SpikeDataT >& send_buffer,
+    std::vector< size_t >& write_positions,
+    const bool sort_by_thread,
+    const std::vector< size_t >& num_spikes_per_rank,
+    const size_t max_spikes_per_rank ) const;
+
+  //! Return true if spikes are to be sorted by target thread in the MPI buffers.
+  bool use_thread_sorted_spikes_() const;
+
+  /**
+   * Exchange only the spikes actually sent, see SpikeExchangeMode.
+   *
+   * Spikes for each rank are stored contiguously in the MPI buffers, without markers.
+   */
+  template < typename SpikeDataT >
+  void gather_spike_data_sparse_( std::vector< SpikeDataT >& send_buffer, std::vector< SpikeDataT >& recv_buffer );
+
+  /**
+   * Find beginning and end of spikes received from rank in receive buffer.
+   */
+  template < typename SpikeDataT >
+  void get_recv_range_spike_data_( const size_t rank,
+    const std::vector< SpikeDataT >& recv_buffer,
+    size_t& begin,
+    size_t& end ) const;
+
+  /**
+   * Mark all per-rank chunks of receive buffer as empty.
+   */
+  template < typename SpikeDataT >
+  void clear_recv_buffer_spike_data_( std::vector< SpikeDataT >& recv_buffer ) const;
+
+  void resize_send_recv_buffers_spike_data_();
+
+  /**
+   * Convert counts per bin in spike_write_positions_ to write positions in MPI buffer.
+   *
+   * Stores total number of spikes to be sent to any rank in num_spikes_per_rank.
+   */
+  void set_spike_write_positions_( const SendBufferPosition& send_buffer_position,
+    const size_t num_bins_per_rank,
     std::vector< size_t >& num_spikes_per_rank );
 
   /**
-   * Set end marker for per-rank-chunks signalling completion and providing shrink/grow information.
+   * Set end marker for a single per-rank chunk.
+   *
+   * @param begin first entry of chunk in send buffer
+   * @param end one beyond last entry of chunk in send buffer
+   * @param next_write_idx one beyond last entry written to
    */
   template < typename SpikeDataT >
-  void set_end_marker_( const SendBufferPosition& send_buffer_position,
+  void set_end_marker_( const size_t begin,
+    const size_t end,
+    const size_t next_write_idx,
     std::vector< SpikeDataT >& send_buffer,
-    size_t local_max_spikes_per_rank );
+    const bool collocate_complete,
+    const size_t local_max_spikes_per_rank ) const;
 
   /**
    * Resets marker in MPI buffer that signals end of communication
@@ -313,6 +485,15 @@ private:
     std::vector< SpikeDataT >& recv_buffer ) const;
 
 
+  /**
+   * Find for each rank the part of the receive buffer holding spikes for each thread.
+   *
+   * Requires that spikes in each per-rank chunk are sorted by target thread.
+   */
+  template < typename SpikeDataT >
+  void set_thread_offsets_spike_data_( const std::vector< SpikeDataT >& recv_buffer,
+    std::vector< size_t >& spike_thread_offsets );
+
   /**
    * Reads spikes from MPI buffers and delivers them to ringbuffer of
    * nodes.
@@ -320,6 +501,41 @@ private:
   template < typename SpikeDataT >
   void deliver_events_( const size_t tid, const std::vector< SpikeDataT >& recv_buffer );
 
+  /**
+   * Delivers spikes emitted to targets on this rank in the previous slice.
+   *
+   * Thread tid reads the spikes all threads have registered for it and clears them afterwards.
+   */
+  template < typename SpikeDataT >
+  void deliver_local_events_( const size_t tid,
+    const std::vector< std::vector< std::vector< std::vector< SpikeDataT > >* > >& local_spikes_register );
+
+  /**
+   * Delivers a spike to the connections starting at lcid.
+   *
+   * The multiplicity of the spike is unrolled into individual spikes for synapse types that do not support
+   * multiplicity.
+   */
+  void deliver_spike_( const size_t tid,
+    const synindex syn_id,
+    const size_t lcid,
+    const std::vector< ConnectorModel* >& cm,
+    SpikeEvent& se );
+
+  /**
+   * Adds a spike to a target on this rank to the local spike register of the emitting thread.
+   *
+   * If spikes are compressed, the target refers to an entry of the compressed spike data, which is expanded
+   * here into one spike per target thread. These spikes keep the index of the entry and are resolved to the
+   * local connection id upon delivery. The remaining arguments are the lag and, for off-grid spikes,
+   * the offset.
+   */
+  template < typename SpikeDataT, typename... LagAndOffset >
+  void register_local_spike_( std::vector< std::vector< SpikeDataT > >& local_spikes,
+    const Target& target,
+    const size_t multiplicity,
+    const LagAndOffset... lag_and_offset );
+
   /**
    * Deletes all spikes from spike registers and resets spike
    * counters.
@@ -373,6 +589,27 @@ private:
   bool off_grid_spiking_; //!< indicates whether spikes are not constrained to
                           //!< the grid
 
+  //! whether spikes in MPI buffers shall be sorted by target thread (only without spike compression)
+  bool sort_spikes_by_thread_;
+
+  //! whether spikes in current receive buffers are sorted by target thread
+  bool recv_buffer_sorted_by_thread_;
+
+  //! whether spike communication shall be overlapped with the update of the next slice
+  bool overlap_spike_communication_;
+
+  //! collective operation used to exchange spikes
+  SpikeExchangeMode spike_exchange_mode_;
+
+  //! whether the graph of ranks exchanging spikes matches the current target table
+  bool spike_data_neighbors_valid_;
+
+  //! whether a non-blocking spike exchange has been started but not completed
+  bool spike_data_exchange_pending_;
+
+  //! whether spikes in pending receive buffers are sorted by target thread
+  bool pending_recv_buffer_sorted_by_thread_;
+
   /**
    * Table of pre-computed modulos.
    *
@@ -423,6 +660,31 @@ private:
    */
   std::vector< std::vector< OffGridSpikeDataWithRank >* > off_grid_emitted_spikes_register_;
 
+  /**
+   * Registers of spikes emitted in the previous slice if spike communication is overlapped with the update.
+   *
+   * These spikes are being exchanged while the current slice is updated. They are kept until the exchange
+   * is complete, since the exchange may have to be repeated with resized MPI buffers.
+   */
+  std::vector< std::vector< SpikeDataWithRank >* > pending_emitted_spikes_register_;
+  std::vector< std::vector< OffGridSpikeDataWithRank >* > pending_off_grid_emitted_spikes_register_;
+
+  /**
+   * Registers of spikes to targets on this rank.
+   *
+   * Spikes to targets on the same rank bypass the communication buffers. They are written to these registers
+   * by the thread generating the spike and read at the beginning of the next slice by the thread of the target.
+   *
+   * The outermost dimension is the slice parity (see write_toggle()), so that spikes emitted in the current
+   * slice do not interfere with spikes being delivered from the previous slice. The next dimensions represent
+   * the thread generating the spikes and the thread of the target, the innermost dimension the individual spikes.
+   *
+   * @note As for emitted_spikes_register_, the vectors for the individual generating threads are stored
+   * by pointer so that they are allocated in thread-local memory.
+   */
+  std::vector< std::vector< std::vector< std::vector< SpikeData > >* > > local_spikes_register_;
+  std::vector< std::vector< std::vector< std::vector< OffGridSpikeData > >* > > off_grid_local_spikes_register_;
+
   /**
    * Buffer to collect the secondary events after serialization.
    */
@@ -439,6 +701,55 @@ private:
   std::vector< OffGridSpikeData > send_buffer_off_grid_spike_data_;
   std::vector< OffGridSpikeData > recv_buffer_off_grid_spike_data_;
 
+  //! MPI buffers used by non-blocking spike exchange if spike communication is overlapped with the update
+  std::vector< SpikeData > pending_send_buffer_spike_data_;
+  std::vector< SpikeData > pending_recv_buffer_spike_data_;
+  std::vector< OffGridSpikeData > pending_send_buffer_off_grid_spike_data_;
+  std::vector< OffGridSpikeData > pending_recv_buffer_off_grid_spike_data_;
+
+  /**
+   * Write positions in MPI send buffer when sorting spikes by target thread.
+   *
+   * Entry rank * num_threads + tid is the next position to write a spike for thread tid on rank to.
+   */
+  std::vector< size_t > spike_write_positions_;
+
+  /**
+   * Write positions in MPI send buffer for the spikes of each thread if spikes are collocated thread-parallel.
+   *
+   * The outer dimension represents the thread that emitted the spikes, the inner dimension the target rank or,
+   * if spikes are sorted by thread, entry rank * num_threads + tid the target rank and thread.
+   * Entries hold the number of spikes until they are converted to write positions.
+   */
+  std::vector< std::vector< size_t > > spike_write_positions_per_thread_;
+
+  //! Number of spikes to each rank if spikes are collocated thread-parallel
+  std::vector< size_t > num_spikes_per_rank_;
+
+  //! Largest number of spikes to any of the ranks assigned to each thread if spikes are collocated thread-parallel
+  std::vector< size_t > max_spikes_per_assigned_rank_;
+
+  /**
+   * Offsets of thread-specific parts of MPI receive buffer when spikes are sorted by target thread.
+   *
+   * Spikes sent by rank to thread tid are stored in the receive buffer from entry
+   * spike_thread_offsets_[ rank * ( num_threads + 1 ) + tid ] up to, but excluding, entry
+   * spike_thread_offsets_[ rank * ( num_threads + 1 ) + tid + 1 ].
+   */
+  std::vector< size_t > spike_thread_offsets_;
+
+  //! Offsets of thread-specific parts of pending MPI receive buffer, see spike_thread_offsets_.
+  std::vector< size_t > pending_spike_thread_offsets_;
+
+  //! Number of spikes sent to each rank if only spikes actually sent are exchanged
+  std::vector< size_t > send_counts_spike_data_;
+
+  //! Number of spikes received from each rank if only spikes actually sent are exchanged
+  std::vector< size_t > recv_counts_spike_data_;
+
+  //! Position of first spike received from each rank if only spikes actually sent are exchanged
+  std::vector< size_t > recv_displacements_spike_data_;
+
   std::vector< TargetData > send_buffer_target_data_;
   std::vector< TargetData > recv_buffer_target_data_;
 
@@ -500,6 +811,18 @@ EventDeliveryManager::get_off_grid_communication() const
   return off_grid_spiking_;
 }
 
+inline bool
+EventDeliveryManager::get_overlap_spike_communication() const
+{
+  return overlap_spike_communication_;
+}
+
+inline void
+EventDeliveryManager::reset_spike_data_neighbors()
+{
+  spike_data_neighbors_valid_ = false;
+}
+
 inline void
 EventDeliveryManager::set_off_grid_communication( bool off_grid_spiking )
 {
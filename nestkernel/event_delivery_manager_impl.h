@@ -25,6 +25,9 @@
 
 #include "event_delivery_manager.h"
 
+// C++ includes:
+#include <algorithm>
+
 // Includes from nestkernel:
 #include "connection_manager_impl.h"
 #include "kernel_manager.h"
@@ -100,19 +103,93 @@ EventDeliveryManager::send< DSSpikeEvent >( Node& source, DSSpikeEvent& e, const
   send_local_( source, e, lag );
 }
 
+template < typename SpikeDataT, typename... LagAndOffset >
+inline void
+EventDeliveryManager::register_local_spike_( std::vector< std::vector< SpikeDataT > >& local_spikes,
+  const Target& target,
+  const size_t multiplicity,
+  const LagAndOffset... lag_and_offset )
+{
+  if ( not kernel().connection_manager.use_compressed_spikes() )
+  {
+    for ( size_t remaining = multiplicity; remaining > 0; )
+    {
+      const size_t entry_multiplicity = std::min( remaining, static_cast< size_t >( MAX_MULTIPLICITY ) );
+      local_spikes[ target.get_tid() ].emplace_back(
+        target.get_tid(), target.get_syn_id(), target.get_lcid(), lag_and_offset... );
+      local_spikes[ target.get_tid() ].back().set_multiplicity( entry_multiplicity );
+      remaining -= entry_multiplicity;
+    }
+    return;
+  }
+
+  const std::vector< SpikeData >& compressed_spike_data =
+    kernel().connection_manager.get_compressed_spike_data( target.get_syn_id(), target.get_lcid() );
+  for ( size_t tid = 0; tid < compressed_spike_data.size(); ++tid )
+  {
+    if ( compressed_spike_data[ tid ].get_lcid() == invalid_lcid )
+    {
+      continue;
+    }
+    // Keep the index into the compressed spike data, as connections may be
+    // re-sorted before the spike is delivered in the next slice.
+    for ( size_t remaining = multiplicity; remaining > 0; )
+    {
+      const size_t entry_multiplicity = std::min( remaining, static_cast< size_t >( MAX_MULTIPLICITY ) );
+      local_spikes[ tid ].emplace_back( tid, target.get_syn_id(), target.get_lcid(), lag_and_offset... );
+      local_spikes[ tid ].back().set_multiplicity( entry_multiplicity );
+      remaining -= entry_multiplicity;
+    }
+  }
+}
+
+inline void
+EventDeliveryManager::deliver_spike_( const size_t tid,
+  const synindex syn_id,
+  const size_t lcid,
+  const std::vector< ConnectorModel* >& cm,
+  SpikeEvent& se )
+{
+  const size_t multiplicity = se.get_multiplicity();
+  if ( multiplicity == 1 or cm[ syn_id ]->has_property( ConnectionModelProperties::SUPPORTS_MULTIPLICITY ) )
+  {
+    kernel().connection_manager.send( tid, syn_id, lcid, cm, se );
+    return;
+  }
+
+  // Unroll spike multiplicity as plastic synapses only handle individual spikes.
+  se.set_multiplicity( 1 );
+  for ( size_t i = 0; i < multiplicity; ++i )
+  {
+    kernel().connection_manager.send( tid, syn_id, lcid, cm, se );
+  }
+}
+
 inline void
 EventDeliveryManager::send_remote( size_t tid, SpikeEvent& e, const long lag )
 {
-  // Put the spike in a buffer for the remote machines
+  // Put the spike in a buffer for the remote machines, or directly into the local register if the target is on
+  // this rank
   const size_t lid = kernel().vp_manager.node_id_to_lid( e.get_sender().get_node_id() );
   const auto& targets = kernel().connection_manager.get_remote_targets_of_local_node( tid, lid );
+  const size_t rank = kernel().mpi_manager.get_rank();
 
   for ( const auto& target : targets )
   {
-    // Unroll spike multiplicity as plastic synapses only handle individual spikes.
-    for ( size_t i = 0; i < e.get_multiplicity(); ++i )
+    if ( target.get_rank() == rank )
+    {
+      register_local_spike_( *local_spikes_register_[ write_toggle() ][ tid ],
+        target,
+        e.get_multiplicity(),
+        static_cast< unsigned int >( lag ) );
+      continue;
+    }
+
+    for ( size_t remaining = e.get_multiplicity(); remaining > 0; )
     {
-      ( *emitted_spikes_register_[ tid ] ).emplace_back( target, lag );
+      const size_t entry_multiplicity = std::min( remaining, static_cast< size_t >( MAX_MULTIPLICITY ) );
+      ( *emitted_spikes_register_[ tid ] ).emplace_back( target, lag, entry_multiplicity );
+      remaining -= entry_multiplicity;
     }
   }
 }
@@ -120,16 +197,29 @@ EventDeliveryManager::send_remote( size_t tid, SpikeEvent& e, const long lag )
 inline void
 EventDeliveryManager::send_off_grid_remote( size_t tid, SpikeEvent& e, const long lag )
 {
-  // Put the spike in a buffer for the remote machines
+  // Put the spike in a buffer for the remote machines, or directly into the local register if the target is on
+  // this rank
   const size_t lid = kernel().vp_manager.node_id_to_lid( e.get_sender().get_node_id() );
   const auto& targets = kernel().connection_manager.get_remote_targets_of_local_node( tid, lid );
+  const size_t rank = kernel().mpi_manager.get_rank();
 
   for ( const auto& target : targets )
   {
-    // Unroll spike multiplicity as plastic synapses only handle individual spikes.
-    for ( size_t i = 0; i < e.get_multiplicity(); ++i )
+    if ( target.get_rank() == rank )
+    {
+      register_local_spike_( *off_grid_local_spikes_register_[ write_toggle() ][ tid ],
+        target,
+        e.get_multiplicity(),
+        static_cast< unsigned int >( lag ),
+        e.get_offset() );
+      continue;
+    }
+
+    for ( size_t remaining = e.get_multiplicity(); remaining > 0; )
     {
-      ( *off_grid_emitted_spikes_register_[ tid ] ).emplace_back( target, lag, e.get_offset() );
+      const size_t entry_multiplicity = std::min( remaining, static_cast< size_t >( MAX_MULTIPLICITY ) );
+      ( *off_grid_emitted_spikes_register_[ tid ] ).emplace_back( target, lag, e.get_offset(), entry_multiplicity );
+      remaining -= entry_multiplicity;
     }
   }
 }
@@ -61,10 +61,14 @@ protected:
   template < class Ins >
   void communicate_positions_( Ins iter, NodeCollectionPTR node_collection );
 
-  void insert_global_positions_ntree_( Ntree< D, size_t >& tree, NodeCollectionPTR node_collection );
   void insert_global_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
     NodeCollectionPTR node_collection );
 
+  void insert_region_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+    const std::vector< std::pair< Position< D >, size_t > >& local_positions,
+    const typename Layer< D >::Region_& region,
+    NodeCollectionPTR node_collection );
+
   /**
    * Calculate the index in the position vector on this MPI process based on the local ID.
    *
@@ -329,14 +333,6 @@ FreeLayer< D >::communicate_positions_( Ins iter, NodeCollectionPTR node_collect
   }
 }
 
-template < int D >
-void
-FreeLayer< D >::insert_global_positions_ntree_( Ntree< D, size_t >& tree, NodeCollectionPTR node_collection )
-{
-
-  communicate_positions_( std::inserter( tree, tree.end() ), node_collection );
-}
-
 // Helper function to compare node IDs used for sorting (Position,node ID) pairs
 template < int D >
 static bool
@@ -357,6 +353,80 @@ FreeLayer< D >::insert_global_positions_vector_( std::vector< std::pair< Positio
   std::sort( vec.begin(), vec.end(), node_id_less< D > );
 }
 
+template < int D >
+void
+FreeLayer< D >::insert_region_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+  const std::vector< std::pair< Position< D >, size_t > >& local_positions,
+  const typename Layer< D >::Region_& region,
+  NodeCollectionPTR node_collection )
+{
+  const size_t num_processes = kernel().mpi_manager.get_num_processes();
+  if ( not node_collection->has_proxies() or num_processes == 1 )
+  {
+    // All positions are on this MPI process.
+    for ( const auto& node_pos : local_positions )
+    {
+      if ( region.contains( node_pos.first ) )
+      {
+        vec.push_back( node_pos );
+      }
+    }
+  }
+  else
+  {
+    // Gather the regions of all MPI processes, each as lower left and upper right corner.
+    std::vector< double > local_box;
+    for ( int j = 0; j < D; ++j )
+    {
+      local_box.push_back( region.box.lower_left[ j ] );
+    }
+    for ( int j = 0; j < D; ++j )
+    {
+      local_box.push_back( region.box.upper_right[ j ] );
+    }
+    std::vector< double > boxes;
+    std::vector< int > displacements;
+    kernel().mpi_manager.communicate( local_box, boxes, displacements );
+
+    // Send node ID,pos_x,pos_y[,pos_z] of each local node to the MPI processes whose region contains it.
+    std::vector< double > send_buffer;
+    std::vector< int > send_counts( num_processes, 0 );
+    typename Layer< D >::Region_ remote_region = region;
+    for ( size_t rank = 0; rank < num_processes; ++rank )
+    {
+      const double* const box = &boxes[ 2 * D * rank ];
+      remote_region.box = Box< D >( Position< D >( box ), Position< D >( box + D ) );
+      const size_t begin = send_buffer.size();
+      for ( const auto& node_pos : local_positions )
+      {
+        if ( remote_region.contains( node_pos.first ) )
+        {
+          send_buffer.push_back( node_pos.second );
+          for ( int j = 0; j < D; ++j )
+          {
+            send_buffer.push_back( node_pos.first[ j ] );
+          }
+        }
+      }
+      send_counts[ rank ] = send_buffer.size() - begin;
+    }
+
+    std::vector< double > recv_buffer;
+    kernel().mpi_manager.communicate_Alltoallv( send_buffer, send_counts, recv_buffer );
+
+    // Each node is sent by a single MPI process, so there are no multiple entries.
+    const NodePositionData* pos_ptr = reinterpret_cast< const NodePositionData* >( recv_buffer.data() );
+    const NodePositionData* const pos_end = pos_ptr + recv_buffer.size() / ( D + 1 );
+    for ( ; pos_ptr < pos_end; ++pos_ptr )
+    {
+      vec.push_back( std::pair< Position< D >, size_t >( pos_ptr->get_position(), pos_ptr->get_node_id() ) );
+    }
+  }
+
+  // Sort vector in the same order as insert_global_positions_vector_()
+  std::sort( vec.begin(), vec.end(), node_id_less< D > );
+}
+
 template < int D >
 size_t
 FreeLayer< D >::lid_to_position_id_( size_t lid ) const
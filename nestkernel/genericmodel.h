@@ -102,7 +102,7 @@ private:
   /**
    * Call placement new on the supplied memory position.
    */
-  Node* create_() override;
+  Node* create_( void* ) override;
 
   /**
    * Prototype node from which all instances are constructed.
@@ -148,9 +148,9 @@ GenericModel< ElementT >::clone( const std::string& newname ) const
 
 template < typename ElementT >
 Node*
-GenericModel< ElementT >::create_()
+GenericModel< ElementT >::create_( void* adr )
 {
-  Node* n = new ElementT( proto_ );
+  Node* n = new ( adr ) ElementT( proto_ );
   return n;
 }
 
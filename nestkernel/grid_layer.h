@@ -156,9 +156,12 @@ protected:
 
   template < class Ins >
   void insert_global_positions_( Ins iter, NodeCollectionPTR node_collection );
-  void insert_global_positions_ntree_( Ntree< D, size_t >& tree, NodeCollectionPTR node_collection );
   void insert_global_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
     NodeCollectionPTR node_collection );
+  void insert_region_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+    const std::vector< std::pair< Position< D >, size_t > >& local_positions,
+    const typename Layer< D >::Region_& region,
+    NodeCollectionPTR node_collection );
 };
 
 template < int D >
@@ -292,17 +295,29 @@ GridLayer< D >::insert_global_positions_( Ins iter, NodeCollectionPTR node_colle
 
 template < int D >
 void
-GridLayer< D >::insert_global_positions_ntree_( Ntree< D, size_t >& tree, NodeCollectionPTR node_collection )
+GridLayer< D >::insert_global_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+  NodeCollectionPTR node_collection )
 {
-  insert_global_positions_( std::inserter( tree, tree.end() ), node_collection );
+  insert_global_positions_( std::back_inserter( vec ), node_collection );
 }
 
 template < int D >
 void
-GridLayer< D >::insert_global_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+GridLayer< D >::insert_region_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+  const std::vector< std::pair< Position< D >, size_t > >&,
+  const typename Layer< D >::Region_& region,
   NodeCollectionPTR node_collection )
 {
-  insert_global_positions_( std::back_inserter( vec ), node_collection );
+  // Positions of grid layers are known on all MPI processes.
+  for ( auto gi = node_collection->begin(); gi < node_collection->end(); ++gi )
+  {
+    const auto triple = *gi;
+    const Position< D > pos = lid_to_position( triple.lid );
+    if ( region.contains( pos ) )
+    {
+      vec.push_back( std::pair< Position< D >, size_t >( pos, triple.node_id ) );
+    }
+  }
 }
 
 template < int D >
@@ -41,6 +41,7 @@
 #include "io_manager_impl.h"
 #include "kernel_manager.h"
 #include "recording_backend_ascii.h"
+#include "recording_backend_binary.h"
 #include "recording_backend_memory.h"
 #include "recording_backend_screen.h"
 #ifdef HAVE_MPI
@@ -75,6 +76,7 @@ IOManager::initialize( const bool adjust_number_of_threads_or_rng_only )
     // Register backends again, since finalize cleans up
     // so backends from external modules are unloaded
     register_recording_backend< RecordingBackendASCII >( "ascii" );
+    register_recording_backend< RecordingBackendBinary >( "binary" );
     register_recording_backend< RecordingBackendMemory >( "memory" );
     register_recording_backend< RecordingBackendScreen >( "screen" );
 #ifdef HAVE_MPI
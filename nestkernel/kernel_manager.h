@@ -98,6 +98,18 @@
  num_processes                         integertype - The number of MPI processes (read only).
  off_grid_spiking                      booltype    - Whether to transmit precise spike times in MPI communication (read
                                                      only).
+ overlap_spike_communication           booltype    - Whether to exchange spikes while the next slice is updated; slices
+                                                     then cover at most half the smallest delay and spikes are delivered
+                                                     one slice later; cannot be changed after Simulate has been called,
+                                                     defaults to false.
+ spike_exchange_mode                   stringtype  - Collective operation used to exchange spikes: 'alltoall' sends a
+                                                     chunk of fixed size to every process, 'alltoallv' sends only the
+                                                     spikes present after exchanging their number, 'neighbor_alltoallv'
+                                                     does so only between processes connected by synapses; cannot be
+                                                     changed after Simulate has been called, defaults to 'alltoall'.
+ sort_spikes_by_thread                 booltype    - Whether to sort spikes in MPI buffers by target thread, so that
+                                                     each thread only reads the spikes it needs to deliver; has no
+                                                     effect if use_compressed_spikes is true, defaults to false.
  total_num_virtual_procs               integertype - The total number of virtual processes, defaults to 1.
  use_compressed_spikes                 booltype    - Whether to use spike compression; if a neuron has targets on
                                                      multiple threads of a process, this switch makes sure that only a
@@ -171,7 +183,15 @@
                                                      0.0001.
 
  Miscellaneous
+ align_nodes_to_cache_lines            booltype    - Whether to align nodes in memory to cache lines of 64 bytes; can
+                                                     only be changed before nodes are created, defaults to false.
+ bytes_per_synapse                     dicttype    - Size of a single connection in bytes for each synapse model (read
+                                                     only).
  dict_miss_is_error                    booltype    - Whether missed dictionary entries are treated as errors.
+ node_memory                           dicttype    - Memory pools for nodes, summed over all models and threads:
+                                                     number of nodes (instantiations), of slots allocated (capacity)
+                                                     and of free slots (available), bytes allocated (bytes) and
+                                                     alignment of nodes in bytes (alignment) (read only).
 
  SeeAlso: Simulate, Node
 */
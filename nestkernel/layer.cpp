@@ -44,13 +44,17 @@
 namespace nest
 {
 
-NodeCollectionMetadataPTR AbstractLayer::cached_ntree_md_ = NodeCollectionMetadataPTR( nullptr );
-NodeCollectionMetadataPTR AbstractLayer::cached_vector_md_ = NodeCollectionMetadataPTR( nullptr );
-
 AbstractLayer::~AbstractLayer()
 {
 }
 
+void
+AbstractLayer::clear_position_caches()
+{
+  Layer< 2 >::clear_all_position_cache();
+  Layer< 3 >::clear_all_position_cache();
+}
+
 NodeCollectionPTR
 AbstractLayer::create_layer( const DictionaryDatum& layer_dict )
 {
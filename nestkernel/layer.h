@@ -26,6 +26,9 @@
 // C++ includes:
 #include <bitset>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
 #include <utility>
 
 // Includes from nestkernel:
@@ -40,6 +43,7 @@
 #include "connection_creator.h"
 #include "ntree.h"
 #include "position.h"
+#include "spatial_hash.h"
 
 namespace nest
 {
@@ -175,31 +179,18 @@ public:
   void set_node_collection( NodeCollectionPTR );
   NodeCollectionPTR get_node_collection();
 
-protected:
-  /**
-   * The NodeCollection to which the layer belongs
-   */
-  NodeCollectionPTR node_collection_;
-
-  /**
-   * Metadata for the layer for which we cache global position information
-   */
-  static NodeCollectionMetadataPTR cached_ntree_md_;
-
   /**
-   * Metadata for the layer for which we cache global position information
-   */
-  static NodeCollectionMetadataPTR cached_vector_md_;
-
-  /**
-   * Clear the cache for global position information
+   * Remove the global position information of all layers from the caches.
+   *
+   * Called when the kernel is reset, as node IDs are reused afterwards.
    */
-  virtual void clear_ntree_cache_() const = 0;
+  static void clear_position_caches();
 
+protected:
   /**
-   * Clear the cache for global position information
+   * The NodeCollection to which the layer belongs
    */
-  virtual void clear_vector_cache_() const = 0;
+  NodeCollectionPTR node_collection_;
 
   /**
    * Gets metadata of the NodeCollection to which this layer belongs.
@@ -226,6 +217,11 @@ public:
 
   ~Layer() override;
 
+  /**
+   * Remove the global position information of all layers of dimension D from the cache.
+   */
+  static void clear_all_position_cache();
+
   /**
    * Change properties of the layer according to the
    * entries in the dictionary.
@@ -342,9 +338,8 @@ public:
    * Get positions for all nodes in layer, including nodes on other MPI processes.
    *
    * The positions will be cached so that subsequent calls for
-   * the same layer are fast. One one layer is cached at the time, so the
-   * user should group together all ConnectLayers calls using the same
-   * pool layer.
+   * the same layer are fast. The cache holds the most recently used
+   * layers, see position_cache_.
    */
   std::shared_ptr< Ntree< D, size_t > > get_global_positions_ntree( NodeCollectionPTR node_collection );
 
@@ -360,7 +355,31 @@ public:
     Position< D > extent,
     NodeCollectionPTR node_collection );
 
-  std::vector< std::pair< Position< D >, size_t > >* get_global_positions_vector( NodeCollectionPTR node_collection );
+  /**
+   * Get an ntree holding only the positions of nodes inside the given region.
+   *
+   * Positions are gathered only from nodes inside the region, which may
+   * differ between MPI processes. The ntree is split as if it held the
+   * positions of all nodes, so masks applied inside the region find the
+   * same nodes in the same order as with get_global_positions_ntree().
+   * Must be called on all MPI processes. The positions are not cached.
+   *
+   * @param periodic        periodic flags, see get_global_positions_ntree()
+   * @param lower_left      lower left corner, see get_global_positions_ntree()
+   * @param extent          extent, see get_global_positions_ntree()
+   * @param node_collection NodeCollection of the layer
+   * @param region          box containing the positions to gather; with
+   *                        periodic b.c., positions with a periodic image
+   *                        inside the box are gathered as well
+   */
+  std::shared_ptr< Ntree< D, size_t > > get_region_positions_ntree( std::bitset< D > periodic,
+    Position< D > lower_left,
+    Position< D > extent,
+    NodeCollectionPTR node_collection,
+    const Box< D >& region );
+
+  std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > > get_global_positions_vector(
+    NodeCollectionPTR node_collection );
 
   virtual std::vector< std::pair< Position< D >, size_t > > get_global_positions_vector( const MaskDatum& mask,
     const Position< D >& anchor,
@@ -418,21 +437,38 @@ public:
 
 protected:
   /**
-   * Clear the cache for global position information
+   * Global position information of a layer, for the given periodic flags and extent of the ntree.
    */
-  void clear_ntree_cache_() const override;
+  struct PositionCacheEntry_
+  {
+    std::weak_ptr< NodeCollectionMetadata > metadata; //!< does not keep the layer alive
+    std::bitset< D > periodic;
+    Position< D > extent;
+    std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > > positions;
+    std::shared_ptr< Ntree< D, size_t > > ntree; //!< built on first use
+  };
 
   /**
-   * Clear the cache for global position information
+   * Box of positions, which with periodic b.c. also contains all periodic images of positions inside it.
    */
-  void clear_vector_cache_() const override;
+  struct Region_
+  {
+    Box< D > box;
+    std::bitset< D > periodic;
+    Position< D > extent; //!< period in periodic dimensions
 
-  std::shared_ptr< Ntree< D, size_t > > do_get_global_positions_ntree_( NodeCollectionPTR node_collection );
+    bool contains( const Position< D >& pos ) const;
+  };
 
   /**
-   * Insert global position info into ntree.
+   * Remove the entries of layers that no longer exist from the cache.
    */
-  virtual void insert_global_positions_ntree_( Ntree< D, size_t >& tree, NodeCollectionPTR node_collection ) = 0;
+  static void remove_expired_position_cache_entries_();
+
+  /**
+   * Insert a new entry at the front of the cache, removing the least recently used entries if the cache is full.
+   */
+  void add_position_cache_entry_( const PositionCacheEntry_& entry ) const;
 
   /**
    * Insert global position info into vector.
@@ -440,16 +476,38 @@ protected:
   virtual void insert_global_positions_vector_( std::vector< std::pair< Position< D >, size_t > >&,
     NodeCollectionPTR ) = 0;
 
+  /**
+   * Insert positions of all nodes inside the region into vector, in the
+   * same order as insert_global_positions_vector_().
+   *
+   * Must be called on all MPI processes, each with its own region.
+   *
+   * @param local_positions positions of the nodes on this MPI process, or of
+   *                        all nodes if the NodeCollection has no proxies
+   */
+  virtual void insert_region_positions_vector_( std::vector< std::pair< Position< D >, size_t > >& vec,
+    const std::vector< std::pair< Position< D >, size_t > >& local_positions,
+    const Region_& region,
+    NodeCollectionPTR node_collection ) = 0;
+
   //! lower left corner (minimum coordinates) of layer
   Position< D > lower_left_;
   Position< D > extent_;      //!< size of layer
   std::bitset< D > periodic_; //!< periodic b.c.
 
   /**
-   * Global position information for a single layer
+   * Global position information for the most recently used layers, most recent first.
+   *
+   * Connecting alternately between several layers thus does not gather
+   * positions and build ntrees anew for each call. All entries of a layer
+   * share the same position vector. The cache holds up to two entries per
+   * existing layer, so that each layer can have an ntree for its own
+   * boundary conditions and one for the boundary conditions of a mask.
    */
-  static std::shared_ptr< Ntree< D, size_t > > cached_ntree_;
-  static std::vector< std::pair< Position< D >, size_t > >* cached_vector_;
+  static std::list< PositionCacheEntry_ > position_cache_;
+
+  //! Number of existing layers of dimension D, limits the size of position_cache_
+  static size_t num_layers_;
 
   friend class MaskedLayer< D >;
 };
@@ -491,6 +549,28 @@ public:
     Layer< D >& target,
     NodeCollectionPTR node_collection );
 
+  /**
+   * Constructors gathering only nodes that can be inside the mask for
+   * anchors in the given box, see Layer::get_region_positions_ntree().
+   *
+   * The mask may only be applied to anchors inside anchor_box. Must be
+   * called on all MPI processes, each with its own anchor_box.
+   *
+   * @param anchor_box Box containing all anchors the mask will be applied to
+   */
+  MaskedLayer( Layer< D >& layer,
+    const MaskDatum& mask,
+    bool allow_oversized,
+    NodeCollectionPTR node_collection,
+    const Box< D >& anchor_box );
+
+  MaskedLayer( Layer< D >& layer,
+    const MaskDatum& mask,
+    bool allow_oversized,
+    Layer< D >& target,
+    NodeCollectionPTR node_collection,
+    const Box< D >& anchor_box );
+
   ~MaskedLayer();
 
   /**
@@ -507,6 +587,17 @@ public:
    */
   typename Ntree< D, size_t >::masked_iterator end();
 
+  /**
+   * Append the nodes inside the mask centered on the anchor to a vector.
+   *
+   * Nodes are appended in the order of iterating from begin( anchor ) to
+   * end(), but are found with a spatial hash if the layer is suitable.
+   *
+   * @param anchor Position to apply mask to
+   * @param nodes vector to append nodes to
+   */
+  void get_nodes( const Position< D >& anchor, std::vector< std::pair< Position< D >, size_t > >& nodes );
+
 protected:
   /**
    * Will check that the mask can be applied to the layer.
@@ -521,7 +612,23 @@ protected:
    */
   void check_mask_( Layer< D >& layer, bool allow_oversized );
 
+  /**
+   * Create a spatial hash if the nodes are dense and uniform enough for it
+   * to be faster than the Ntree. For grid layers and axis-aligned box masks,
+   * a grid stencil is created instead.
+   *
+   * @param layer The layer to mask
+   */
+  void init_spatial_hash_( const Layer< D >& layer );
+
+  /**
+   * Box containing all positions inside the mask for anchors in anchor_box.
+   */
+  Box< D > get_region_( const Box< D >& anchor_box, const Layer< D >& layer ) const;
+
   std::shared_ptr< Ntree< D, size_t > > ntree_;
+  std::shared_ptr< SpatialHash< D, size_t > > spatial_hash_; //!< null if the Ntree is used
+  std::shared_ptr< GridStencil< D, size_t > > grid_stencil_; //!< null unless the spatial hash is a grid stencil
   MaskDatum mask_;
 };
 
@@ -548,6 +655,7 @@ inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
   ntree_ = layer.get_global_positions_ntree( node_collection );
 
   check_mask_( layer, allow_oversized );
+  init_spatial_hash_( layer );
 }
 
 template < int D >
@@ -563,6 +671,45 @@ inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
 
   check_mask_( target, allow_oversized );
   mask_ = new ConverseMask< D >( dynamic_cast< const Mask< D >& >( *mask_ ) );
+  init_spatial_hash_( layer );
+}
+
+template < int D >
+inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
+  const MaskDatum& maskd,
+  bool allow_oversized,
+  NodeCollectionPTR node_collection,
+  const Box< D >& anchor_box )
+  : mask_( maskd )
+{
+  check_mask_( layer, allow_oversized );
+  ntree_ = layer.get_region_positions_ntree( layer.get_periodic_mask(),
+    layer.get_lower_left(),
+    layer.get_extent(),
+    node_collection,
+    get_region_( anchor_box, layer ) );
+
+  init_spatial_hash_( layer );
+}
+
+template < int D >
+inline MaskedLayer< D >::MaskedLayer( Layer< D >& layer,
+  const MaskDatum& maskd,
+  bool allow_oversized,
+  Layer< D >& target,
+  NodeCollectionPTR node_collection,
+  const Box< D >& anchor_box )
+  : mask_( maskd )
+{
+  check_mask_( target, allow_oversized );
+  mask_ = new ConverseMask< D >( dynamic_cast< const Mask< D >& >( *mask_ ) );
+  ntree_ = layer.get_region_positions_ntree( target.get_periodic_mask(),
+    target.get_lower_left(),
+    target.get_extent(),
+    node_collection,
+    get_region_( anchor_box, target ) );
+
+  init_spatial_hash_( layer );
 }
 
 template < int D >
@@ -591,6 +738,29 @@ MaskedLayer< D >::end()
   return ntree_->masked_end();
 }
 
+template < int D >
+inline void
+MaskedLayer< D >::get_nodes( const Position< D >& anchor, std::vector< std::pair< Position< D >, size_t > >& nodes )
+{
+  if ( spatial_hash_ )
+  {
+    // The mask was checked when creating the spatial hash.
+    const Mask< D >& mask = static_cast< const Mask< D >& >( *mask_ );
+    if ( grid_stencil_ )
+    {
+      grid_stencil_->get_nodes( ntree_->get_anchors( mask, anchor ), nodes );
+    }
+    else
+    {
+      spatial_hash_->get_nodes( mask, ntree_->get_anchors( mask, anchor ), nodes );
+    }
+  }
+  else
+  {
+    std::copy( begin( anchor ), end(), std::back_inserter( nodes ) );
+  }
+}
+
 template < int D >
 inline Layer< D >::Layer()
 {
@@ -600,6 +770,7 @@ inline Layer< D >::Layer()
     lower_left_[ i ] = -0.5;
     extent_[ i ] = 1.0;
   }
+  ++num_layers_;
 }
 
 template < int D >
@@ -609,20 +780,15 @@ inline Layer< D >::Layer( const Layer& other_layer )
   , extent_( other_layer.extent_ )
   , periodic_( other_layer.periodic_ )
 {
+  ++num_layers_;
 }
 
 template < int D >
 inline Layer< D >::~Layer()
 {
-  if ( cached_ntree_md_ == get_metadata() )
-  {
-    clear_ntree_cache_();
-  }
-
-  if ( cached_vector_md_ == get_metadata() )
-  {
-    clear_vector_cache_();
-  }
+  --num_layers_;
+  // the metadata of the layer has expired when the layer is destroyed
+  remove_expired_position_cache_entries_();
 }
 
 template < int D >
@@ -675,22 +841,28 @@ Layer< D >::get_position_vector( const size_t sind ) const
 
 template < int D >
 inline void
-Layer< D >::clear_ntree_cache_() const
+Layer< D >::clear_all_position_cache()
+{
+  position_cache_.clear();
+}
+
+template < int D >
+inline void
+Layer< D >::remove_expired_position_cache_entries_()
 {
-  cached_ntree_ = std::shared_ptr< Ntree< D, size_t > >();
-  cached_ntree_md_ = NodeCollectionMetadataPTR( nullptr );
+  position_cache_.remove_if( []( const PositionCacheEntry_& entry ) { return entry.metadata.expired(); } );
 }
 
 template < int D >
 inline void
-Layer< D >::clear_vector_cache_() const
+Layer< D >::add_position_cache_entry_( const PositionCacheEntry_& entry ) const
 {
-  if ( cached_vector_ != 0 )
+  remove_expired_position_cache_entries_();
+  position_cache_.push_front( entry );
+  while ( position_cache_.size() > 2 * num_layers_ )
   {
-    delete cached_vector_;
+    position_cache_.pop_back();
   }
-  cached_vector_ = 0;
-  cached_vector_md_ = NodeCollectionMetadataPTR( nullptr );
 }
 
 } // namespace nest
@@ -25,6 +25,9 @@
 
 #include "layer.h"
 
+// C++ includes:
+#include <cmath>
+
 // Includes from nestkernel:
 #include "booldatum.h"
 #include "nest_datums.h"
@@ -33,15 +36,16 @@
 // Includes from spatial:
 #include "grid_layer.h"
 #include "grid_mask.h"
+#include "spatial_hash_impl.h"
 
 namespace nest
 {
 
 template < int D >
-std::shared_ptr< Ntree< D, size_t > > Layer< D >::cached_ntree_;
+std::list< typename Layer< D >::PositionCacheEntry_ > Layer< D >::position_cache_;
 
 template < int D >
-std::vector< std::pair< Position< D >, size_t > >* Layer< D >::cached_vector_ = 0;
+size_t Layer< D >::num_layers_ = 0;
 
 template < int D >
 Position< D >
@@ -134,18 +138,7 @@ template < int D >
 std::shared_ptr< Ntree< D, size_t > >
 Layer< D >::get_global_positions_ntree( NodeCollectionPTR node_collection )
 {
-  if ( cached_ntree_md_ == node_collection->get_metadata() )
-  {
-    assert( cached_ntree_.get() );
-    return cached_ntree_;
-  }
-
-  clear_ntree_cache_();
-
-  cached_ntree_ = std::shared_ptr< Ntree< D, size_t > >(
-    new Ntree< D, size_t >( this->lower_left_, this->extent_, this->periodic_ ) );
-
-  return do_get_global_positions_ntree_( node_collection );
+  return get_global_positions_ntree( this->periodic_, this->lower_left_, this->extent_, node_collection );
 }
 
 template < int D >
@@ -155,9 +148,6 @@ Layer< D >::get_global_positions_ntree( std::bitset< D > periodic,
   Position< D > extent,
   NodeCollectionPTR node_collection )
 {
-  clear_ntree_cache_();
-  clear_vector_cache_();
-
   // Keep layer geometry for non-periodic dimensions
   for ( int i = 0; i < D; ++i )
   {
@@ -168,83 +158,136 @@ Layer< D >::get_global_positions_ntree( std::bitset< D > periodic,
     }
   }
 
-  cached_ntree_ =
-    std::shared_ptr< Ntree< D, size_t > >( new Ntree< D, size_t >( this->lower_left_, extent, periodic ) );
+  // Ensures that the positions of the layer are cached.
+  const auto positions = get_global_positions_vector( node_collection );
+  const NodeCollectionMetadataPTR metadata = node_collection->get_metadata();
 
-  do_get_global_positions_ntree_( node_collection );
+  auto entry = position_cache_.begin();
+  while ( entry != position_cache_.end()
+    and not( entry->metadata.lock() == metadata and entry->periodic == periodic and entry->extent == extent ) )
+  {
+    ++entry;
+  }
+
+  if ( entry == position_cache_.end() )
+  {
+    add_position_cache_entry_( { metadata, periodic, extent, positions, nullptr } );
+    entry = position_cache_.begin();
+  }
+  else
+  {
+    position_cache_.splice( position_cache_.begin(), position_cache_, entry );
+  }
 
-  // Do not use cache since the periodic bits and extents were altered.
-  cached_ntree_md_ = NodeCollectionMetadataPTR( nullptr );
+  if ( not entry->ntree )
+  {
+    entry->ntree =
+      std::shared_ptr< Ntree< D, size_t > >( new Ntree< D, size_t >( this->lower_left_, extent, periodic ) );
+    entry->ntree->insert_bulk( *positions );
+  }
 
-  return cached_ntree_;
+  return entry->ntree;
 }
 
 template < int D >
 std::shared_ptr< Ntree< D, size_t > >
-Layer< D >::do_get_global_positions_ntree_( NodeCollectionPTR node_collection )
+Layer< D >::get_region_positions_ntree( std::bitset< D > periodic,
+  Position< D > lower_left,
+  Position< D > extent,
+  NodeCollectionPTR node_collection,
+  const Box< D >& region )
 {
-  if ( cached_vector_md_ == node_collection->get_metadata() )
+  // Keep layer geometry for non-periodic dimensions, as in get_global_positions_ntree()
+  for ( int i = 0; i < D; ++i )
   {
-    // Convert from vector to Ntree
-
-    typename std::insert_iterator< Ntree< D, size_t > > to = std::inserter( *cached_ntree_, cached_ntree_->end() );
-
-    for ( typename std::vector< std::pair< Position< D >, size_t > >::iterator from = cached_vector_->begin();
-          from != cached_vector_->end();
-          ++from )
+    if ( not periodic[ i ] )
     {
-      *to = *from;
+      extent[ i ] = extent_[ i ];
+      lower_left[ i ] = lower_left_[ i ];
     }
   }
-  else
-  {
 
-    insert_global_positions_ntree_( *cached_ntree_, node_collection );
+  // If the NodeCollection has proxies, each node is on a single MPI process.
+  // If not, all nodes are on all MPI processes.
+  const bool distributed = node_collection->has_proxies();
+  std::vector< std::pair< Position< D >, size_t > > local_positions;
+  for ( auto it = distributed ? node_collection->MPI_local_begin() : node_collection->begin();
+        it < node_collection->end();
+        ++it )
+  {
+    local_positions.push_back( std::make_pair( get_position( ( *it ).lid ), ( *it ).node_id ) );
   }
 
-  clear_vector_cache_();
+  std::vector< std::pair< Position< D >, size_t > > positions;
+  insert_region_positions_vector_( positions, local_positions, Region_ { region, periodic, extent }, node_collection );
 
-  cached_ntree_md_ = node_collection->get_metadata();
+  // The local positions of all MPI processes together determine where the ntree is split.
+  auto ntree = std::make_shared< Ntree< D, size_t > >( this->lower_left_, extent, periodic );
+  ntree->insert_bulk( positions,
+    local_positions,
+    [ distributed ]( std::vector< double >& counts )
+    {
+      if ( distributed )
+      {
+        kernel().mpi_manager.communicate_Allreduce_sum_in_place( counts );
+      }
+    } );
 
-  return cached_ntree_;
+  return ntree;
 }
 
 template < int D >
-std::vector< std::pair< Position< D >, size_t > >*
-Layer< D >::get_global_positions_vector( NodeCollectionPTR node_collection )
+bool
+Layer< D >::Region_::contains( const Position< D >& pos ) const
 {
-  if ( cached_vector_md_ == node_collection->get_metadata() )
+  for ( int i = 0; i < D; ++i )
   {
-    assert( cached_vector_ );
-    return cached_vector_;
-  }
+    const double width = box.upper_right[ i ] - box.lower_left[ i ];
+    if ( not( width >= 0 ) )
+    {
+      return false; // empty box
+    }
 
-  clear_vector_cache_();
+    if ( periodic[ i ] )
+    {
+      double offset = std::fmod( pos[ i ] - box.lower_left[ i ], extent[ i ] );
+      if ( offset < 0 )
+      {
+        offset += extent[ i ];
+      }
+      if ( offset > width )
+      {
+        return false;
+      }
+    }
+    else if ( pos[ i ] < box.lower_left[ i ] or pos[ i ] > box.upper_right[ i ] )
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-  cached_vector_ = new std::vector< std::pair< Position< D >, size_t > >;
+template < int D >
+std::shared_ptr< std::vector< std::pair< Position< D >, size_t > > >
+Layer< D >::get_global_positions_vector( NodeCollectionPTR node_collection )
+{
+  const NodeCollectionMetadataPTR metadata = node_collection->get_metadata();
 
-  if ( cached_ntree_md_ == node_collection->get_metadata() )
+  for ( auto entry = position_cache_.begin(); entry != position_cache_.end(); ++entry )
   {
-    // Convert from NTree to vector
-
-    typename std::back_insert_iterator< std::vector< std::pair< Position< D >, size_t > > > to =
-      std::back_inserter( *cached_vector_ );
-
-    for ( typename Ntree< D, size_t >::iterator from = cached_ntree_->begin(); from != cached_ntree_->end(); ++from )
+    if ( entry->metadata.lock() == metadata )
     {
-      *to = *from;
+      position_cache_.splice( position_cache_.begin(), position_cache_, entry );
+      return entry->positions;
     }
   }
-  else
-  {
-    insert_global_positions_vector_( *cached_vector_, node_collection );
-  }
-
-  clear_ntree_cache_();
 
-  cached_vector_md_ = node_collection->get_metadata();
+  auto positions = std::make_shared< std::vector< std::pair< Position< D >, size_t > > >();
+  insert_global_positions_vector_( *positions, node_collection );
+  add_position_cache_entry_( { metadata, this->periodic_, this->extent_, positions, nullptr } );
 
-  return cached_vector_;
+  return positions;
 }
 
 template < int D >
@@ -303,7 +346,7 @@ Layer< D >::dump_connections( std::ostream& out,
   AbstractLayerPTR target_layer,
   const Token& syn_model )
 {
-  std::vector< std::pair< Position< D >, size_t > >* src_vec = get_global_positions_vector( node_collection );
+  const auto src_vec = get_global_positions_vector( node_collection );
 
   // Dictionary with parameters for get_connections()
   DictionaryDatum conn_filter( new Dictionary );
@@ -436,6 +479,103 @@ MaskedLayer< D >::check_mask_( Layer< D >& layer, bool allow_oversized )
   }
 }
 
+template < int D >
+Box< D >
+MaskedLayer< D >::get_region_( const Box< D >& anchor_box, const Layer< D >& layer ) const
+{
+  for ( int i = 0; i < D; ++i )
+  {
+    if ( not( anchor_box.lower_left[ i ] <= anchor_box.upper_right[ i ] ) )
+    {
+      return anchor_box; // no anchors
+    }
+  }
+
+  const Box< D > bbox = dynamic_cast< const Mask< D >& >( *mask_ ).get_bbox();
+  Box< D > region( anchor_box.lower_left + bbox.lower_left, anchor_box.upper_right + bbox.upper_right );
+
+  // Widen the region slightly, so that positions on the border of the mask
+  // are included despite round-off errors.
+  for ( int i = 0; i < D; ++i )
+  {
+    const double margin =
+      1e-12 * ( std::abs( region.lower_left[ i ] ) + std::abs( region.upper_right[ i ] ) + layer.get_extent()[ i ] );
+    region.lower_left[ i ] -= margin;
+    region.upper_right[ i ] += margin;
+  }
+
+  return region;
+}
+
+template < int D >
+void
+MaskedLayer< D >::init_spatial_hash_( const Layer< D >& layer )
+{
+  // Below this number of nodes, building the spatial hash does not pay off.
+  const size_t min_num_nodes = 1000;
+  // Largest allowed ratio of nodes in the fullest cell to nodes per cell on average.
+  const size_t max_cell_size_ratio = 4;
+
+  const Mask< D >* const mask = dynamic_cast< const Mask< D >* >( mask_.get() );
+  if ( not mask )
+  {
+    return; // begin() reports the incompatible mask
+  }
+
+  // Cells much smaller than the mask, so that most nodes are in cells entirely inside the mask. The spatial
+  // hash makes cells larger if they would split leaves of the Ntree.
+  const Box< D > mask_bb = mask->get_bbox();
+  Position< D > cell_size;
+  for ( int i = 0; i < D; ++i )
+  {
+    cell_size[ i ] = 0.125 * ( mask_bb.upper_right[ i ] - mask_bb.lower_left[ i ] );
+    if ( not std::isfinite( cell_size[ i ] ) or cell_size[ i ] <= 0 or cell_size[ i ] >= ntree_->get_extent()[ i ] )
+    {
+      return;
+    }
+  }
+
+  std::shared_ptr< SpatialHash< D, size_t > > spatial_hash;
+  std::shared_ptr< GridStencil< D, size_t > > grid_stencil;
+  if ( dynamic_cast< const GridLayer< D >* >( &layer ) )
+  {
+    // Unwrap an axis-aligned box mask. Grid masks have been converted to box masks by check_mask_().
+    const Mask< D >* box_mask = mask;
+    const ConverseMask< D >* const converse_mask = dynamic_cast< const ConverseMask< D >* >( box_mask );
+    if ( converse_mask )
+    {
+      box_mask = &converse_mask->get_mask();
+    }
+    Position< D > mask_anchor;
+    const AnchoredMask< D >* const anchored_mask = dynamic_cast< const AnchoredMask< D >* >( box_mask );
+    if ( anchored_mask )
+    {
+      mask_anchor = anchored_mask->get_anchor();
+      box_mask = &anchored_mask->get_mask();
+    }
+    const BoxMask< D >* const box = dynamic_cast< const BoxMask< D >* >( box_mask );
+    if ( box and not box->is_rotated() )
+    {
+      grid_stencil = std::make_shared< GridStencil< D, size_t > >(
+        *ntree_, cell_size, box->get_lower_left(), box->get_upper_right(), mask_anchor, converse_mask != nullptr );
+      spatial_hash = grid_stencil;
+    }
+  }
+  if ( not spatial_hash )
+  {
+    spatial_hash = std::make_shared< SpatialHash< D, size_t > >( *ntree_, cell_size );
+  }
+
+  const size_t num_nodes = spatial_hash->size();
+  const size_t num_cells = spatial_hash->get_num_cells();
+  if ( num_nodes >= min_num_nodes and num_cells <= num_nodes
+    and spatial_hash->get_max_cell_size() * num_cells <= max_cell_size_ratio * num_nodes )
+  {
+    spatial_hash_ = spatial_hash;
+    grid_stencil_ = grid_stencil;
+  }
+}
+
 } // namespace nest
 
 #endif
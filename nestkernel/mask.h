@@ -257,6 +257,27 @@ public:
    */
   static Name get_name();
 
+  const Position< D >&
+  get_lower_left() const
+  {
+    return lower_left_;
+  }
+
+  const Position< D >&
+  get_upper_right() const
+  {
+    return upper_right_;
+  }
+
+  /**
+   * @returns true if the box is rotated by an azimuth or polar angle.
+   */
+  bool
+  is_rotated() const
+  {
+    return is_rotated_;
+  }
+
 protected:
   /**
    *  Calculate the min/max x, y, z values in case of a rotated box.
@@ -666,6 +687,12 @@ public:
 
   Mask< D >* clone() const;
 
+  const Mask< D >&
+  get_mask() const
+  {
+    return *m_;
+  }
+
 protected:
   Mask< D >* m_;
 };
@@ -714,6 +741,18 @@ public:
 
   Mask< D >* clone() const;
 
+  const Mask< D >&
+  get_mask() const
+  {
+    return *m_;
+  }
+
+  const Position< D >&
+  get_anchor() const
+  {
+    return anchor_;
+  }
+
 protected:
   Mask< D >* m_;
   Position< D > anchor_;
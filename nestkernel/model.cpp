@@ -24,6 +24,7 @@
 
 // C++ includes:
 #include <algorithm>
+#include <cstddef>
 
 // Includes from libnestutil:
 #include "compose.hpp"
@@ -48,36 +49,40 @@ Model::Model( const std::string& name )
 void
 Model::set_threads()
 {
-  set_threads_( kernel().vp_manager.get_num_threads() );
+  set_threads_( kernel().vp_manager.get_num_threads(), kernel().model_manager.get_node_alignment() );
 }
 
 void
-Model::set_threads_( size_t t )
+Model::set_threads_( size_t t, size_t alignment )
 {
   for ( size_t i = 0; i < memory_.size(); ++i )
   {
-    if ( memory_[ i ].size() > 0 )
+    if ( memory_[ i ].get_instantiations() > 0 )
     {
       throw KernelException();
     }
   }
 
-  memory_.resize( t );
-  memory_.shrink_to_fit();
+  // pools cannot be moved, so we replace them by new ones
+  std::vector< sli::pool >( t ).swap( memory_ );
+  for ( auto& pool : memory_ )
+  {
+    pool.init( get_element_size(), 1000, 1, alignment );
+  }
 }
 
 void
 Model::reserve_additional( size_t t, size_t n )
 {
   assert( t < memory_.size() );
-  memory_[ t ].reserve( n );
+  memory_[ t ].reserve_additional( n );
 }
 
 void
 Model::clear()
 {
   memory_.clear();
-  set_threads_( 1 );
+  set_threads_( 1, alignof( std::max_align_t ) );
 }
 
 size_t
@@ -86,7 +91,7 @@ Model::mem_available()
   size_t result = 0;
   for ( size_t t = 0; t < memory_.size(); ++t )
   {
-    result += memory_[ t ].capacity() - memory_[ t ].size();
+    result += memory_[ t ].available();
   }
 
   return result;
@@ -98,7 +103,19 @@ Model::mem_capacity()
   size_t result = 0;
   for ( size_t t = 0; t < memory_.size(); ++t )
   {
-    result += memory_[ t ].capacity();
+    result += memory_[ t ].get_total();
+  }
+
+  return result;
+}
+
+size_t
+Model::mem_allocated()
+{
+  size_t result = 0;
+  for ( size_t t = 0; t < memory_.size(); ++t )
+  {
+    result += memory_[ t ].get_total() * memory_[ t ].get_el_size();
   }
 
   return result;
@@ -125,7 +142,7 @@ Model::get_status()
   std::vector< long > tmp( memory_.size() );
   for ( size_t t = 0; t < tmp.size(); ++t )
   {
-    tmp[ t ] = memory_[ t ].size();
+    tmp[ t ] = memory_[ t ].get_instantiations();
   }
 
   ( *d )[ names::instantiations ] = Token( tmp );
@@ -133,14 +150,14 @@ Model::get_status()
 
   for ( size_t t = 0; t < tmp.size(); ++t )
   {
-    tmp[ t ] = memory_[ t ].capacity();
+    tmp[ t ] = memory_[ t ].get_total();
   }
 
   ( *d )[ names::capacity ] = Token( tmp );
 
   for ( size_t t = 0; t < tmp.size(); ++t )
   {
-    tmp[ t ] = memory_[ t ].capacity() - memory_[ t ].size();
+    tmp[ t ] = memory_[ t ].available();
   }
 
   ( *d )[ names::available ] = Token( tmp );
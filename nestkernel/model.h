@@ -28,7 +28,7 @@
 #include <string>
 #include <vector>
 
-// Includes from libnestutil:
+// Includes from sli:
 #include "allocator.h"
 
 // Includes from nestkernel:
@@ -49,6 +49,9 @@ class TimeConverter;
  * wide parametrisation of its associated Node objects.
  *
  * class Model manages the thread-sorted memory pool of the model.
+ * Nodes of one model created on one thread are placed back to back in
+ * the pool of the thread, which grows in large chunks. Pools are filled
+ * by the thread owning them, so memory is first touched by that thread.
  * The default constructor uses one thread as default. Use set_threads() to
  * use more than one thread.
  * @ingroup user_interface
@@ -93,7 +96,14 @@ public:
   Node* create( size_t t );
 
   /**
-   * Deletes all nodes which belong to this model.
+   * Destruct Node created by create() on thread t and return its memory to the pool.
+   */
+  void destroy( size_t t, Node* n );
+
+  /**
+   * Release the memory of all nodes which belong to this model.
+   *
+   * Nodes still alive are not destructed.
    */
 
   void clear();
@@ -130,6 +140,13 @@ public:
    */
   size_t mem_capacity();
 
+  /**
+   * Return the memory allocated for nodes in bytes, including padding for alignment.
+   *
+   * Note that this function reports a sum over all threads.
+   */
+  size_t mem_allocated();
+
   virtual bool has_proxies() = 0;
   virtual bool one_node_per_process() = 0;
   virtual bool is_off_grid() = 0;
@@ -220,15 +237,15 @@ private:
 
 
   /**
-   * Set the number of threads.
+   * Set the number of threads and the alignment of nodes in bytes.
    * @see set_threads()
    */
-  void set_threads_( size_t t );
+  void set_threads_( size_t t, size_t alignment );
 
   /**
-   * Create a new object.
+   * Create a new object at the given address.
    */
-  virtual Node* create_() = 0;
+  virtual Node* create_( void* ) = 0;
 
   /**
    * Name of the Model.
@@ -250,7 +267,7 @@ private:
   /**
    * Memory for all nodes sorted by threads.
    */
-  std::vector< std::vector< Node* > > memory_;
+  std::vector< sli::pool > memory_;
 };
 
 
@@ -258,9 +275,17 @@ inline Node*
 Model::create( size_t t )
 {
   assert( t < memory_.size() );
-  Node* n = create_();
-  memory_[ t ].emplace_back( n );
-  return n;
+  return create_( memory_[ t ].alloc() );
+}
+
+inline void
+Model::destroy( size_t t, Node* n )
+{
+  assert( t < memory_.size() );
+  // the complete object may not start at the Node base
+  void* adr = dynamic_cast< void* >( n );
+  n->~Node();
+  memory_[ t ].free( adr );
 }
 
 inline std::string
@@ -53,6 +53,7 @@ ModelManager::ModelManager()
   , proxynode_model_( nullptr )
   , proxy_nodes_()
   , model_defaults_modified_( false )
+  , align_nodes_to_cache_lines_( false )
 {
 }
 
@@ -63,8 +64,13 @@ ModelManager::~ModelManager()
 }
 
 void
-ModelManager::initialize( const bool )
+ModelManager::initialize( const bool adjust_number_of_threads_or_rng_only )
 {
+  if ( not adjust_number_of_threads_or_rng_only )
+  {
+    align_nodes_to_cache_lines_ = false;
+  }
+
   if ( not proxynode_model_ )
   {
     proxynode_model_ = new GenericModel< proxynode >( "proxynode", "" );
@@ -108,8 +114,28 @@ ModelManager::get_num_connection_models() const
 }
 
 void
-ModelManager::set_status( const DictionaryDatum& )
+ModelManager::set_status( const DictionaryDatum& d )
 {
+  bool align_nodes_to_cache_lines = align_nodes_to_cache_lines_;
+  updateValue< bool >( d, names::align_nodes_to_cache_lines, align_nodes_to_cache_lines );
+  if ( align_nodes_to_cache_lines != align_nodes_to_cache_lines_ )
+  {
+    if ( kernel().node_manager.size() > 0 )
+    {
+      throw KernelException( "Alignment of nodes cannot be changed after nodes have been created." );
+    }
+
+    align_nodes_to_cache_lines_ = align_nodes_to_cache_lines;
+
+    // memory pools of proxy nodes are not affected, proxy nodes are never updated
+    for ( auto node_model : node_models_ )
+    {
+      if ( node_model )
+      {
+        node_model->set_threads();
+      }
+    }
+  }
 }
 
 void
@@ -131,6 +157,46 @@ ModelManager::get_status( DictionaryDatum& dict )
 
   // syn_ids start at 0, so the maximal number of syn models is MAX_SYN_ID + 1
   def< int >( dict, names::max_num_syn_models, MAX_SYN_ID + 1 );
+
+  DictionaryDatum bytes_per_synapse( new Dictionary );
+  if ( not connection_models_.empty() )
+  {
+    for ( auto const cm : connection_models_[ 0 ] )
+    {
+      def< long >( bytes_per_synapse, cm->get_name(), cm->get_connection_size() );
+    }
+  }
+  def< DictionaryDatum >( dict, names::bytes_per_synapse, bytes_per_synapse );
+
+  def< bool >( dict, names::align_nodes_to_cache_lines, align_nodes_to_cache_lines_ );
+
+  // memory pools of all node models including proxy nodes, summed over threads
+  size_t capacity = 0;
+  size_t available = 0;
+  size_t bytes = 0;
+  for ( auto node_model : node_models_ )
+  {
+    if ( node_model )
+    {
+      capacity += node_model->mem_capacity();
+      available += node_model->mem_available();
+      bytes += node_model->mem_allocated();
+    }
+  }
+  if ( proxynode_model_ )
+  {
+    capacity += proxynode_model_->mem_capacity();
+    available += proxynode_model_->mem_available();
+    bytes += proxynode_model_->mem_allocated();
+  }
+
+  DictionaryDatum node_memory( new Dictionary );
+  def< long >( node_memory, names::instantiations, capacity - available );
+  def< long >( node_memory, names::capacity, capacity );
+  def< long >( node_memory, names::available, available );
+  def< long >( node_memory, names::bytes, bytes );
+  def< long >( node_memory, names::alignment, get_node_alignment() );
+  def< DictionaryDatum >( dict, names::node_memory, node_memory );
 }
 
 void
@@ -193,6 +259,7 @@ ModelManager::copy_node_model_( const size_t old_id, Name new_name, DictionaryDa
   Model* new_model = old_model->clone( new_name.toString() );
   const size_t new_id = node_models_.size();
   new_model->set_model_id( new_id );
+  new_model->set_threads();
 
   node_models_.push_back( new_model );
   modeldict_->insert( new_name, new_id );
@@ -370,6 +437,14 @@ ModelManager::clear_node_models_()
     }
   }
 
+  for ( size_t t = 0; t < proxy_nodes_.size(); ++t )
+  {
+    for ( auto proxy : proxy_nodes_[ t ] )
+    {
+      proxynode_model_->destroy( t, proxy );
+    }
+  }
+
   delete proxynode_model_;
   proxynode_model_ = nullptr;
 
@@ -24,6 +24,7 @@
 #define MODEL_MANAGER_H
 
 // C++ includes:
+#include <cstddef>
 #include <string>
 
 // Includes from nestkernel:
@@ -174,6 +175,11 @@ public:
    */
   void memory_info() const;
 
+  /**
+   * Return alignment of nodes in memory in bytes.
+   */
+  size_t get_node_alignment() const;
+
   SecondaryEvent& get_secondary_event_prototype( const synindex syn_id, const size_t tid );
 
 private:
@@ -281,6 +287,11 @@ private:
   std::vector< std::vector< Node* > > proxy_nodes_;
   //! True if any model defaults have been modified
   bool model_defaults_modified_;
+  //! True if nodes are aligned to cache lines in memory
+  bool align_nodes_to_cache_lines_;
+
+  //! Size of cache lines assumed for aligning nodes
+  static constexpr size_t cache_line_size_ = 64;
 };
 
 
@@ -297,6 +308,12 @@ ModelManager::are_model_defaults_modified() const
   return model_defaults_modified_;
 }
 
+inline size_t
+ModelManager::get_node_alignment() const
+{
+  return align_nodes_to_cache_lines_ ? cache_line_size_ : alignof( std::max_align_t );
+}
+
 inline ConnectorModel&
 ModelManager::get_connection_model( synindex syn_id, size_t thread_id )
 {
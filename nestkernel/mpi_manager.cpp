@@ -71,6 +71,8 @@ nest::MPIManager::MPIManager()
   , COMM_OVERFLOW_ERROR( std::numeric_limits< unsigned int >::max() )
   , comm( 0 )
   , MPI_OFFGRID_SPIKE( 0 )
+  , spike_data_request_( MPI_REQUEST_NULL )
+  , spike_data_neighbor_comm_( MPI_COMM_NULL )
 #endif
 {
 }
@@ -218,6 +220,14 @@ nest::MPIManager::initialize( const bool adjust_number_of_threads_or_rng_only )
 void
 nest::MPIManager::finalize( const bool )
 {
+#ifdef HAVE_MPI
+  if ( spike_data_neighbor_comm_ != MPI_COMM_NULL )
+  {
+    MPI_Comm_free( &spike_data_neighbor_comm_ );
+  }
+  spike_data_sources_.clear();
+  spike_data_targets_.clear();
+#endif
 }
 
 void
@@ -739,6 +749,33 @@ nest::MPIManager::communicate_Allreduce_sum( std::vector< double >& send_buffer,
   MPI_Allreduce( &send_buffer[ 0 ], &recv_buffer[ 0 ], send_buffer.size(), MPI_Type< double >::type, MPI_SUM, comm );
 }
 
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< double >& send_buffer,
+  const std::vector< int >& send_counts,
+  std::vector< double >& recv_buffer )
+{
+  assert( send_counts.size() == static_cast< size_t >( get_num_processes() ) );
+
+  std::vector< int > recv_counts( get_num_processes() );
+  MPI_Alltoall( &send_counts[ 0 ], 1, MPI_INT, &recv_counts[ 0 ], 1, MPI_INT, comm );
+
+  std::vector< int > send_displacements( get_num_processes(), 0 );
+  std::vector< int > recv_displacements( get_num_processes(), 0 );
+  std::partial_sum( send_counts.begin(), send_counts.end() - 1, send_displacements.begin() + 1 );
+  std::partial_sum( recv_counts.begin(), recv_counts.end() - 1, recv_displacements.begin() + 1 );
+
+  recv_buffer.resize( recv_displacements.back() + recv_counts.back() );
+  MPI_Alltoallv( send_buffer.data(),
+    &send_counts[ 0 ],
+    &send_displacements[ 0 ],
+    MPI_DOUBLE,
+    recv_buffer.data(),
+    &recv_counts[ 0 ],
+    &recv_displacements[ 0 ],
+    MPI_DOUBLE,
+    comm );
+}
+
 bool
 nest::MPIManager::equal_cross_ranks( const double value )
 {
@@ -764,6 +801,170 @@ nest::MPIManager::communicate_Alltoall_( void* send_buffer, void* recv_buffer, c
   MPI_Alltoall( send_buffer, send_recv_count, MPI_UNSIGNED, recv_buffer, send_recv_count, MPI_UNSIGNED, comm );
 }
 
+void
+nest::MPIManager::communicate_Ialltoall_( void* send_buffer, void* recv_buffer, const unsigned int send_recv_count )
+{
+  MPI_Ialltoall(
+    send_buffer, send_recv_count, MPI_UNSIGNED, recv_buffer, send_recv_count, MPI_UNSIGNED, comm, &spike_data_request_ );
+}
+
+void
+nest::MPIManager::wait_spike_data_Ialltoall()
+{
+  MPI_Wait( &spike_data_request_, MPI_STATUS_IGNORE );
+}
+
+void
+nest::MPIManager::set_spike_data_neighbors( const std::vector< bool >& is_target_rank )
+{
+  assert( is_target_rank.size() == static_cast< size_t >( get_num_processes() ) );
+
+  // Every rank tells every other rank whether it will send spikes to it.
+  std::vector< int > send_flags( get_num_processes() );
+  std::vector< int > recv_flags( get_num_processes() );
+  std::copy( is_target_rank.begin(), is_target_rank.end(), send_flags.begin() );
+  MPI_Alltoall( &send_flags[ 0 ], 1, MPI_INT, &recv_flags[ 0 ], 1, MPI_INT, comm );
+
+  spike_data_targets_.clear();
+  spike_data_sources_.clear();
+  for ( int rank = 0; rank < get_num_processes(); ++rank )
+  {
+    if ( send_flags[ rank ] )
+    {
+      spike_data_targets_.push_back( rank );
+    }
+    if ( recv_flags[ rank ] )
+    {
+      spike_data_sources_.push_back( rank );
+    }
+  }
+
+  if ( spike_data_neighbor_comm_ != MPI_COMM_NULL )
+  {
+    MPI_Comm_free( &spike_data_neighbor_comm_ );
+  }
+
+  // Ranks must not be reordered, since spikes are addressed by rank in the global communicator.
+  MPI_Dist_graph_create_adjacent( comm,
+    spike_data_sources_.size(),
+    spike_data_sources_.data(),
+    MPI_UNWEIGHTED,
+    spike_data_targets_.size(),
+    spike_data_targets_.data(),
+    MPI_UNWEIGHTED,
+    MPI_INFO_NULL,
+    0,
+    &spike_data_neighbor_comm_ );
+}
+
+void
+nest::MPIManager::communicate_spike_data_counts_( const std::vector< size_t >& send_counts,
+  std::vector< size_t >& recv_counts,
+  const bool neighbors_only )
+{
+  recv_counts.assign( get_num_processes(), 0 );
+
+  if ( neighbors_only )
+  {
+    send_counts_spike_data_in_int_.resize( spike_data_targets_.size() );
+    recv_counts_spike_data_in_int_.resize( spike_data_sources_.size() );
+    for ( size_t i = 0; i < spike_data_targets_.size(); ++i )
+    {
+      send_counts_spike_data_in_int_[ i ] = send_counts[ spike_data_targets_[ i ] ];
+    }
+
+    MPI_Neighbor_alltoall( send_counts_spike_data_in_int_.data(),
+      1,
+      MPI_INT,
+      recv_counts_spike_data_in_int_.data(),
+      1,
+      MPI_INT,
+      spike_data_neighbor_comm_ );
+
+    for ( size_t i = 0; i < spike_data_sources_.size(); ++i )
+    {
+      recv_counts[ spike_data_sources_[ i ] ] = recv_counts_spike_data_in_int_[ i ];
+    }
+  }
+  else
+  {
+    send_counts_spike_data_in_int_.assign( send_counts.begin(), send_counts.end() );
+    recv_counts_spike_data_in_int_.resize( get_num_processes() );
+
+    MPI_Alltoall(
+      &send_counts_spike_data_in_int_[ 0 ], 1, MPI_INT, &recv_counts_spike_data_in_int_[ 0 ], 1, MPI_INT, comm );
+
+    recv_counts.assign( recv_counts_spike_data_in_int_.begin(), recv_counts_spike_data_in_int_.end() );
+  }
+}
+
+void
+nest::MPIManager::communicate_spike_data_Alltoallv_( void* send_buffer,
+  void* recv_buffer,
+  const std::vector< size_t >& send_counts,
+  const std::vector< size_t >& recv_counts,
+  const size_t element_size_in_int,
+  const bool neighbors_only )
+{
+  const size_t num_processes = get_num_processes();
+  send_counts_spike_data_in_int_.resize( num_processes );
+  send_displacements_spike_data_in_int_.resize( num_processes );
+  recv_counts_spike_data_in_int_.resize( num_processes );
+  recv_displacements_spike_data_in_int_.resize( num_processes );
+
+  // Data for all ranks is stored in order of ranks in both buffers.
+  int send_displacement = 0;
+  int recv_displacement = 0;
+  for ( size_t rank = 0; rank < num_processes; ++rank )
+  {
+    send_counts_spike_data_in_int_[ rank ] = send_counts[ rank ] * element_size_in_int;
+    send_displacements_spike_data_in_int_[ rank ] = send_displacement;
+    send_displacement += send_counts_spike_data_in_int_[ rank ];
+
+    recv_counts_spike_data_in_int_[ rank ] = recv_counts[ rank ] * element_size_in_int;
+    recv_displacements_spike_data_in_int_[ rank ] = recv_displacement;
+    recv_displacement += recv_counts_spike_data_in_int_[ rank ];
+  }
+
+  if ( neighbors_only )
+  {
+    // Compact to entries for neighbours. Neighbours are sorted by rank, so entry i is moved to position
+    // at most i and we can do this in place.
+    for ( size_t i = 0; i < spike_data_targets_.size(); ++i )
+    {
+      send_counts_spike_data_in_int_[ i ] = send_counts_spike_data_in_int_[ spike_data_targets_[ i ] ];
+      send_displacements_spike_data_in_int_[ i ] = send_displacements_spike_data_in_int_[ spike_data_targets_[ i ] ];
+    }
+    for ( size_t i = 0; i < spike_data_sources_.size(); ++i )
+    {
+      recv_counts_spike_data_in_int_[ i ] = recv_counts_spike_data_in_int_[ spike_data_sources_[ i ] ];
+      recv_displacements_spike_data_in_int_[ i ] = recv_displacements_spike_data_in_int_[ spike_data_sources_[ i ] ];
+    }
+
+    MPI_Neighbor_alltoallv( send_buffer,
+      &send_counts_spike_data_in_int_[ 0 ],
+      &send_displacements_spike_data_in_int_[ 0 ],
+      MPI_UNSIGNED,
+      recv_buffer,
+      &recv_counts_spike_data_in_int_[ 0 ],
+      &recv_displacements_spike_data_in_int_[ 0 ],
+      MPI_UNSIGNED,
+      spike_data_neighbor_comm_ );
+  }
+  else
+  {
+    MPI_Alltoallv( send_buffer,
+      &send_counts_spike_data_in_int_[ 0 ],
+      &send_displacements_spike_data_in_int_[ 0 ],
+      MPI_UNSIGNED,
+      recv_buffer,
+      &recv_counts_spike_data_in_int_[ 0 ],
+      &recv_displacements_spike_data_in_int_[ 0 ],
+      MPI_UNSIGNED,
+      comm );
+  }
+}
+
 void
 nest::MPIManager::communicate_Alltoallv_( void* send_buffer,
   const int* send_counts,
@@ -1085,6 +1286,15 @@ nest::MPIManager::communicate_Allreduce_sum( std::vector< double >& send_buffer,
   recv_buffer.swap( send_buffer );
 }
 
+void
+nest::MPIManager::communicate_Alltoallv( std::vector< double >& send_buffer,
+  const std::vector< int >& send_counts,
+  std::vector< double >& recv_buffer )
+{
+  assert( send_counts.size() == 1 and static_cast< size_t >( send_counts[ 0 ] ) == send_buffer.size() );
+  recv_buffer.swap( send_buffer );
+}
+
 bool
 nest::MPIManager::equal_cross_ranks( const double )
 {
@@ -1102,4 +1312,16 @@ nest::MPIManager::communicate_recv_counts_secondary_events()
   send_displacements_secondary_events_in_int_per_rank_[ 0 ] = 0;
 }
 
+void
+nest::MPIManager::wait_spike_data_Ialltoall()
+{
+  // communicate_Ialltoall() has completed the exchange already
+}
+
+void
+nest::MPIManager::set_spike_data_neighbors( const std::vector< bool >& )
+{
+  // the only rank is its own neighbour
+}
+
 #endif /* #ifdef HAVE_MPI  */
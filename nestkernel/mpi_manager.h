@@ -164,6 +164,15 @@ public:
   void communicate_Allreduce_sum_in_place( std::vector< int >& buffer );
   void communicate_Allreduce_sum( std::vector< double >& send_buffer, std::vector< double >& recv_buffer );
 
+  /**
+   * Send send_counts[ r ] consecutive values of send_buffer to rank r, for
+   * all ranks in order, and receive the values sent to this rank ordered by
+   * sending rank.
+   */
+  void communicate_Alltoallv( std::vector< double >& send_buffer,
+    const std::vector< int >& send_counts,
+    std::vector< double >& recv_buffer );
+
   /**
    * Equal across all ranks.
    *
@@ -211,6 +220,9 @@ public:
 
   void communicate_Alltoall_( void* send_buffer, void* recv_buffer, const unsigned int send_recv_count );
 
+  //! Start non-blocking Alltoall; complete it with wait_spike_data_Ialltoall().
+  void communicate_Ialltoall_( void* send_buffer, void* recv_buffer, const unsigned int send_recv_count );
+
   void communicate_Alltoallv_( void* send_buffer,
     const int* send_counts,
     const int* send_displacements,
@@ -233,6 +245,52 @@ public:
   template < class D >
   void communicate_secondary_events_Alltoallv( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
 
+  /**
+   * Start non-blocking exchange of spike data.
+   *
+   * Neither buffer may be accessed before wait_spike_data_Ialltoall() has returned.
+   */
+  template < class D >
+  void communicate_Ialltoall( std::vector< D >& send_buffer,
+    std::vector< D >& recv_buffer,
+    const unsigned int send_recv_count );
+  template < class D >
+  void communicate_spike_data_Ialltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
+  template < class D >
+  void communicate_off_grid_spike_data_Ialltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer );
+
+  //! Wait for completion of exchange started by communicate_(off_grid_)spike_data_Ialltoall().
+  void wait_spike_data_Ialltoall();
+
+  /**
+   * Exchange only the spikes actually present instead of fixed-size chunks.
+   *
+   * The spikes for each rank must be stored contiguously in the send buffer in order of ranks, send_counts
+   * holds the number of spikes for each rank. Counts are exchanged first. On return, the spikes received
+   * are stored contiguously in the receive buffer in order of ranks, recv_counts holds their number per rank.
+   */
+  template < class D >
+  void communicate_spike_data_Alltoallv( std::vector< D >& send_buffer,
+    std::vector< D >& recv_buffer,
+    const std::vector< size_t >& send_counts,
+    std::vector< size_t >& recv_counts );
+
+  /**
+   * As communicate_spike_data_Alltoallv(), but communicate only with neighbours set by set_spike_data_neighbors().
+   */
+  template < class D >
+  void communicate_spike_data_Neighbor_alltoallv( std::vector< D >& send_buffer,
+    std::vector< D >& recv_buffer,
+    const std::vector< size_t >& send_counts,
+    std::vector< size_t >& recv_counts );
+
+  /**
+   * Set ranks to which this rank sends spikes for communicate_spike_data_Neighbor_alltoallv().
+   *
+   * Ranks from which spikes are received are obtained by communication, so this must be called on all ranks.
+   */
+  void set_spike_data_neighbors( const std::vector< bool >& is_target_rank );
+
   /**
    * Ensure all processes have reached the same stage by waiting until all
    * processes have sent a dummy message to process 0.
@@ -311,6 +369,28 @@ public:
   void communicate_recv_counts_secondary_events();
 
 private:
+  template < class D >
+  void communicate_spike_data_Alltoallv_( std::vector< D >& send_buffer,
+    std::vector< D >& recv_buffer,
+    const std::vector< size_t >& send_counts,
+    std::vector< size_t >& recv_counts,
+    const bool neighbors_only );
+
+#ifdef HAVE_MPI
+  //! Exchange number of spikes sent to each rank, see communicate_spike_data_Alltoallv().
+  void communicate_spike_data_counts_( const std::vector< size_t >& send_counts,
+    std::vector< size_t >& recv_counts,
+    const bool neighbors_only );
+
+  //! Exchange spikes once counts are known; element_size_in_int is the size of one spike in ints.
+  void communicate_spike_data_Alltoallv_( void* send_buffer,
+    void* recv_buffer,
+    const std::vector< size_t >& send_counts,
+    const std::vector< size_t >& recv_counts,
+    const size_t element_size_in_int,
+    const bool neighbors_only );
+#endif
+
   int num_processes_;              //!< number of MPI processes
   int rank_;                       //!< rank of the MPI process
   int send_buffer_size_;           //!< expected size of send buffer
@@ -359,6 +439,21 @@ private:
   MPI_Comm comm;
   MPI_Datatype MPI_OFFGRID_SPIKE;
 
+  //! Request handle of pending non-blocking spike exchange.
+  MPI_Request spike_data_request_;
+
+  //! Distributed graph communicator connecting ranks that exchange spikes, see set_spike_data_neighbors().
+  MPI_Comm spike_data_neighbor_comm_;
+
+  std::vector< int > spike_data_sources_; //!< ranks from which spikes are received, in ascending order
+  std::vector< int > spike_data_targets_; //!< ranks to which spikes are sent, in ascending order
+
+  //! Send/recv counts and displacements (in ints) for variable size spike exchange, per rank or per neighbour.
+  std::vector< int > send_counts_spike_data_in_int_;
+  std::vector< int > send_displacements_spike_data_in_int_;
+  std::vector< int > recv_counts_spike_data_in_int_;
+  std::vector< int > recv_displacements_spike_data_in_int_;
+
   void communicate_Allgather( std::vector< unsigned int >& send_buffer,
     std::vector< unsigned int >& recv_buffer,
     std::vector< int >& displacements );
@@ -710,6 +805,18 @@ MPIManager::communicate_Alltoall( std::vector< D >& send_buffer,
   communicate_Alltoall_( send_buffer_int, recv_buffer_int, send_recv_count );
 }
 
+template < class D >
+void
+MPIManager::communicate_Ialltoall( std::vector< D >& send_buffer,
+  std::vector< D >& recv_buffer,
+  const unsigned int send_recv_count )
+{
+  void* send_buffer_int = static_cast< void* >( &send_buffer[ 0 ] );
+  void* recv_buffer_int = static_cast< void* >( &recv_buffer[ 0 ] );
+
+  communicate_Ialltoall_( send_buffer_int, recv_buffer_int, send_recv_count );
+}
+
 template < class D >
 void
 MPIManager::communicate_secondary_events_Alltoallv( std::vector< D >& send_buffer, std::vector< D >& recv_buffer )
@@ -735,6 +842,13 @@ MPIManager::MPIManager::communicate_Alltoall( std::vector< D >& send_buffer,
   recv_buffer.swap( send_buffer );
 }
 
+template < class D >
+void
+MPIManager::communicate_Ialltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer, const unsigned int )
+{
+  recv_buffer.swap( send_buffer );
+}
+
 template < class D >
 void
 MPIManager::communicate_secondary_events_Alltoallv( std::vector< D >& send_buffer, std::vector< D >& recv_buffer )
@@ -773,6 +887,89 @@ MPIManager::communicate_off_grid_spike_data_Alltoall( std::vector< D >& send_buf
 
   communicate_Alltoall( send_buffer, recv_buffer, send_recv_count_off_grid_spike_data_in_int_per_rank );
 }
+
+template < class D >
+void
+MPIManager::communicate_spike_data_Ialltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer )
+{
+  const size_t send_recv_count_spike_data_in_int_per_rank =
+    sizeof( SpikeData ) / sizeof( unsigned int ) * send_recv_count_spike_data_per_rank_;
+
+  communicate_Ialltoall( send_buffer, recv_buffer, send_recv_count_spike_data_in_int_per_rank );
+}
+
+template < class D >
+void
+MPIManager::communicate_off_grid_spike_data_Ialltoall( std::vector< D >& send_buffer, std::vector< D >& recv_buffer )
+{
+  const size_t send_recv_count_off_grid_spike_data_in_int_per_rank =
+    sizeof( OffGridSpikeData ) / sizeof( unsigned int ) * send_recv_count_spike_data_per_rank_;
+
+  communicate_Ialltoall( send_buffer, recv_buffer, send_recv_count_off_grid_spike_data_in_int_per_rank );
+}
+
+template < class D >
+void
+MPIManager::communicate_spike_data_Alltoallv( std::vector< D >& send_buffer,
+  std::vector< D >& recv_buffer,
+  const std::vector< size_t >& send_counts,
+  std::vector< size_t >& recv_counts )
+{
+  communicate_spike_data_Alltoallv_( send_buffer, recv_buffer, send_counts, recv_counts, false );
+}
+
+template < class D >
+void
+MPIManager::communicate_spike_data_Neighbor_alltoallv( std::vector< D >& send_buffer,
+  std::vector< D >& recv_buffer,
+  const std::vector< size_t >& send_counts,
+  std::vector< size_t >& recv_counts )
+{
+  communicate_spike_data_Alltoallv_( send_buffer, recv_buffer, send_counts, recv_counts, true );
+}
+
+#ifdef HAVE_MPI
+template < class D >
+void
+MPIManager::communicate_spike_data_Alltoallv_( std::vector< D >& send_buffer,
+  std::vector< D >& recv_buffer,
+  const std::vector< size_t >& send_counts,
+  std::vector< size_t >& recv_counts,
+  const bool neighbors_only )
+{
+  communicate_spike_data_counts_( send_counts, recv_counts, neighbors_only );
+
+  // Keep at least one element so that we can pass valid pointers to MPI.
+  const size_t num_spikes_received = std::accumulate( recv_counts.begin(), recv_counts.end(), 0UL );
+  if ( recv_buffer.size() < std::max( num_spikes_received, 1UL ) )
+  {
+    recv_buffer.resize( std::max( num_spikes_received, 1UL ) );
+  }
+  if ( send_buffer.empty() )
+  {
+    send_buffer.resize( 1 );
+  }
+
+  communicate_spike_data_Alltoallv_( static_cast< void* >( &send_buffer[ 0 ] ),
+    static_cast< void* >( &recv_buffer[ 0 ] ),
+    send_counts,
+    recv_counts,
+    sizeof( D ) / sizeof( unsigned int ),
+    neighbors_only );
+}
+#else  // HAVE_MPI
+template < class D >
+void
+MPIManager::communicate_spike_data_Alltoallv_( std::vector< D >& send_buffer,
+  std::vector< D >& recv_buffer,
+  const std::vector< size_t >& send_counts,
+  std::vector< size_t >& recv_counts,
+  const bool )
+{
+  recv_counts = send_counts;
+  recv_buffer.swap( send_buffer );
+}
+#endif /* HAVE_MPI */
 }
 
 #endif /* MPI_MANAGER_H */
@@ -28,10 +28,16 @@
 // Includes from nestkernel:
 #include "exceptions.h"
 #include "kernel_manager.h"
+#include "layer.h"
 #include "mpi_manager_impl.h"
+#include "network_snapshot.h"
 #include "parameter.h"
 
 // Includes from sli:
+#include "arraydatum.h"
+#include "dictutils.h"
+#include "doubledatum.h"
+#include "integerdatum.h"
 #include "sliexceptions.h"
 #include "token.h"
 
@@ -59,6 +65,7 @@ install_module( const std::string& )
 void
 reset_kernel()
 {
+  AbstractLayer::clear_position_caches();
   kernel().reset();
 }
 
@@ -277,6 +284,18 @@ cleanup()
   kernel().cleanup();
 }
 
+void
+save_network( const std::string& path )
+{
+  NetworkSnapshot::save( path );
+}
+
+void
+load_network( const std::string& path )
+{
+  NetworkSnapshot::load( path );
+}
+
 void
 copy_model( const Name& oldmodname, const Name& newmodname, const DictionaryDatum& dict )
 {
@@ -416,6 +435,179 @@ node_collection_array_index( const Datum* datum, const bool* array, unsigned lon
   return new NodeCollectionDatum( NodeCollection::create( node_ids ) );
 }
 
+Datum*
+create_node_collection( const std::string& model_name, const long n )
+{
+  if ( n <= 0 )
+  {
+    throw RangeCheck();
+  }
+  return new NodeCollectionDatum( create( model_name, n ) );
+}
+
+/**
+ * Collect values in an IntVectorDatum or DoubleVectorDatum if all are integers or doubles, respectively.
+ */
+static Token
+values_to_token( const TokenArray& values )
+{
+  bool all_integer = true;
+  bool all_double = true;
+  for ( const Token& value : values )
+  {
+    all_integer = all_integer and dynamic_cast< IntegerDatum* >( value.datum() );
+    all_double = all_double and dynamic_cast< DoubleDatum* >( value.datum() );
+  }
+
+  if ( all_integer )
+  {
+    IntVectorDatum result( new std::vector< long >() );
+    result->reserve( values.size() );
+    for ( const Token& value : values )
+    {
+      result->push_back( static_cast< IntegerDatum* >( value.datum() )->get() );
+    }
+    return result;
+  }
+  if ( all_double )
+  {
+    DoubleVectorDatum result( new std::vector< double >() );
+    result->reserve( values.size() );
+    for ( const Token& value : values )
+    {
+      result->push_back( static_cast< DoubleDatum* >( value.datum() )->get() );
+    }
+    return result;
+  }
+  return ArrayDatum( values );
+}
+
+Datum*
+node_collection_get_values( const Datum* datum, const std::vector< std::string >& keys )
+{
+  const NodeCollectionDatum node_collection = *dynamic_cast< const NodeCollectionDatum* >( datum );
+  if ( not node_collection->valid() )
+  {
+    throw KernelException(
+      "InvalidNodeCollection: note that ResetKernel invalidates all previously created NodeCollections." );
+  }
+
+  const std::vector< Name > names( keys.begin(), keys.end() );
+  std::vector< TokenArray > values( names.size() );
+  for ( auto& key_values : values )
+  {
+    key_values.reserve( node_collection->size() );
+  }
+  for ( auto it = node_collection->begin(); it < node_collection->end(); ++it )
+  {
+    const DictionaryDatum dict = get_node_status( ( *it ).node_id );
+    for ( size_t k = 0; k < names.size(); ++k )
+    {
+      values[ k ].push_back( dict->lookup2( names[ k ] ) );
+    }
+  }
+
+  DictionaryDatum result( new Dictionary );
+  for ( size_t k = 0; k < names.size(); ++k )
+  {
+    ( *result )[ names[ k ] ] = values_to_token( values[ k ] );
+  }
+  return new DictionaryDatum( result );
+}
+
+void
+node_collection_set_values( const Datum* datum,
+  const std::vector< std::string >& keys,
+  const double* values,
+  unsigned long n )
+{
+  const NodeCollectionDatum node_collection = *dynamic_cast< const NodeCollectionDatum* >( datum );
+  if ( not node_collection->valid() )
+  {
+    throw KernelException(
+      "InvalidNodeCollection: note that ResetKernel invalidates all previously created NodeCollections." );
+  }
+  if ( node_collection->size() != n )
+  {
+    throw DimensionMismatch( node_collection->size(), n );
+  }
+
+  std::vector< Name > names( keys.begin(), keys.end() );
+  size_t i = 0;
+  for ( auto it = node_collection->begin(); it < node_collection->end(); ++it, ++i )
+  {
+    DictionaryDatum dict( new Dictionary );
+    for ( size_t k = 0; k < names.size(); ++k )
+    {
+      def< double >( dict, names[ k ], values[ k * n + i ] );
+    }
+    set_node_status( ( *it ).node_id, dict );
+  }
+}
+
+Datum*
+get_connection_columns( const Datum* datum )
+{
+  const DictionaryDatum dict = *dynamic_cast< const DictionaryDatum* >( datum );
+  dict->clear_access_flags();
+
+  DictionaryDatum columns = kernel().connection_manager.get_connection_columns( dict );
+
+  ALL_ENTRIES_ACCESSED( *dict, "GetConnections", "Unread dictionary entries: " );
+
+  return new DictionaryDatum( columns );
+}
+
+/**
+ * Create connection IDs from columns as returned by get_connection_columns().
+ */
+static std::vector< ConnectionID >
+connection_ids_from_columns( const long* sources,
+  const long* targets,
+  const long* threads,
+  const long* synapse_ids,
+  const long* ports,
+  unsigned long n )
+{
+  std::vector< ConnectionID > conns;
+  conns.reserve( n );
+  for ( size_t i = 0; i < n; ++i )
+  {
+    conns.emplace_back( sources[ i ], targets[ i ], threads[ i ], synapse_ids[ i ], ports[ i ] );
+  }
+  return conns;
+}
+
+void
+get_connection_values( const long* sources,
+  const long* targets,
+  const long* threads,
+  const long* synapse_ids,
+  const long* ports,
+  unsigned long n,
+  const std::string& key,
+  double* values )
+{
+  kernel().connection_manager.get_connection_values(
+    connection_ids_from_columns( sources, targets, threads, synapse_ids, ports, n ), Name( key ), values );
+}
+
+void
+set_connection_values( const long* sources,
+  const long* targets,
+  const long* threads,
+  const long* synapse_ids,
+  const long* ports,
+  unsigned long n,
+  const std::vector< std::string >& keys,
+  const double* values )
+{
+  kernel().connection_manager.set_connection_values(
+    connection_ids_from_columns( sources, targets, threads, synapse_ids, ports, n ),
+    std::vector< Name >( keys.begin(), keys.end() ),
+    values );
+}
+
 void
 slice_positions_if_sliced_nc( DictionaryDatum& dict, const NodeCollectionDatum& nc )
 {
@@ -177,6 +177,20 @@ void prepare();
  */
 void cleanup();
 
+/**
+ * @brief Write nodes and connections of the network to a binary snapshot.
+ *
+ * @see NetworkSnapshot
+ */
+void save_network( const std::string& path );
+
+/**
+ * @brief Create nodes and connections from a binary snapshot.
+ *
+ * @see NetworkSnapshot
+ */
+void load_network( const std::string& path );
+
 void copy_model( const Name& oldmodname, const Name& newmodname, const DictionaryDatum& dict );
 
 void set_model_defaults( const std::string model_name, const DictionaryDatum& );
@@ -191,6 +205,72 @@ std::vector< double > apply( const ParameterDatum& param, const DictionaryDatum&
 Datum* node_collection_array_index( const Datum* datum, const long* array, unsigned long n );
 Datum* node_collection_array_index( const Datum* datum, const bool* array, unsigned long n );
 
+/**
+ * @brief Create nodes and return them as NodeCollectionDatum.
+ *
+ * Allows PyNEST to create nodes without a detour through the SLI interpreter.
+ */
+Datum* create_node_collection( const std::string& model_name, const long n );
+
+/**
+ * @brief Get the values of the given status properties for all nodes in a NodeCollection.
+ *
+ * Returns a DictionaryDatum with one entry per key. The status dictionary of each node is obtained
+ * once and only the values of the given keys are kept. They are collected in an IntVectorDatum or a
+ * DoubleVectorDatum if all are integers or doubles, respectively, and in an ArrayDatum otherwise.
+ * This avoids converting the full status dictionary of each node on the Python side.
+ */
+Datum* node_collection_get_values( const Datum* datum, const std::vector< std::string >& keys );
+
+/**
+ * @brief Set double-valued status properties individually for all nodes in a NodeCollection.
+ *
+ * The array values holds one row of n values for each key, where n is the size of the NodeCollection.
+ * All properties of a node are set with a single status dictionary. values may be null if there are
+ * no keys or n is zero.
+ */
+void node_collection_set_values( const Datum* datum,
+  const std::vector< std::string >& keys,
+  const double* values,
+  unsigned long n );
+
+/**
+ * @brief Get the connections selected by a dictionary as columns.
+ *
+ * Returns a DictionaryDatum with one IntVectorDatum each for source, target, target_thread,
+ * synapse_id and port. This avoids creating a ConnectionDatum for every connection.
+ */
+Datum* get_connection_columns( const Datum* datum );
+
+/**
+ * @brief Get the value of one parameter for n connections given as columns.
+ *
+ * The i-th connection is identified by sources[ i ], targets[ i ], threads[ i ], synapse_ids[ i ] and ports[ i ]
+ * as returned by get_connection_columns(). The parameter must be of type double, its values are written to values.
+ */
+void get_connection_values( const long* sources,
+  const long* targets,
+  const long* threads,
+  const long* synapse_ids,
+  const long* ports,
+  unsigned long n,
+  const std::string& key,
+  double* values );
+
+/**
+ * @brief Set parameters of n connections given as columns.
+ *
+ * The value of keys[ k ] for the i-th connection is values[ k * n + i ].
+ */
+void set_connection_values( const long* sources,
+  const long* targets,
+  const long* threads,
+  const long* synapse_ids,
+  const long* ports,
+  unsigned long n,
+  const std::vector< std::string >& keys,
+  const double* values );
+
 /**
  * @brief Get only positions of the sliced nodes if metadata contains node positions and the NodeCollection is sliced.
  *
@@ -56,6 +56,8 @@ const Name add_compartments( "add_compartments" );
 const Name add_receptors( "add_receptors" );
 const Name after_spike_currents( "after_spike_currents" );
 const Name ahp_bug( "ahp_bug" );
+const Name align_nodes_to_cache_lines( "align_nodes_to_cache_lines" );
+const Name alignment( "alignment" );
 const Name allow_autapses( "allow_autapses" );
 const Name allow_multapses( "allow_multapses" );
 const Name allow_offgrid_times( "allow_offgrid_times" );
@@ -88,6 +90,8 @@ const Name box( "box" );
 const Name buffer_size( "buffer_size" );
 const Name buffer_size_spike_data( "buffer_size_spike_data" );
 const Name buffer_size_target_data( "buffer_size_target_data" );
+const Name bytes( "bytes" );
+const Name bytes_per_synapse( "bytes_per_synapse" );
 
 const Name C_m( "C_m" );
 const Name Ca( "Ca" );
@@ -100,6 +104,7 @@ const Name c_3( "c_3" );
 const Name c_reg( "c_reg" );
 const Name capacity( "capacity" );
 const Name center( "center" );
+const Name chunk_size( "chunk_size" );
 const Name circular( "circular" );
 const Name clear( "clear" );
 const Name comp_idx( "comp_idx" );
@@ -307,6 +312,7 @@ const Name max( "max" );
 const Name max_buffer_size_target_data( "max_buffer_size_target_data" );
 const Name max_delay( "max_delay" );
 const Name max_num_syn_models( "max_num_syn_models" );
+const Name max_pending_chunks( "max_pending_chunks" );
 const Name max_update_time( "max_update_time" );
 const Name mean( "mean" );
 const Name memory( "memory" );
@@ -342,6 +348,7 @@ const Name network_size( "network_size" );
 const Name neuron( "neuron" );
 const Name next_readout_time( "next_readout_time" );
 const Name no_synapses( "no_synapses" );
+const Name node_memory( "node_memory" );
 const Name node_models( "node_models" );
 const Name node_uses_wfr( "node_uses_wfr" );
 const Name noise( "noise" );
@@ -360,11 +367,13 @@ const Name origin( "origin" );
 const Name other( "other" );
 const Name outdegree( "outdegree" );
 const Name outer_radius( "outer_radius" );
+const Name overlap_spike_communication( "overlap_spike_communication" );
 const Name overwrite_files( "overwrite_files" );
 
 const Name P( "P" );
 const Name p( "p" );
 const Name p_copy( "p_copy" );
+const Name p_max( "p_max" );
 const Name p_primary( "p_primary" );
 const Name p_third_if_primary( "p_third_if_primary" );
 const Name p_transmit( "p_transmit" );
@@ -462,6 +471,7 @@ const Name size_of( "sizeof" );
 const Name soma_curr( "soma_curr" );
 const Name soma_exc( "soma_exc" );
 const Name soma_inh( "soma_inh" );
+const Name sort_spikes_by_thread( "sort_spikes_by_thread" );
 const Name source( "source" );
 const Name spherical( "spherical" );
 const Name spike_buffer_grow_extra( "spike_buffer_grow_extra" );
@@ -469,6 +479,7 @@ const Name spike_buffer_resize_log( "spike_buffer_resize_log" );
 const Name spike_buffer_shrink_limit( "spike_buffer_shrink_limit" );
 const Name spike_buffer_shrink_spare( "spike_buffer_shrink_spare" );
 const Name spike_dependent_threshold( "spike_dependent_threshold" );
+const Name spike_exchange_mode( "spike_exchange_mode" );
 const Name spike_multiplicities( "spike_multiplicities" );
 const Name spike_times( "spike_times" );
 const Name spike_weights( "spike_weights" );
@@ -617,6 +628,8 @@ const Name u_ref_squared( "u_ref_squared" );
 const Name update_time_limit( "update_time_limit" );
 const Name upper_right( "upper_right" );
 const Name use_compressed_spikes( "use_compressed_spikes" );
+const Name use_local_source_positions( "use_local_source_positions" );
+const Name use_skip_sampling( "use_skip_sampling" );
 const Name use_wfr( "use_wfr" );
 
 const Name v( "v" );
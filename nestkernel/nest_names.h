@@ -82,6 +82,8 @@ extern const Name add_compartments;
 extern const Name add_receptors;
 extern const Name after_spike_currents;
 extern const Name ahp_bug;
+extern const Name align_nodes_to_cache_lines;
+extern const Name alignment;
 extern const Name allow_autapses;
 extern const Name allow_multapses;
 extern const Name allow_offgrid_times;
@@ -115,6 +117,8 @@ extern const Name box;
 extern const Name buffer_size;
 extern const Name buffer_size_spike_data;
 extern const Name buffer_size_target_data;
+extern const Name bytes;
+extern const Name bytes_per_synapse;
 
 extern const Name C_m;
 extern const Name Ca;
@@ -127,6 +131,7 @@ extern const Name c_3;
 extern const Name c_reg;
 extern const Name capacity;
 extern const Name center;
+extern const Name chunk_size;
 extern const Name circular;
 extern const Name clear;
 extern const Name comp_idx;
@@ -335,6 +340,7 @@ extern const Name max;
 extern const Name max_buffer_size_target_data;
 extern const Name max_delay;
 extern const Name max_num_syn_models;
+extern const Name max_pending_chunks;
 extern const Name max_update_time;
 extern const Name mean;
 extern const Name memory;
@@ -370,6 +376,7 @@ extern const Name network_size;
 extern const Name neuron;
 extern const Name next_readout_time;
 extern const Name no_synapses;
+extern const Name node_memory;
 extern const Name node_models;
 extern const Name node_uses_wfr;
 extern const Name noise;
@@ -388,11 +395,13 @@ extern const Name origin;
 extern const Name other;
 extern const Name outdegree;
 extern const Name outer_radius;
+extern const Name overlap_spike_communication;
 extern const Name overwrite_files;
 
 extern const Name P;
 extern const Name p;
 extern const Name p_copy;
+extern const Name p_max;
 extern const Name p_primary;
 extern const Name p_third_if_primary;
 extern const Name p_transmit;
@@ -490,6 +499,7 @@ extern const Name size_of;
 extern const Name soma_curr;
 extern const Name soma_exc;
 extern const Name soma_inh;
+extern const Name sort_spikes_by_thread;
 extern const Name source;
 extern const Name spherical;
 extern const Name spike_buffer_grow_extra;
@@ -497,6 +507,7 @@ extern const Name spike_buffer_resize_log;
 extern const Name spike_buffer_shrink_limit;
 extern const Name spike_buffer_shrink_spare;
 extern const Name spike_dependent_threshold;
+extern const Name spike_exchange_mode;
 extern const Name spike_multiplicities;
 extern const Name spike_times;
 extern const Name spike_weights;
@@ -645,6 +656,8 @@ extern const Name u_ref_squared;
 extern const Name update_time_limit;
 extern const Name upper_right;
 extern const Name use_compressed_spikes;
+extern const Name use_local_source_positions;
+extern const Name use_skip_sampling;
 extern const Name use_wfr;
 
 extern const Name v;
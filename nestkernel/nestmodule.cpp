@@ -577,6 +577,32 @@ NestModule::Install_sFunction::execute( SLIInterpreter* i ) const
   i->EStack.pop();
 }
 
+void
+NestModule::SaveNetwork_sFunction::execute( SLIInterpreter* i ) const
+{
+  i->assert_stack_load( 1 );
+
+  const std::string path = getValue< std::string >( i->OStack.pick( 0 ) );
+
+  save_network( path );
+
+  i->OStack.pop();
+  i->EStack.pop();
+}
+
+void
+NestModule::LoadNetwork_sFunction::execute( SLIInterpreter* i ) const
+{
+  i->assert_stack_load( 1 );
+
+  const std::string path = getValue< std::string >( i->OStack.pick( 0 ) );
+
+  load_network( path );
+
+  i->OStack.pop();
+  i->EStack.pop();
+}
+
 void
 NestModule::GetConnections_DFunction::execute( SLIInterpreter* i ) const
 {
@@ -2098,6 +2124,8 @@ NestModule::init( SLIInterpreter* i )
   i->createcommand( "GetDefaults_l", &getdefaults_lfunction );
 
   i->createcommand( "Install", &install_sfunction );
+  i->createcommand( "SaveNetwork", &savenetwork_sfunction );
+  i->createcommand( "LoadNetwork", &loadnetwork_sfunction );
 
   i->createcommand( "Create_l_i", &create_l_ifunction );
 
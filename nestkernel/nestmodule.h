@@ -398,6 +398,37 @@ public:
     void execute( SLIInterpreter* ) const override;
   } install_sfunction;
 
+  /** @BeginDocumentation
+   *  Name: SaveNetwork - write nodes and connections to a binary snapshot
+   *  Synopsis: (path) SaveNetwork -> -
+   *  Description:
+   *  Writes the status of all local nodes and all connections between
+   *  neurons to the given file. With more than one MPI process, the rank
+   *  is appended to the path. Connections to and from devices cannot be
+   *  saved, and the network must not have been simulated.
+   *  SeeAlso: LoadNetwork
+   */
+  class SaveNetwork_sFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const override;
+  } savenetwork_sfunction;
+
+  /** @BeginDocumentation
+   *  Name: LoadNetwork - create nodes and connections from a binary snapshot
+   *  Synopsis: (path) LoadNetwork -> -
+   *  Description:
+   *  Creates the nodes and connections stored by SaveNetwork in an empty
+   *  network. Numbers of MPI processes and threads and the resolution must
+   *  be the same as when the snapshot was saved.
+   *  SeeAlso: SaveNetwork
+   */
+  class LoadNetwork_sFunction : public SLIFunction
+  {
+  public:
+    void execute( SLIInterpreter* ) const override;
+  } loadnetwork_sfunction;
+
   class GetConnections_DFunction : public SLIFunction
   {
   public:
@@ -0,0 +1,512 @@
+/*
+ *  network_snapshot.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "network_snapshot.h"
+
+// C++ includes:
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <vector>
+
+// Includes from libnestutil:
+#include "compose.hpp"
+#include "logging.h"
+
+// Includes from nestkernel:
+#include "kernel_manager.h"
+#include "nest_time.h"
+#include "node.h"
+#include "vp_manager_impl.h"
+
+// Includes from sli:
+#include "arraydatum.h"
+#include "booldatum.h"
+#include "doubledatum.h"
+#include "integerdatum.h"
+#include "namedatum.h"
+#include "stringdatum.h"
+
+namespace
+{
+
+const char snapshot_magic[ 8 ] = { 'N', 'E', 'S', 'T', 'S', 'N', 'A', 'P' };
+
+/**
+ * Version of the snapshot format, to be increased with each change of the format.
+ */
+const uint32_t snapshot_version = 2;
+
+/**
+ * Types of dictionary entries stored in a snapshot.
+ */
+enum class EntryType : uint8_t
+{
+  DOUBLE,
+  INTEGER,
+  BOOL,
+  LITERAL,
+  STRING,
+  DOUBLE_VECTOR,
+  INT_VECTOR,
+  ARRAY,
+  DICTIONARY
+};
+
+} // namespace
+
+void
+nest::NetworkSnapshot::save( const std::string& path )
+{
+  if ( kernel().simulation_manager.has_been_simulated() )
+  {
+    throw KernelException( "Only networks that have not been simulated yet can be saved." );
+  }
+
+  const std::string filename = get_filename_( path );
+
+  std::ifstream test( filename.c_str() );
+  if ( test.good() and not kernel().io_manager.overwrite_files() )
+  {
+    std::string msg = String::compose(
+      "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+      "the kernel property overwrite_files to true.",
+      filename );
+    LOG( M_ERROR, "NetworkSnapshot::save()", msg );
+    throw IOError();
+  }
+  test.close();
+
+  std::ofstream os( filename.c_str(), std::ios::binary );
+  if ( not os.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "NetworkSnapshot::save()", msg );
+    throw IOError();
+  }
+
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+  os.write( snapshot_magic, sizeof( snapshot_magic ) );
+  write_binary< uint32_t >( os, snapshot_version );
+  write_binary< uint64_t >( os, kernel().mpi_manager.get_num_processes() );
+  write_binary< uint64_t >( os, kernel().mpi_manager.get_rank() );
+  write_binary< uint64_t >( os, num_threads );
+  write_binary< double >( os, Time::get_resolution().get_ms() );
+
+  std::set< std::string > skipped_entries;
+  write_nodes_( os, skipped_entries );
+  for ( const auto& entry : skipped_entries )
+  {
+    LOG( M_WARNING,
+      "NetworkSnapshot::save()",
+      String::compose( "Status entry '%1' cannot be stored in a network snapshot and is not saved.", entry ) );
+  }
+
+  // Synapse models are identified by name, as synapse IDs may differ when the snapshot is loaded.
+  const size_t num_synapse_models = kernel().model_manager.get_num_connection_models();
+  write_binary< uint64_t >( os, num_synapse_models );
+  for ( synindex syn_id = 0; syn_id < num_synapse_models; ++syn_id )
+  {
+    write_string_( os, kernel().model_manager.get_connection_model( syn_id, 0 ).get_name() );
+  }
+
+  // The connections of each thread form a section of the file. The positions of the sections are written
+  // once they are known, so that threads can seek to their section when loading.
+  const std::streampos offsets_position = os.tellp();
+  std::vector< uint64_t > offsets( num_threads, 0 );
+  os.write( reinterpret_cast< const char* >( offsets.data() ), num_threads * sizeof( uint64_t ) );
+
+  for ( size_t tid = 0; tid < num_threads; ++tid )
+  {
+    offsets[ tid ] = os.tellp();
+    kernel().connection_manager.write_snapshot( tid, os );
+  }
+
+  os.seekp( offsets_position );
+  os.write( reinterpret_cast< const char* >( offsets.data() ), num_threads * sizeof( uint64_t ) );
+
+  os.close();
+  if ( os.fail() )
+  {
+    std::string msg = String::compose( "I/O error while writing file '%1'.", filename );
+    LOG( M_ERROR, "NetworkSnapshot::save()", msg );
+    throw IOError();
+  }
+}
+
+void
+nest::NetworkSnapshot::load( const std::string& path )
+{
+  if ( kernel().node_manager.size() > 0 )
+  {
+    throw KernelException( "Networks can only be loaded into an empty kernel. Call ResetKernel() first." );
+  }
+
+  const std::string filename = get_filename_( path );
+
+  std::ifstream is( filename.c_str(), std::ios::binary );
+  if ( not is.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "NetworkSnapshot::load()", msg );
+    throw IOError();
+  }
+
+  char magic[ sizeof( snapshot_magic ) ];
+  if ( not is.read( magic, sizeof( magic ) ) or not std::equal( magic, magic + sizeof( magic ), snapshot_magic ) )
+  {
+    throw KernelException( String::compose( "The file '%1' is not a network snapshot.", filename ) );
+  }
+  if ( read_binary< uint32_t >( is ) != snapshot_version )
+  {
+    throw KernelException( String::compose( "The network snapshot '%1' has an unsupported version.", filename ) );
+  }
+
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+
+  const size_t num_processes = read_binary< uint64_t >( is );
+  const size_t rank = read_binary< uint64_t >( is );
+  const size_t snapshot_num_threads = read_binary< uint64_t >( is );
+  const double resolution = read_binary< double >( is );
+  if ( num_processes != kernel().mpi_manager.get_num_processes() or rank != kernel().mpi_manager.get_rank()
+    or snapshot_num_threads != num_threads or resolution != Time::get_resolution().get_ms() )
+  {
+    throw KernelException(
+      "Network snapshots can only be loaded with the number of MPI processes, threads and the resolution they "
+      "were saved with." );
+  }
+
+  read_nodes_( is );
+
+  std::vector< synindex > syn_ids( read_binary< uint64_t >( is ) );
+  for ( auto& syn_id : syn_ids )
+  {
+    syn_id = kernel().model_manager.get_synapse_model_id( read_string_( is ) );
+  }
+
+  std::vector< uint64_t > offsets( num_threads );
+  if ( not is.read( reinterpret_cast< char* >( offsets.data() ), num_threads * sizeof( uint64_t ) ) )
+  {
+    throw KernelException( "Network snapshot is truncated." );
+  }
+  is.close();
+
+  kernel().connection_manager.set_connections_have_changed();
+
+  std::vector< std::shared_ptr< WrappedThreadException > > exceptions_raised( num_threads );
+
+#pragma omp parallel
+  {
+    const size_t tid = kernel().vp_manager.get_thread_id();
+
+    try
+    {
+      std::ifstream thread_is( filename.c_str(), std::ios::binary );
+      thread_is.seekg( offsets[ tid ] );
+      kernel().connection_manager.read_snapshot( tid, thread_is, syn_ids );
+    }
+    catch ( std::exception& err )
+    {
+      // We must create a new exception here, err's lifetime ends at
+      // the end of the catch block.
+      exceptions_raised.at( tid ) = std::shared_ptr< WrappedThreadException >( new WrappedThreadException( err ) );
+    }
+  } // of omp parallel
+
+  for ( size_t tid = 0; tid < num_threads; ++tid )
+  {
+    if ( exceptions_raised.at( tid ).get() )
+    {
+      throw WrappedThreadException( *( exceptions_raised.at( tid ) ) );
+    }
+  }
+}
+
+std::string
+nest::NetworkSnapshot::get_filename_( const std::string& path )
+{
+  if ( kernel().mpi_manager.get_num_processes() > 1 )
+  {
+    return String::compose( "%1-%2", path, kernel().mpi_manager.get_rank() );
+  }
+  return path;
+}
+
+void
+nest::NetworkSnapshot::write_nodes_( std::ostream& os, std::set< std::string >& skipped_entries )
+{
+  // Models are stored as ranges of node IDs, which are identical on all MPI processes.
+  const size_t num_ranges = std::distance( kernel().modelrange_manager.begin(), kernel().modelrange_manager.end() );
+  write_binary< uint64_t >( os, num_ranges );
+  for ( auto it = kernel().modelrange_manager.begin(); it != kernel().modelrange_manager.end(); ++it )
+  {
+    write_binary< uint64_t >( os, it->get_first_node_id() );
+    write_binary< uint64_t >( os, it->get_last_node_id() );
+    write_string_( os, kernel().model_manager.get_node_model( it->get_model_id() )->get_name() );
+  }
+
+  // Status is stored for nodes on this process only.
+  const size_t num_nodes = kernel().node_manager.size();
+  std::vector< size_t > local_node_ids;
+  for ( size_t node_id = 1; node_id <= num_nodes; ++node_id )
+  {
+    if ( kernel().node_manager.is_local_node_id( node_id ) )
+    {
+      local_node_ids.push_back( node_id );
+    }
+  }
+
+  write_binary< uint64_t >( os, local_node_ids.size() );
+  for ( const auto node_id : local_node_ids )
+  {
+    write_binary< uint64_t >( os, node_id );
+    write_dictionary_( os, kernel().node_manager.get_status( node_id ), skipped_entries );
+  }
+}
+
+void
+nest::NetworkSnapshot::read_nodes_( std::istream& is )
+{
+  const size_t num_ranges = read_binary< uint64_t >( is );
+  for ( size_t i = 0; i < num_ranges; ++i )
+  {
+    const size_t first_node_id = read_binary< uint64_t >( is );
+    const size_t last_node_id = read_binary< uint64_t >( is );
+    const size_t model_id = kernel().model_manager.get_node_model_id( read_string_( is ) );
+
+    kernel().node_manager.add_node( model_id, last_node_id - first_node_id + 1 );
+  }
+
+  const size_t num_threads = kernel().vp_manager.get_num_threads();
+  const size_t num_local_nodes = read_binary< uint64_t >( is );
+  for ( size_t i = 0; i < num_local_nodes; ++i )
+  {
+    const size_t node_id = read_binary< uint64_t >( is );
+    const DictionaryDatum d = read_dictionary_( is );
+
+    // The status contains read-only entries, so it is set without checking that all entries are accessed.
+    // Nodes without proxies exist on every thread.
+    for ( size_t tid = 0; tid < num_threads; ++tid )
+    {
+      Node* node = kernel().node_manager.get_node_or_proxy( node_id, tid );
+      if ( not node->is_proxy() )
+      {
+        node->set_status_base( d );
+      }
+    }
+  }
+}
+
+void
+nest::NetworkSnapshot::write_string_( std::ostream& os, const std::string& s )
+{
+  write_binary< uint64_t >( os, s.size() );
+  os.write( s.data(), s.size() );
+}
+
+std::string
+nest::NetworkSnapshot::read_string_( std::istream& is )
+{
+  std::string s( read_binary< uint64_t >( is ), '\0' );
+  if ( not is.read( &s[ 0 ], s.size() ) )
+  {
+    throw KernelException( "Network snapshot is truncated." );
+  }
+  return s;
+}
+
+bool
+nest::NetworkSnapshot::is_storable_( const Token& t )
+{
+  Datum* datum = t.datum();
+  if ( ArrayDatum* array = dynamic_cast< ArrayDatum* >( datum ) )
+  {
+    return std::all_of( array->begin(), array->end(), is_storable_ );
+  }
+  return dynamic_cast< DoubleDatum* >( datum ) or dynamic_cast< IntegerDatum* >( datum )
+    or dynamic_cast< BoolDatum* >( datum ) or dynamic_cast< LiteralDatum* >( datum )
+    or dynamic_cast< StringDatum* >( datum ) or dynamic_cast< DoubleVectorDatum* >( datum )
+    or dynamic_cast< IntVectorDatum* >( datum ) or dynamic_cast< DictionaryDatum* >( datum );
+}
+
+void
+nest::NetworkSnapshot::write_token_( std::ostream& os,
+  const Token& t,
+  const std::string& path,
+  std::set< std::string >& skipped_entries )
+{
+  Datum* datum = t.datum();
+  if ( DoubleDatum* value = dynamic_cast< DoubleDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::DOUBLE );
+    write_binary< double >( os, value->get() );
+  }
+  else if ( IntegerDatum* value = dynamic_cast< IntegerDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::INTEGER );
+    write_binary< int64_t >( os, value->get() );
+  }
+  else if ( BoolDatum* value = dynamic_cast< BoolDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::BOOL );
+    write_binary< bool >( os, value->get() );
+  }
+  else if ( LiteralDatum* value = dynamic_cast< LiteralDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::LITERAL );
+    write_string_( os, value->toString() );
+  }
+  else if ( StringDatum* value = dynamic_cast< StringDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::STRING );
+    write_string_( os, *value );
+  }
+  else if ( DoubleVectorDatum* value = dynamic_cast< DoubleVectorDatum* >( datum ) )
+  {
+    const std::vector< double >& values = **value;
+    write_binary< EntryType >( os, EntryType::DOUBLE_VECTOR );
+    write_binary< uint64_t >( os, values.size() );
+    os.write( reinterpret_cast< const char* >( values.data() ), values.size() * sizeof( double ) );
+  }
+  else if ( IntVectorDatum* value = dynamic_cast< IntVectorDatum* >( datum ) )
+  {
+    const std::vector< long >& values = **value;
+    write_binary< EntryType >( os, EntryType::INT_VECTOR );
+    write_binary< uint64_t >( os, values.size() );
+    for ( const long v : values )
+    {
+      write_binary< int64_t >( os, v );
+    }
+  }
+  else if ( ArrayDatum* value = dynamic_cast< ArrayDatum* >( datum ) )
+  {
+    write_binary< EntryType >( os, EntryType::ARRAY );
+    write_binary< uint64_t >( os, value->size() );
+    for ( const Token& element : *value )
+    {
+      write_token_( os, element, path, skipped_entries );
+    }
+  }
+  else
+  {
+    const DictionaryDatum& dict = *static_cast< DictionaryDatum* >( datum );
+    write_binary< EntryType >( os, EntryType::DICTIONARY );
+    write_dictionary_( os, dict, skipped_entries, path + "/" );
+  }
+}
+
+Token
+nest::NetworkSnapshot::read_token_( std::istream& is )
+{
+  switch ( read_binary< EntryType >( is ) )
+  {
+  case EntryType::DOUBLE:
+    return Token( read_binary< double >( is ) );
+  case EntryType::INTEGER:
+    return Token( static_cast< long >( read_binary< int64_t >( is ) ) );
+  case EntryType::BOOL:
+    return Token( read_binary< bool >( is ) );
+  case EntryType::LITERAL:
+    return LiteralDatum( read_string_( is ) );
+  case EntryType::STRING:
+    return Token( read_string_( is ) );
+  case EntryType::DOUBLE_VECTOR:
+  {
+    std::vector< double >* values = new std::vector< double >( read_binary< uint64_t >( is ) );
+    DoubleVectorDatum datum( values );
+    if ( not is.read( reinterpret_cast< char* >( values->data() ), values->size() * sizeof( double ) ) )
+    {
+      throw KernelException( "Network snapshot is truncated." );
+    }
+    return datum;
+  }
+  case EntryType::INT_VECTOR:
+  {
+    std::vector< long >* values = new std::vector< long >( read_binary< uint64_t >( is ) );
+    IntVectorDatum datum( values );
+    for ( auto& value : *values )
+    {
+      value = read_binary< int64_t >( is );
+    }
+    return datum;
+  }
+  case EntryType::ARRAY:
+  {
+    const size_t size = read_binary< uint64_t >( is );
+    ArrayDatum array;
+    array.reserve( size );
+    for ( size_t i = 0; i < size; ++i )
+    {
+      array.push_back( read_token_( is ) );
+    }
+    return array;
+  }
+  case EntryType::DICTIONARY:
+    return read_dictionary_( is );
+  default:
+    throw KernelException( "Network snapshot is corrupted." );
+  }
+}
+
+void
+nest::NetworkSnapshot::write_dictionary_( std::ostream& os,
+  const DictionaryDatum& d,
+  std::set< std::string >& skipped_entries,
+  const std::string& prefix )
+{
+  std::vector< Name > names;
+  for ( auto it = d->begin(); it != d->end(); ++it )
+  {
+    if ( is_storable_( it->second ) )
+    {
+      names.push_back( it->first );
+    }
+    else
+    {
+      skipped_entries.insert( prefix + it->first.toString() );
+    }
+  }
+
+  write_binary< uint64_t >( os, names.size() );
+  for ( const auto& name : names )
+  {
+    write_string_( os, name.toString() );
+    write_token_( os, ( *d )[ name ], prefix + name.toString(), skipped_entries );
+  }
+}
+
+DictionaryDatum
+nest::NetworkSnapshot::read_dictionary_( std::istream& is )
+{
+  DictionaryDatum d( new Dictionary );
+
+  const size_t num_entries = read_binary< uint64_t >( is );
+  for ( size_t i = 0; i < num_entries; ++i )
+  {
+    const Name name( read_string_( is ) );
+    ( *d )[ name ] = read_token_( is );
+  }
+
+  return d;
+}
@@ -0,0 +1,148 @@
+/*
+ *  network_snapshot.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NETWORK_SNAPSHOT_H
+#define NETWORK_SNAPSHOT_H
+
+// C++ includes:
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <string>
+#include <type_traits>
+
+// Includes from nestkernel:
+#include "exceptions.h"
+
+// Includes from sli:
+#include "dictdatum.h"
+
+namespace nest
+{
+
+/**
+ * Save and load the nodes and connections of a network in a binary file.
+ *
+ * A snapshot contains the model and status of all nodes and all connections
+ * between nodes with proxies that are stored on one MPI process. Each thread
+ * writes its connections to a separate section of the file, so that threads
+ * read their connections in parallel when the snapshot is loaded. With more
+ * than one MPI process, each process writes its own file, with the rank
+ * appended to the path.
+ *
+ * Connections are written in the binary representation of their synapse
+ * model. Snapshots can thus only be loaded by the same build of NEST, into an
+ * empty network with the same number of MPI processes and threads and the
+ * same resolution. Connections are sorted and target tables are rebuilt when
+ * the loaded network is simulated for the first time.
+ */
+class NetworkSnapshot
+{
+public:
+  /**
+   * Write the network to the file given by path.
+   *
+   * @throws KernelException if the network has already been simulated, or
+   * the source table has been cleared.
+   * @throws NotImplemented if the network contains connections that cannot
+   * be stored in a snapshot.
+   */
+  static void save( const std::string& path );
+
+  /**
+   * Create the nodes and connections stored in the file given by path.
+   *
+   * @throws KernelException if the network is not empty, or the snapshot
+   * does not match the kernel configuration.
+   */
+  static void load( const std::string& path );
+
+private:
+  static std::string get_filename_( const std::string& path );
+
+  static void write_nodes_( std::ostream&, std::set< std::string >& skipped_entries );
+  static void read_nodes_( std::istream& );
+
+  static void write_string_( std::ostream&, const std::string& );
+  static std::string read_string_( std::istream& );
+
+  /**
+   * Write all entries of numeric, boolean, string, numeric vector, array or dictionary type.
+   *
+   * Arrays and dictionaries are stored recursively. Entries of other types, e.g., NodeCollections, and arrays
+   * containing them are not stored. Their names, preceded by prefix, are added to skipped_entries.
+   */
+  static void write_dictionary_( std::ostream&,
+    const DictionaryDatum&,
+    std::set< std::string >& skipped_entries,
+    const std::string& prefix = "" );
+  static DictionaryDatum read_dictionary_( std::istream& );
+
+  //! Return true if the value can be stored by write_token_().
+  static bool is_storable_( const Token& );
+
+  //! Write type and value of a storable token, path is the name of its entry.
+  static void write_token_( std::ostream&,
+    const Token&,
+    const std::string& path,
+    std::set< std::string >& skipped_entries );
+  static Token read_token_( std::istream& );
+};
+
+/**
+ * Write the binary representation of a value to a network snapshot.
+ */
+template < typename T >
+inline void
+write_binary( std::ostream& os, const T& value )
+{
+  static_assert( std::is_trivially_copyable< T >::value, "Only trivially copyable types can be written." );
+  os.write( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+}
+
+/**
+ * Read the binary representation of a value from a network snapshot.
+ */
+template < typename T >
+inline void
+read_binary( std::istream& is, T& value )
+{
+  static_assert( std::is_trivially_copyable< T >::value, "Only trivially copyable types can be read." );
+  if ( not is.read( reinterpret_cast< char* >( &value ), sizeof( T ) ) )
+  {
+    throw KernelException( "Network snapshot is truncated." );
+  }
+}
+
+template < typename T >
+inline T
+read_binary( std::istream& is )
+{
+  T value;
+  read_binary( is, value );
+  return value;
+}
+
+} // namespace nest
+
+#endif /* NETWORK_SNAPSHOT_H */
@@ -252,6 +252,12 @@ Node::handle( SpikeEvent& )
   throw UnexpectedEvent( "The target node does not handle spike input." );
 }
 
+std::vector< size_t >
+Node::get_receptor_types_of_port( const size_t rport ) const
+{
+  return { rport };
+}
+
 size_t
 Node::handles_test_event( SpikeEvent&, size_t )
 {
@@ -413,6 +413,17 @@ public:
   virtual size_t handles_test_event( LearningSignalConnectionEvent&, size_t receptor_type );
   virtual size_t handles_test_event( SICEvent&, size_t receptor_type );
 
+  /**
+   * Return the receptor types for which handles_test_event() may return the given port.
+   *
+   * Network snapshots store the port of each connection, but not the
+   * receptor type it was created with. When a snapshot is loaded, the
+   * receptor types returned here are tried in turn. The base class
+   * implementation returns the port itself. Models that do not use the
+   * receptor type as port must override this function.
+   */
+  virtual std::vector< size_t > get_receptor_types_of_port( const size_t rport ) const;
+
   /**
    * Required to check, if source neuron may send a SecondaryEvent.
    *
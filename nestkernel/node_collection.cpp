@@ -30,7 +30,7 @@
 
 // C++ includes:
 #include <algorithm> // copy
-#include <numeric>   // accumulate
+#include <numeric>   // accumulate, gcd
 
 
 namespace nest
@@ -55,6 +55,8 @@ nc_const_iterator::nc_const_iterator( NodeCollectionPTR collection_ptr,
   , element_idx_( offset )
   , part_idx_( 0 )
   , step_( step )
+  , local_modulus_( 1 )
+  , local_residue_( 0 )
   , primitive_collection_( &collection )
   , composite_collection_( nullptr )
 {
@@ -75,6 +77,8 @@ nc_const_iterator::nc_const_iterator( NodeCollectionPTR collection_ptr,
   , element_idx_( offset )
   , part_idx_( part )
   , step_( step )
+  , local_modulus_( 1 )
+  , local_residue_( 0 )
   , primitive_collection_( nullptr )
   , composite_collection_( &collection )
 {
@@ -108,7 +112,8 @@ nc_const_iterator::composite_update_indices_()
   if ( composite_collection_->is_sliced_ )
   {
     assert( composite_collection_->end_offset_ != 0 or composite_collection_->end_part_ != 0 );
-    if ( part_idx_ >= composite_collection_->end_part_ and element_idx_ >= composite_collection_->end_offset_ )
+    if ( part_idx_ > composite_collection_->end_part_
+      or ( part_idx_ == composite_collection_->end_part_ and element_idx_ >= composite_collection_->end_offset_ ) )
     {
       part_idx_ = composite_collection_->end_part_;
       element_idx_ = composite_collection_->end_offset_;
@@ -122,6 +127,22 @@ nc_const_iterator::composite_update_indices_()
   }
 }
 
+void
+nc_const_iterator::composite_find_local_()
+{
+  const size_t step = composite_collection_->step_;
+  while ( part_idx_ < composite_collection_->end_part_
+    or ( part_idx_ == composite_collection_->end_part_ and element_idx_ < composite_collection_->end_offset_ ) )
+  {
+    if ( composite_collection_->parts_[ part_idx_ ][ element_idx_ ] % local_modulus_ == local_residue_ )
+    {
+      return;
+    }
+    element_idx_ += step;
+    composite_update_indices_();
+  }
+}
+
 void
 nc_const_iterator::print_me( std::ostream& out ) const
 {
@@ -189,7 +210,22 @@ nc_const_iterator::operator++()
   }
   else
   {
+    if ( local_modulus_ > 1 and element_idx_ >= composite_collection_->parts_[ part_idx_ ].size() )
+    {
+      // Local elements are only equidistant within a part. Continue with the slicing step of the composite into
+      // the next part, so that no element of the next part is skipped.
+      element_idx_ -= step_;
+      while ( element_idx_ < composite_collection_->parts_[ part_idx_ ].size() )
+      {
+        element_idx_ += composite_collection_->step_;
+      }
+    }
     composite_update_indices_();
+    if ( local_modulus_ > 1 )
+    {
+      // Stepping into the next part may require realignment to local elements
+      composite_find_local_();
+    }
   }
   return *this;
 }
@@ -875,48 +911,38 @@ NodeCollectionComposite::local_begin( NodeCollectionPTR cp ) const
 {
   const size_t num_vps = kernel().vp_manager.get_num_virtual_processes();
   const size_t current_vp = kernel().vp_manager.thread_to_vp( kernel().vp_manager.get_thread_id() );
-  const size_t vp_first_node = kernel().vp_manager.node_id_to_vp( operator[]( 0 ) );
 
-  return local_begin_( cp, num_vps, current_vp, vp_first_node );
+  return local_begin_( cp, num_vps, current_vp );
 }
 
 NodeCollectionComposite::const_iterator
 NodeCollectionComposite::MPI_local_begin( NodeCollectionPTR cp ) const
 {
+  // Node IDs are assigned to ranks round-robin, since the number of virtual processes is a multiple of the number of
+  // processes.
   const size_t num_processes = kernel().mpi_manager.get_num_processes();
   const size_t rank = kernel().mpi_manager.get_rank();
-  const size_t rank_first_node =
-    kernel().mpi_manager.get_process_id_of_vp( kernel().vp_manager.node_id_to_vp( operator[]( 0 ) ) );
 
-  return local_begin_( cp, num_processes, rank, rank_first_node );
+  return local_begin_( cp, num_processes, rank );
 }
 
 
 NodeCollectionComposite::const_iterator
 NodeCollectionComposite::local_begin_( const NodeCollectionPTR cp,
   const size_t num_vp_elements,
-  const size_t current_vp_element,
-  const size_t vp_element_first_node ) const
+  const size_t current_vp_element ) const
 {
-  const size_t offset = ( current_vp_element - vp_element_first_node ) % num_vp_elements;
-
-  if ( ( current_vp_element - vp_element_first_node ) % step_ != 0 )
-  { // There are no local nodes in the NodeCollection.
-    return end( cp );
-  }
+  // Within a part, consecutive node IDs belong to consecutive VP elements, so local elements of a part are
+  // equidistant. The distance is the smallest multiple of the slicing step that is also a multiple of the number of
+  // VP elements.
+  const size_t local_step = step_ / std::gcd( step_, num_vp_elements ) * num_vp_elements;
 
-  size_t current_part = start_part_;
-  size_t current_offset = start_offset_;
-  if ( offset )
-  {
-    // First create an iterator at the start position.
-    auto tmp_it = const_iterator( cp, *this, start_part_, start_offset_, step_ );
-    tmp_it += offset; // Go forward to the offset.
-    // Get current position.
-    tmp_it.get_current_part_offset( current_part, current_offset );
-  }
+  auto it = const_iterator( cp, *this, start_part_, start_offset_, local_step );
+  it.local_modulus_ = num_vp_elements;
+  it.local_residue_ = current_vp_element;
+  it.composite_find_local_();
 
-  return const_iterator( cp, *this, current_part, current_offset, num_vp_elements * step_ );
+  return it;
 }
 
 ArrayDatum
@@ -1035,14 +1061,21 @@ NodeCollectionComposite::get_lid( const size_t node_id ) const
         // Is node_id in the sliced NC?
         const auto node_id_before_start = node_id < parts_[ middle ][ absolute_part_start ];
         const auto node_id_after_end = parts_[ middle ][ absolute_part_end - 1 ] < node_id;
-        const auto node_id_missed_by_step = ( ( absolute_pos - start_offset_ ) % step_ ) != 0;
-        if ( node_id_before_start or node_id_after_end or node_id_missed_by_step )
+        if ( node_id_before_start or node_id_after_end )
+        {
+          return -1;
+        }
+
+        // The slice may start in a later part, so positions are counted from its absolute start.
+        const auto absolute_start =
+          std::accumulate( parts_.begin(), parts_.begin() + start_part_, start_offset_, add_size_op );
+        if ( ( absolute_pos - absolute_start ) % step_ != 0 )
         {
           return -1;
         }
 
         // Return the calculated local ID of node_id.
-        return ( absolute_pos - start_offset_ ) / step_;
+        return ( absolute_pos - absolute_start ) / step_;
       }
       else
       {
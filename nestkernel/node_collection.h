@@ -99,6 +99,8 @@ private:
   size_t element_idx_;         //!< index into (current) primitive node collection
   size_t part_idx_;            //!< index into parts vector of composite collection
   size_t step_;                //!< step for skipping due to e.g. slicing
+  size_t local_modulus_;       //!< iterator only visits node IDs with node_id % local_modulus_ == local_residue_
+  size_t local_residue_;       //!< see local_modulus_
 
   /**
    * Pointer to primitive collection to iterate over.
@@ -147,6 +149,15 @@ private:
    */
   void composite_update_indices_();
 
+  /**
+   * Advance iterator over composite NodeCollection to the next local element.
+   *
+   * Starting from the current element, moves in steps of the slicing step of
+   * the composite until it points to a node ID with
+   * node_id % local_modulus_ == local_residue_ or to the end of the composite.
+   */
+  void composite_find_local_();
+
 public:
   using iterator_category = std::forward_iterator_tag;
   using difference_type = long;
@@ -299,10 +310,17 @@ public:
   virtual const_iterator begin( NodeCollectionPTR = NodeCollectionPTR( nullptr ) ) const = 0;
 
   /**
-   * Method to get an iterator representing the beginning of the NodeCollection.
+   * Method to get an iterator over the nodes of the NodeCollection on the
+   * virtual process of the calling thread.
+   *
+   * As node IDs are assigned to virtual processes round-robin, the iterator
+   * strides over the NodeCollection and each thread only visits the nodes
+   * it owns. Nodes without proxies, e.g., devices, exist on every virtual
+   * process and are thus only visited if their node ID maps to the calling
+   * thread's virtual process.
    *
-   * @return an iterator representing the beginning of the NodeCollection, in a
-   * parallel context.
+   * @return an iterator representing the first node of the NodeCollection
+   * on the virtual process of the calling thread.
    */
   virtual const_iterator local_begin( NodeCollectionPTR = NodeCollectionPTR( nullptr ) ) const = 0;
 
@@ -586,10 +604,11 @@ private:
    */
   void merge_parts_( std::vector< NodeCollectionPrimitive >& parts ) const;
 
-  const_iterator local_begin_( const NodeCollectionPTR cp,
-    const size_t num_vp_elements,
-    const size_t current_vp_element,
-    const size_t vp_element_first_node ) const;
+  /**
+   * Create an iterator over the elements with node_id % num_vp_elements == current_vp_element.
+   */
+  const_iterator
+  local_begin_( const NodeCollectionPTR cp, const size_t num_vp_elements, const size_t current_vp_element ) const;
 
 public:
   /**
@@ -703,6 +722,16 @@ NodeCollection::get_last() const
 inline nc_const_iterator&
 nc_const_iterator::operator+=( const size_t n )
 {
+  if ( local_modulus_ > 1 )
+  {
+    // Local elements are not equidistant across parts of a composite
+    for ( size_t i = 0; i < n; ++i )
+    {
+      ++( *this );
+    }
+    return *this;
+  }
+
   element_idx_ += n * step_;
   if ( composite_collection_ )
   {
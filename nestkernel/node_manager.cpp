@@ -603,7 +603,8 @@ NodeManager::destruct_nodes_()
     const size_t tid = kernel().vp_manager.get_thread_id();
     for ( auto node : local_nodes_[ tid ] )
     {
-      delete node.get_node();
+      Node* n = node.get_node();
+      kernel().model_manager.get_node_model( n->get_model_id() )->destroy( tid, n );
     }
     local_nodes_[ tid ].clear();
   } // omp parallel
@@ -24,6 +24,7 @@
 #define NTREE_H
 
 // C++ includes:
+#include <array>
 #include <bitset>
 #include <iterator>
 #include <utility>
@@ -306,6 +307,34 @@ public:
    */
   iterator insert( iterator, const value_type& val );
 
+  /**
+   * Insert all given nodes into an empty ntree.
+   *
+   * The resulting ntree is the same as when inserting the nodes one by one
+   * in the given order. Instead, nodes are partitioned by subquad level by
+   * level, i.e., sorted by the Morton code of their leaf while keeping their
+   * order within each leaf. The subtrees below the top levels are built in
+   * parallel.
+   */
+  void insert_bulk( std::vector< value_type > nodes );
+
+  /**
+   * Insert the given nodes into an empty ntree, splitting it as if the
+   * nodes in counted had been inserted instead.
+   *
+   * If each MPI process holds only some of the nodes, counted are the nodes
+   * on this process and sum_counts adds up numbers of nodes over all
+   * processes. The ntree is then split as if all nodes had been inserted.
+   * Masked iteration over a part of the ntree for which nodes contains all
+   * nodes thus visits them in the same order as in the ntree of all nodes.
+   *
+   * @param nodes      nodes to insert
+   * @param counted    nodes determining where the ntree is split
+   * @param sum_counts callable summing a std::vector< double > of numbers of nodes in place
+   */
+  template < class SumCounts >
+  void insert_bulk( std::vector< value_type > nodes, std::vector< value_type > counted, SumCounts sum_counts );
+
   /**
    * @returns member nodes in ntree and their position.
    */
@@ -361,6 +390,35 @@ public:
    */
   bool is_leaf() const;
 
+  const Position< D >&
+  get_lower_left() const
+  {
+    return lower_left_;
+  }
+
+  const Position< D >&
+  get_extent() const
+  {
+    return extent_;
+  }
+
+  std::bitset< D >
+  get_periodic() const
+  {
+    return periodic_;
+  }
+
+  /**
+   * Get the anchors of all images of a mask which may contain nodes.
+   *
+   * With periodic b.c., the anchor is moved so that the lower left corner
+   * of the mask is inside the ntree, and further anchors are added for
+   * masks extending beyond the ntree.
+   *
+   * @returns anchors in the order in which the masked_iterator visits them.
+   */
+  std::vector< Position< D > > get_anchors( const Mask< D >& mask, const Position< D >& anchor ) const;
+
 protected:
   /**
    * Change a leaf ntree to a regular ntree with four
@@ -368,6 +426,36 @@ protected:
    */
   void split_();
 
+  /**
+   * Create the children of a leaf ntree, without moving its nodes.
+   */
+  void create_children_();
+
+  /**
+   * Map position into the ntree when using periodic b.c.
+   */
+  void wrap_position_( Position< D >& pos ) const;
+
+  /**
+   * Make a leaf ntree a regular ntree and stably sort the nodes in the
+   * range [begin, end) by subquad.
+   *
+   * @returns range boundaries, nodes of subquad j are in [bounds[j], bounds[j+1]).
+   */
+  std::array< size_t, N + 1 > partition_( std::vector< value_type >& nodes, const size_t begin, const size_t end );
+
+  /**
+   * Stably sort the nodes in the range [begin, end) by subquad.
+   *
+   * @returns range boundaries, nodes of subquad j are in [bounds[j], bounds[j+1]).
+   */
+  std::array< size_t, N + 1 > sort_by_subquad_( std::vector< value_type >& nodes, const size_t begin, const size_t end );
+
+  /**
+   * Build the subtree of an empty leaf ntree from the nodes in the range [begin, end).
+   */
+  void build_( std::vector< value_type >& nodes, const size_t begin, const size_t end );
+
   /**
    * Append this ntree's nodes to the vector
    */
@@ -24,6 +24,7 @@
 #define NTREE_IMPL_H
 
 #include <limits>
+#include <tuple>
 
 #include "ntree.h"
 
@@ -130,46 +131,52 @@ Ntree< D, T, max_capacity, max_depth >::masked_iterator::masked_iterator( Ntree<
   , node_( 0 )
   , mask_( &mask )
   , anchor_( anchor )
-  , anchors_()
+  , anchors_( q.get_anchors( mask, anchor ) )
   , current_anchor_( 0 )
 {
-  if ( ntree_->periodic_.any() )
+  anchor_ = anchors_[ 0 ];
+  init_();
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+std::vector< Position< D > >
+Ntree< D, T, max_capacity, max_depth >::get_anchors( const Mask< D >& mask, const Position< D >& anchor ) const
+{
+  std::vector< Position< D > > anchors( 1, anchor );
+  if ( periodic_.any() )
   {
-    Box< D > mask_bb = mask_->get_bbox();
+    Box< D > mask_bb = mask.get_bbox();
 
     // Move lower left corner of mask into main image of layer
     for ( int i = 0; i < D; ++i )
     {
-      if ( ntree_->periodic_[ i ] )
+      if ( periodic_[ i ] )
       {
-        anchor_[ i ] =
-          nest::mod( anchor_[ i ] + mask_bb.lower_left[ i ] - ntree_->lower_left_[ i ], ntree_->extent_[ i ] )
-          - mask_bb.lower_left[ i ] + ntree_->lower_left_[ i ];
+        anchors[ 0 ][ i ] = nest::mod( anchor[ i ] + mask_bb.lower_left[ i ] - lower_left_[ i ], extent_[ i ] )
+          - mask_bb.lower_left[ i ] + lower_left_[ i ];
       }
     }
-    anchors_.push_back( anchor_ );
 
     // Add extra anchors for each dimension where this is needed
     // (Assumes that the mask is not wider than the layer)
     for ( int i = 0; i < D; ++i )
     {
-      if ( ntree_->periodic_[ i ] )
+      if ( periodic_[ i ] )
       {
-        int n = anchors_.size();
-        if ( ( anchor_[ i ] + mask_bb.upper_right[ i ] - ntree_->lower_left_[ i ] ) > ntree_->extent_[ i ] )
+        int n = anchors.size();
+        if ( ( anchors[ 0 ][ i ] + mask_bb.upper_right[ i ] - lower_left_[ i ] ) > extent_[ i ] )
         {
           for ( int j = 0; j < n; ++j )
           {
-            Position< D > p = anchors_[ j ];
-            p[ i ] -= ntree_->extent_[ i ];
-            anchors_.push_back( p );
+            Position< D > p = anchors[ j ];
+            p[ i ] -= extent_[ i ];
+            anchors.push_back( p );
           }
         }
       }
     }
   }
-
-  init_();
+  return anchors;
 }
 
 template < int D, class T, int max_capacity, int max_depth >
@@ -453,23 +460,7 @@ template < int D, class T, int max_capacity, int max_depth >
 typename Ntree< D, T, max_capacity, max_depth >::iterator
 Ntree< D, T, max_capacity, max_depth >::insert( Position< D > pos, const T& node )
 {
-  if ( periodic_.any() )
-  {
-    // Map position into standard range when using periodic b.c. Only necessary when
-    // inserting positions during source driven connect when target has periodic b.c.
-    // May be inefficient.
-    for ( int i = 0; i < D; ++i )
-    {
-      if ( periodic_[ i ] )
-      {
-        pos[ i ] = lower_left_[ i ] + std::fmod( pos[ i ] - lower_left_[ i ], extent_[ i ] );
-        if ( pos[ i ] < lower_left_[ i ] )
-        {
-          pos[ i ] += extent_[ i ];
-        }
-      }
-    }
-  }
+  wrap_position_( pos );
 
   if ( leaf_ and ( nodes_.size() >= max_capacity ) and my_depth_ < max_depth )
   {
@@ -500,10 +491,213 @@ Ntree< D, T, max_capacity, max_depth >::insert( Position< D > pos, const T& node
 
 template < int D, class T, int max_capacity, int max_depth >
 void
-Ntree< D, T, max_capacity, max_depth >::split_()
+Ntree< D, T, max_capacity, max_depth >::insert_bulk( std::vector< value_type > nodes )
 {
-  assert( leaf_ );
+  assert( leaf_ and nodes_.empty() );
+
+  for ( auto& node : nodes )
+  {
+    wrap_position_( node.first );
+  }
+
+  // Split the top levels sequentially until there are enough subtrees to
+  // build in parallel.
+  const size_t min_num_subtrees = 64;
+  std::vector< std::tuple< Ntree*, size_t, size_t > > subtrees( 1, std::make_tuple( this, 0, nodes.size() ) );
+  bool split = true;
+  while ( split and subtrees.size() < min_num_subtrees )
+  {
+    split = false;
+    std::vector< std::tuple< Ntree*, size_t, size_t > > next_subtrees;
+    for ( const auto& subtree : subtrees )
+    {
+      Ntree* const tree = std::get< 0 >( subtree );
+      const size_t begin = std::get< 1 >( subtree );
+      const size_t end = std::get< 2 >( subtree );
+      if ( end - begin <= static_cast< size_t >( max_capacity ) or tree->my_depth_ >= max_depth )
+      {
+        next_subtrees.push_back( subtree );
+        continue;
+      }
+
+      const std::array< size_t, N + 1 > bounds = tree->partition_( nodes, begin, end );
+      for ( int j = 0; j < N; ++j )
+      {
+        next_subtrees.push_back( std::make_tuple( tree->children_[ j ], bounds[ j ], bounds[ j + 1 ] ) );
+      }
+      split = true;
+    }
+    subtrees.swap( next_subtrees );
+  }
+
+  // Subtrees cover disjoint ranges of nodes and can be built independently.
+#pragma omp parallel for schedule( dynamic )
+  for ( long i = 0; i < static_cast< long >( subtrees.size() ); ++i )
+  {
+    std::get< 0 >( subtrees[ i ] )->build_( nodes, std::get< 1 >( subtrees[ i ] ), std::get< 2 >( subtrees[ i ] ) );
+  }
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+template < class SumCounts >
+void
+Ntree< D, T, max_capacity, max_depth >::insert_bulk( std::vector< value_type > nodes,
+  std::vector< value_type > counted,
+  SumCounts sum_counts )
+{
+  assert( leaf_ and nodes_.empty() );
+
+  for ( auto& node : nodes )
+  {
+    wrap_position_( node.first );
+  }
+  for ( auto& node : counted )
+  {
+    wrap_position_( node.first );
+  }
+
+  // Subtrees of the current level with their ranges in nodes and counted.
+  struct Subtree
+  {
+    Ntree* tree;
+    size_t begin;
+    size_t end;
+    size_t counted_begin;
+    size_t counted_end;
+  };
+  std::vector< Subtree > subtrees( 1, Subtree { this, 0, nodes.size(), 0, counted.size() } );
+  std::vector< double > counts( 1, counted.size() );
+  sum_counts( counts );
+
+  // The ntree is built level by level, so that the numbers of nodes in all
+  // subtrees of a level are summed at once. All processes obtain the same
+  // sums and thus split the same subtrees.
+  while ( not subtrees.empty() )
+  {
+    std::vector< Subtree > next_subtrees;
+    std::vector< double > next_counts;
+    for ( size_t i = 0; i < subtrees.size(); ++i )
+    {
+      const Subtree& subtree = subtrees[ i ];
+      if ( counts[ i ] <= max_capacity or subtree.tree->my_depth_ >= max_depth )
+      {
+        subtree.tree->nodes_.assign( nodes.begin() + subtree.begin, nodes.begin() + subtree.end );
+        continue;
+      }
+
+      const std::array< size_t, N + 1 > bounds = subtree.tree->partition_( nodes, subtree.begin, subtree.end );
+      const std::array< size_t, N + 1 > counted_bounds =
+        subtree.tree->sort_by_subquad_( counted, subtree.counted_begin, subtree.counted_end );
+      for ( int j = 0; j < N; ++j )
+      {
+        next_subtrees.push_back( Subtree {
+          subtree.tree->children_[ j ], bounds[ j ], bounds[ j + 1 ], counted_bounds[ j ], counted_bounds[ j + 1 ] } );
+        next_counts.push_back( counted_bounds[ j + 1 ] - counted_bounds[ j ] );
+      }
+    }
+
+    if ( not next_subtrees.empty() )
+    {
+      sum_counts( next_counts );
+    }
+    subtrees.swap( next_subtrees );
+    counts.swap( next_counts );
+  }
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+void
+Ntree< D, T, max_capacity, max_depth >::wrap_position_( Position< D >& pos ) const
+{
+  if ( periodic_.any() )
+  {
+    // Map position into standard range when using periodic b.c. Only necessary when
+    // inserting positions during source driven connect when target has periodic b.c.
+    // May be inefficient.
+    for ( int i = 0; i < D; ++i )
+    {
+      if ( periodic_[ i ] )
+      {
+        pos[ i ] = lower_left_[ i ] + std::fmod( pos[ i ] - lower_left_[ i ], extent_[ i ] );
+        if ( pos[ i ] < lower_left_[ i ] )
+        {
+          pos[ i ] += extent_[ i ];
+        }
+      }
+    }
+  }
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+std::array< size_t, Ntree< D, T, max_capacity, max_depth >::N + 1 >
+Ntree< D, T, max_capacity, max_depth >::partition_( std::vector< value_type >& nodes,
+  const size_t begin,
+  const size_t end )
+{
+  assert( leaf_ and nodes_.empty() );
+
+  create_children_();
+  leaf_ = false;
+
+  return sort_by_subquad_( nodes, begin, end );
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+std::array< size_t, Ntree< D, T, max_capacity, max_depth >::N + 1 >
+Ntree< D, T, max_capacity, max_depth >::sort_by_subquad_( std::vector< value_type >& nodes,
+  const size_t begin,
+  const size_t end )
+{
+  // Counting sort by subquad, which keeps the order of nodes within each subquad.
+  std::vector< int > subquads( end - begin );
+  std::array< size_t, N + 1 > bounds;
+  bounds.fill( 0 );
+  for ( size_t i = begin; i < end; ++i )
+  {
+    subquads[ i - begin ] = subquad_( nodes[ i ].first );
+    ++bounds[ subquads[ i - begin ] + 1 ];
+  }
+
+  bounds[ 0 ] = begin;
+  for ( int j = 0; j < N; ++j )
+  {
+    bounds[ j + 1 ] += bounds[ j ];
+  }
+
+  std::vector< value_type > sorted( end - begin );
+  std::array< size_t, N + 1 > next = bounds;
+  for ( size_t i = begin; i < end; ++i )
+  {
+    sorted[ next[ subquads[ i - begin ] ]++ - begin ] = nodes[ i ];
+  }
+  std::copy( sorted.begin(), sorted.end(), nodes.begin() + begin );
+
+  return bounds;
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+void
+Ntree< D, T, max_capacity, max_depth >::build_( std::vector< value_type >& nodes, const size_t begin, const size_t end )
+{
+  // insert() splits a leaf when inserting into a full leaf, so a subtree is a
+  // leaf exactly if it contains at most max_capacity nodes.
+  if ( end - begin <= static_cast< size_t >( max_capacity ) or my_depth_ >= max_depth )
+  {
+    nodes_.assign( nodes.begin() + begin, nodes.begin() + end );
+    return;
+  }
 
+  const std::array< size_t, N + 1 > bounds = partition_( nodes, begin, end );
+  for ( int j = 0; j < N; ++j )
+  {
+    children_[ j ]->build_( nodes, bounds[ j ], bounds[ j + 1 ] );
+  }
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+void
+Ntree< D, T, max_capacity, max_depth >::create_children_()
+{
   for ( int j = 0; j < N; ++j )
   {
     Position< D > lower_left = lower_left_;
@@ -517,6 +711,15 @@ Ntree< D, T, max_capacity, max_depth >::split_()
 
     children_[ j ] = new Ntree< D, T, max_capacity, max_depth >( lower_left, extent_ * 0.5, 0, this, j );
   }
+}
+
+template < int D, class T, int max_capacity, int max_depth >
+void
+Ntree< D, T, max_capacity, max_depth >::split_()
+{
+  assert( leaf_ );
+
+  create_children_();
 
   for ( typename std::vector< std::pair< Position< D >, T > >::iterator i = nodes_.begin(); i != nodes_.end(); ++i )
   {
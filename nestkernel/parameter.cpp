@@ -168,6 +168,23 @@ NodePosParameter::get_node_pos_( Node* node ) const
   return pos[ dimension_ ];
 }
 
+bool
+NodePosParameter::compile( ParameterProgram& program ) const
+{
+  // Positions of nodes that are not connected cannot be compiled, as they depend on the node.
+  switch ( synaptic_endpoint_ )
+  {
+  case 1:
+    program.append( ParameterProgram::OpCode::SOURCE_POSITION, dimension_ );
+    return true;
+  case 2:
+    program.append( ParameterProgram::OpCode::TARGET_POSITION, dimension_ );
+    return true;
+  default:
+    return false;
+  }
+}
+
 double
 SpatialDistanceParameter::value( RngPtr,
   const std::vector< double >& source_pos,
@@ -200,6 +217,24 @@ SpatialDistanceParameter::value( RngPtr,
   }
 }
 
+bool
+SpatialDistanceParameter::compile( ParameterProgram& program ) const
+{
+  switch ( dimension_ )
+  {
+  case 0:
+    program.append( ParameterProgram::OpCode::DISTANCE );
+    return true;
+  case 1:
+  case 2:
+  case 3:
+    program.append( ParameterProgram::OpCode::DISPLACEMENT, dimension_ - 1 );
+    return true;
+  default:
+    return false;
+  }
+}
+
 RedrawParameter::RedrawParameter( const std::shared_ptr< Parameter > p, const double min, const double max )
   : Parameter( p->is_spatial() )
   , p_( p )
@@ -32,6 +32,7 @@
 #include "nest_types.h"
 #include "nestmodule.h"
 #include "node_collection.h"
+#include "parameter_program.h"
 #include "random_generators.h"
 
 // Includes from libnestutil:
@@ -93,6 +94,22 @@ public:
     const AbstractLayer& layer,
     Node* node );
 
+  /**
+   * Appends instructions evaluating this parameter on batches of candidate connections to program.
+   *
+   * Only parameters that draw no random numbers and do not depend on node
+   * properties can be compiled.
+   * @returns false if the parameter cannot be compiled. The program must then be discarded.
+   */
+  virtual bool compile( ParameterProgram& program ) const;
+
+  /**
+   * Returns an upper bound of all values the parameter can take.
+   *
+   * @returns infinity if no finite bound is known.
+   */
+  virtual double upper_bound() const;
+
   /**
    * Applies a parameter on a single-node ID NodeCollection and given array of positions.
    *
@@ -165,6 +182,19 @@ public:
     return value_;
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    program.append( ParameterProgram::OpCode::CONSTANT, 0, { value_ } );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return value_;
+  }
+
 private:
   double value_;
 };
@@ -209,6 +239,12 @@ public:
     return lower_ + rng->drand() * range_;
   }
 
+  double
+  upper_bound() const override
+  {
+    return lower_ + range_;
+  }
+
 private:
   double lower_, range_;
 };
@@ -246,6 +282,12 @@ public:
     return rng->ulrand( max_ );
   }
 
+  double
+  upper_bound() const override
+  {
+    return max_ - 1;
+  }
+
 private:
   double max_;
 };
@@ -412,6 +454,8 @@ public:
     throw KernelException( "Wrong synaptic_endpoint_." );
   }
 
+  bool compile( ParameterProgram& program ) const override;
+
 private:
   int dimension_;
   int synaptic_endpoint_;
@@ -449,6 +493,8 @@ public:
     const AbstractLayer& layer,
     Node* ) override;
 
+  bool compile( ParameterProgram& program ) const override;
+
 private:
   int dimension_;
 };
@@ -499,6 +545,17 @@ public:
       * parameter2_->value( rng, source_pos, target_pos, layer, node );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( parameter1_->compile( program ) and parameter2_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::MULTIPLY );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const parameter1_;
   std::shared_ptr< Parameter > const parameter2_;
@@ -549,6 +606,17 @@ public:
       / parameter2_->value( rng, source_pos, target_pos, layer, node );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( parameter1_->compile( program ) and parameter2_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::DIVIDE );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const parameter1_;
   std::shared_ptr< Parameter > const parameter2_;
@@ -599,6 +667,23 @@ public:
       + parameter2_->value( rng, source_pos, target_pos, layer, node );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( parameter1_->compile( program ) and parameter2_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::ADD );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return parameter1_->upper_bound() + parameter2_->upper_bound();
+  }
+
 protected:
   std::shared_ptr< Parameter > const parameter1_;
   std::shared_ptr< Parameter > const parameter2_;
@@ -649,6 +734,17 @@ public:
       - parameter2_->value( rng, source_pos, target_pos, layer, node );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( parameter1_->compile( program ) and parameter2_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::SUBTRACT );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const parameter1_;
   std::shared_ptr< Parameter > const parameter2_;
@@ -717,6 +813,17 @@ public:
       parameter2_->value( rng, source_pos, target_pos, layer, node ) );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( parameter1_->compile( program ) and parameter2_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::COMPARE, comparator_ );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const parameter1_;
   std::shared_ptr< Parameter > const parameter2_;
@@ -809,6 +916,26 @@ public:
     }
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    // Both branches are evaluated for all candidates, which is only
+    // equivalent to evaluating one of them because compiled parameters
+    // have no side effects.
+    if ( not( condition_->compile( program ) and if_true_->compile( program ) and if_false_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::SELECT );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return std::max( if_true_->upper_bound(), if_false_->upper_bound() );
+  }
+
 protected:
   std::shared_ptr< Parameter > const condition_;
   std::shared_ptr< Parameter > const if_true_;
@@ -860,6 +987,23 @@ public:
     return std::min( p_->value( rng, source_pos, target_pos, layer, node ), other_value_ );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::MIN, 0, { other_value_ } );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return std::min( p_->upper_bound(), other_value_ );
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   double other_value_;
@@ -909,6 +1053,23 @@ public:
     return std::max( p_->value( rng, source_pos, target_pos, layer, node ), other_value_ );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::MAX, 0, { other_value_ } );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return std::max( p_->upper_bound(), other_value_ );
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   double other_value_;
@@ -946,6 +1107,12 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  double
+  upper_bound() const override
+  {
+    return max_;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   double min_;
@@ -995,6 +1162,23 @@ public:
     return std::exp( p_->value( rng, source_pos, target_pos, layer, node ) );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::EXP );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return std::exp( p_->upper_bound() );
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
 };
@@ -1041,6 +1225,23 @@ public:
     return std::sin( p_->value( rng, source_pos, target_pos, layer, node ) );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::SIN );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return 1.0;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
 };
@@ -1086,6 +1287,23 @@ public:
     return std::cos( p_->value( rng, source_pos, target_pos, layer, node ) );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::COS );
+    return true;
+  }
+
+  double
+  upper_bound() const override
+  {
+    return 1.0;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
 };
@@ -1134,6 +1352,17 @@ public:
     return std::pow( p_->value( rng, source_pos, target_pos, layer, node ), exponent_ );
   }
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::POW, 0, { exponent_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   const double exponent_;
@@ -1263,6 +1492,17 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::EXP_DIST, 0, { inv_beta_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   const double inv_beta_;
@@ -1307,6 +1547,17 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::GAUSSIAN, 0, { mean_, inv_two_std2_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   const double mean_;
@@ -1356,6 +1607,18 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( px_->compile( program ) and py_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append(
+      ParameterProgram::OpCode::GAUSSIAN_2D, 0, { mean_x_, mean_y_, x_term_const_, y_term_const_, xy_term_const_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const px_;
   std::shared_ptr< Parameter > const py_;
@@ -1407,6 +1670,17 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not( px_->compile( program ) and py_->compile( program ) ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::GABOR, 0, { cos_, sin_, gamma_, inv_two_std2_, lambda_, psi_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const px_;
   std::shared_ptr< Parameter > const py_;
@@ -1458,6 +1732,17 @@ public:
     const AbstractLayer& layer,
     Node* node ) override;
 
+  bool
+  compile( ParameterProgram& program ) const override
+  {
+    if ( not p_->compile( program ) )
+    {
+      return false;
+    }
+    program.append( ParameterProgram::OpCode::GAMMA, 0, { kappa_, inv_theta_, delta_ } );
+    return true;
+  }
+
 protected:
   std::shared_ptr< Parameter > const p_;
   const double kappa_;
@@ -1475,6 +1760,18 @@ Parameter::value( RngPtr rng,
   return value( rng, node );
 }
 
+inline bool
+Parameter::compile( ParameterProgram& ) const
+{
+  return false;
+}
+
+inline double
+Parameter::upper_bound() const
+{
+  return std::numeric_limits< double >::infinity();
+}
+
 inline bool
 Parameter::is_spatial() const
 {
@@ -0,0 +1,433 @@
+/*
+ *  parameter_program.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "parameter_program.h"
+
+// C++ includes:
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Includes from libnestutil:
+#include "numerics.h"
+
+// Includes from nestkernel:
+#include "exceptions.h"
+
+namespace nest
+{
+
+ParameterBatch::ParameterBatch( const size_t num_dimensions )
+  : source_pos( num_dimensions )
+  , displacement( num_dimensions )
+  , size_( 0 )
+{
+}
+
+void
+ParameterBatch::clear()
+{
+  for ( auto& column : source_pos )
+  {
+    column.clear();
+  }
+  for ( auto& column : displacement )
+  {
+    column.clear();
+  }
+  size_ = 0;
+}
+
+void
+ParameterBatch::add( const std::vector< double >& pos, const std::vector< double >& displ )
+{
+  for ( size_t dim = 0; dim < source_pos.size(); ++dim )
+  {
+    source_pos[ dim ].push_back( pos[ dim ] );
+  }
+  for ( size_t dim = 0; dim < displ.size(); ++dim )
+  {
+    displacement[ dim ].push_back( displ[ dim ] );
+  }
+  ++size_;
+}
+
+ParameterProgram::ParameterProgram()
+  : num_dimensions_( 0 )
+  , max_depth_( 0 )
+  , depth_( 0 )
+  , uses_displacement_( false )
+{
+}
+
+void
+ParameterProgram::append( const OpCode op, const int arg, const std::array< double, 6 >& c )
+{
+  switch ( op )
+  {
+  case OpCode::SOURCE_POSITION:
+  case OpCode::TARGET_POSITION:
+    num_dimensions_ = std::max( num_dimensions_, static_cast< size_t >( arg ) + 1 );
+    ++depth_;
+    break;
+  case OpCode::DISPLACEMENT:
+    num_dimensions_ = std::max( num_dimensions_, static_cast< size_t >( arg ) + 1 );
+    uses_displacement_ = true;
+    ++depth_;
+    break;
+  case OpCode::DISTANCE:
+    uses_displacement_ = true;
+    ++depth_;
+    break;
+  case OpCode::CONSTANT:
+    ++depth_;
+    break;
+  case OpCode::ADD:
+  case OpCode::SUBTRACT:
+  case OpCode::MULTIPLY:
+  case OpCode::DIVIDE:
+  case OpCode::COMPARE:
+  case OpCode::GAUSSIAN_2D:
+  case OpCode::GABOR:
+    assert( depth_ >= 2 );
+    --depth_;
+    break;
+  case OpCode::SELECT:
+    assert( depth_ >= 3 );
+    depth_ -= 2;
+    break;
+  default:
+    assert( depth_ >= 1 );
+    break;
+  }
+  max_depth_ = std::max( max_depth_, depth_ );
+  instructions_.push_back( { op, arg, c } );
+}
+
+void
+ParameterProgram::clear()
+{
+  instructions_.clear();
+  num_dimensions_ = 0;
+  max_depth_ = 0;
+  depth_ = 0;
+  uses_displacement_ = false;
+}
+
+void
+ParameterProgram::evaluate( ParameterBatch& batch, std::vector< double >& values ) const
+{
+  assert( depth_ == 1 );
+  assert( batch.source_pos.size() >= num_dimensions_ );
+
+  const size_t n = batch.size();
+  if ( batch.stack.size() < max_depth_ )
+  {
+    batch.stack.resize( max_depth_ );
+  }
+  for ( size_t k = 0; k < max_depth_; ++k )
+  {
+    batch.stack[ k ].resize( n );
+  }
+
+  // Number of entries on the stack, the top entry is stack[ sp - 1 ]
+  size_t sp = 0;
+  for ( const auto& instr : instructions_ )
+  {
+    const auto& c = instr.c;
+    switch ( instr.op )
+    {
+    case OpCode::CONSTANT:
+    {
+      std::fill( batch.stack[ sp ].begin(), batch.stack[ sp ].end(), c[ 0 ] );
+      ++sp;
+      break;
+    }
+    case OpCode::SOURCE_POSITION:
+    {
+      const std::vector< double >& pos = batch.source_pos[ instr.arg ];
+      std::copy( pos.begin(), pos.end(), batch.stack[ sp ].begin() );
+      ++sp;
+      break;
+    }
+    case OpCode::TARGET_POSITION:
+    {
+      std::fill( batch.stack[ sp ].begin(), batch.stack[ sp ].end(), batch.target_pos[ instr.arg ] );
+      ++sp;
+      break;
+    }
+    case OpCode::DISTANCE:
+    {
+      // Sum the squares in the order of the dimensions, as Layer::compute_distance() does.
+      double* const out = batch.stack[ sp ].data();
+      std::fill( out, out + n, 0.0 );
+      for ( const auto& column : batch.displacement )
+      {
+        const double* const displ = column.data();
+#pragma omp simd
+        for ( size_t i = 0; i < n; ++i )
+        {
+          out[ i ] += displ[ i ] * displ[ i ];
+        }
+      }
+      for ( size_t i = 0; i < n; ++i )
+      {
+        out[ i ] = std::sqrt( out[ i ] );
+      }
+      ++sp;
+      break;
+    }
+    case OpCode::DISPLACEMENT:
+    {
+      double* const out = batch.stack[ sp ].data();
+      const double* const displ = batch.displacement[ instr.arg ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        out[ i ] = std::abs( displ[ i ] );
+      }
+      ++sp;
+      break;
+    }
+    case OpCode::ADD:
+    {
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = x[ i ] + y[ i ];
+      }
+      break;
+    }
+    case OpCode::SUBTRACT:
+    {
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = x[ i ] - y[ i ];
+      }
+      break;
+    }
+    case OpCode::MULTIPLY:
+    {
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = x[ i ] * y[ i ];
+      }
+      break;
+    }
+    case OpCode::DIVIDE:
+    {
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = x[ i ] / y[ i ];
+      }
+      break;
+    }
+    case OpCode::COMPARE:
+    {
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        switch ( instr.arg )
+        {
+        case 0:
+          x[ i ] = x[ i ] < y[ i ];
+          break;
+        case 1:
+          x[ i ] = x[ i ] <= y[ i ];
+          break;
+        case 2:
+          x[ i ] = x[ i ] == y[ i ];
+          break;
+        case 3:
+          x[ i ] = x[ i ] != y[ i ];
+          break;
+        case 4:
+          x[ i ] = x[ i ] >= y[ i ];
+          break;
+        case 5:
+          x[ i ] = x[ i ] > y[ i ];
+          break;
+        default:
+          throw KernelException( "Wrong comparison operator." );
+        }
+      }
+      break;
+    }
+    case OpCode::SELECT:
+    {
+      sp -= 2;
+      double* const cond = batch.stack[ sp - 1 ].data();
+      const double* const if_true = batch.stack[ sp ].data();
+      const double* const if_false = batch.stack[ sp + 1 ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        cond[ i ] = cond[ i ] ? if_true[ i ] : if_false[ i ];
+      }
+      break;
+    }
+    case OpCode::MIN:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::min( x[ i ], c[ 0 ] );
+      }
+      break;
+    }
+    case OpCode::MAX:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+#pragma omp simd
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::max( x[ i ], c[ 0 ] );
+      }
+      break;
+    }
+    case OpCode::EXP:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::exp( x[ i ] );
+      }
+      break;
+    }
+    case OpCode::SIN:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::sin( x[ i ] );
+      }
+      break;
+    }
+    case OpCode::COS:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::cos( x[ i ] );
+      }
+      break;
+    }
+    case OpCode::POW:
+    {
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::pow( x[ i ], c[ 0 ] );
+      }
+      break;
+    }
+    case OpCode::EXP_DIST:
+    {
+      // c: inv_beta
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::exp( -x[ i ] * c[ 0 ] );
+      }
+      break;
+    }
+    case OpCode::GAUSSIAN:
+    {
+      // c: mean, inv_two_std2
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        const auto dx = x[ i ] - c[ 0 ];
+        x[ i ] = std::exp( -dx * dx * c[ 1 ] );
+      }
+      break;
+    }
+    case OpCode::GAUSSIAN_2D:
+    {
+      // c: mean_x, mean_y, x_term_const, y_term_const, xy_term_const
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        const auto dx = x[ i ] - c[ 0 ];
+        const auto dy = y[ i ] - c[ 1 ];
+        x[ i ] = std::exp( -dx * dx * c[ 2 ] - dy * dy * c[ 3 ] + dx * dy * c[ 4 ] );
+      }
+      break;
+    }
+    case OpCode::GABOR:
+    {
+      // c: cos, sin, gamma, inv_two_std2, lambda, psi
+      --sp;
+      double* const x = batch.stack[ sp - 1 ].data();
+      const double* const y = batch.stack[ sp ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        const auto dx = x[ i ];
+        const auto dy = y[ i ];
+        const auto dx_prime = dx * c[ 0 ] + dy * c[ 1 ];
+        const auto dy_prime = -dx * c[ 1 ] + dy * c[ 0 ];
+        const auto gabor_exp =
+          std::exp( -c[ 2 ] * c[ 2 ] * dx_prime * dx_prime * c[ 3 ] - dy_prime * dy_prime * c[ 3 ] );
+        const auto gabor_cos_plus =
+          std::max( std::cos( 2 * numerics::pi * dy_prime / c[ 4 ] + c[ 5 ] * numerics::pi / 180. ), 0. );
+        x[ i ] = gabor_exp * gabor_cos_plus;
+      }
+      break;
+    }
+    case OpCode::GAMMA:
+    {
+      // c: kappa, inv_theta, delta
+      double* const x = batch.stack[ sp - 1 ].data();
+      for ( size_t i = 0; i < n; ++i )
+      {
+        x[ i ] = std::pow( x[ i ], c[ 0 ] - 1. ) * std::exp( -1. * c[ 1 ] * x[ i ] ) * c[ 2 ];
+      }
+      break;
+    }
+    }
+  }
+  assert( sp == 1 );
+
+  values.assign( batch.stack[ 0 ].begin(), batch.stack[ 0 ].begin() + n );
+}
+
+} // namespace nest
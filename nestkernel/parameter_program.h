@@ -0,0 +1,176 @@
+/*
+ *  parameter_program.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PARAMETER_PROGRAM_H
+#define PARAMETER_PROGRAM_H
+
+// C++ includes:
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace nest
+{
+
+/**
+ * Candidate connections to a single target for which a ParameterProgram is
+ * evaluated together.
+ *
+ * For each candidate, the position of the source and the displacement from
+ * source to target, as computed by the source layer, are stored per
+ * dimension in source_pos[ dim ][ i ] and displacement[ dim ][ i ].
+ */
+struct ParameterBatch
+{
+  explicit ParameterBatch( const size_t num_dimensions );
+
+  //! Remove all candidates, keeping the allocated memory.
+  void clear();
+
+  //! Add a candidate with the given source position and displacement.
+  void add( const std::vector< double >& source_pos, const std::vector< double >& displacement );
+
+  size_t
+  size() const
+  {
+    return size_;
+  }
+
+  std::vector< double > target_pos;
+  std::vector< std::vector< double > > source_pos;
+  std::vector< std::vector< double > > displacement;
+
+  //! Intermediate results of ParameterProgram::evaluate(), one per stack entry.
+  std::vector< std::vector< double > > stack;
+
+private:
+  size_t size_;
+};
+
+/**
+ * Linear instruction sequence evaluating a Parameter on batches of candidate connections.
+ *
+ * A Parameter tree is flattened by Parameter::compile() into instructions
+ * for a stack machine in postfix order. Each instruction is applied to all
+ * candidates of a batch in one loop, instead of evaluating the tree by
+ * virtual calls for each candidate.
+ *
+ * Only parameters that do not draw random numbers and do not depend on node
+ * properties can be compiled, so that the random numbers drawn while
+ * connecting are the same as when evaluating the parameter per connection.
+ * Each instruction computes its value with the same expression as the
+ * corresponding Parameter::value(), so that results are identical.
+ */
+class ParameterProgram
+{
+public:
+  enum class OpCode
+  {
+    CONSTANT,        //!< push c[ 0 ]
+    SOURCE_POSITION, //!< push source position in dimension arg
+    TARGET_POSITION, //!< push target position in dimension arg
+    DISTANCE,        //!< push distance between source and target
+    DISPLACEMENT,    //!< push absolute displacement in dimension arg
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    COMPARE,     //!< compare with comparator arg, as in ComparingParameter
+    SELECT,      //!< condition ? if_true : if_false
+    MIN,         //!< std::min( x, c[ 0 ] )
+    MAX,         //!< std::max( x, c[ 0 ] )
+    EXP,         //!< std::exp( x )
+    SIN,         //!< std::sin( x )
+    COS,         //!< std::cos( x )
+    POW,         //!< std::pow( x, c[ 0 ] )
+    EXP_DIST,    //!< as ExpDistParameter
+    GAUSSIAN,    //!< as GaussianParameter
+    GAUSSIAN_2D, //!< as Gaussian2DParameter
+    GABOR,       //!< as GaborParameter
+    GAMMA        //!< as GammaParameter
+  };
+
+  struct Instruction
+  {
+    OpCode op;
+    int arg;
+    std::array< double, 6 > c;
+  };
+
+  ParameterProgram();
+
+  /**
+   * Append an instruction.
+   *
+   * @param op operation
+   * @param arg dimension or comparator, depending on the operation
+   * @param c constants of the operation
+   */
+  void append( const OpCode op, const int arg = 0, const std::array< double, 6 >& c = {} );
+
+  //! Remove all instructions.
+  void clear();
+
+  bool
+  empty() const
+  {
+    return instructions_.empty();
+  }
+
+  /**
+   * Number of spatial dimensions the program requires.
+   *
+   * The program can only be evaluated for layers with at least this many
+   * dimensions.
+   */
+  size_t
+  get_num_dimensions() const
+  {
+    return num_dimensions_;
+  }
+
+  //! Whether the program uses the displacements stored in the batch.
+  bool
+  uses_displacement() const
+  {
+    return uses_displacement_;
+  }
+
+  /**
+   * Evaluate the program for all candidates in batch.
+   *
+   * @param batch candidates, its stack is used for intermediate results
+   * @param values on return, holds one value per candidate
+   */
+  void evaluate( ParameterBatch& batch, std::vector< double >& values ) const;
+
+private:
+  std::vector< Instruction > instructions_;
+  size_t num_dimensions_;
+  size_t max_depth_;
+  size_t depth_;
+  bool uses_displacement_;
+};
+
+} // namespace nest
+
+#endif /* PARAMETER_PROGRAM_H */
@@ -0,0 +1,648 @@
+/*
+ *  recording_backend_binary.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Includes from libnestutil:
+#include "compose.hpp"
+
+// Includes from nestkernel:
+#include "recording_device.h"
+#include "vp_manager_impl.h"
+
+// includes from sli:
+#include "dictutils.h"
+
+#include "recording_backend_binary.h"
+
+const unsigned int nest::RecordingBackendBinary::BINARY_REC_BACKEND_VERSION = 1;
+
+namespace
+{
+
+//! Append the byte representation of value to header.
+template < typename T >
+void
+append_value( std::string& header, const T value )
+{
+  header.append( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+}
+
+//! Append the length of str followed by str to header.
+void
+append_string( std::string& header, const std::string& str )
+{
+  append_value< uint32_t >( header, str.size() );
+  header += str;
+}
+
+} // namespace
+
+nest::RecordingBackendBinary::RecordingBackendBinary()
+  : num_writing_( 0 )
+  , stop_( false )
+  , chunk_size_( P_.chunk_size_ )
+{
+}
+
+nest::RecordingBackendBinary::~RecordingBackendBinary() throw()
+{
+  stop_writer_();
+}
+
+void
+nest::RecordingBackendBinary::initialize()
+{
+  data_map tmp( kernel().vp_manager.get_num_threads() );
+  device_data_.swap( tmp );
+}
+
+void
+nest::RecordingBackendBinary::finalize()
+{
+  stop_writer_();
+}
+
+void
+nest::RecordingBackendBinary::enroll( const RecordingDevice& device, const DictionaryDatum& params )
+{
+  const size_t t = device.get_thread();
+  const size_t node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    std::string vp_node_id_string = compute_vp_node_id_string_( device );
+    std::string modelname = device.get_name();
+    auto p = device_data_[ t ].insert( std::make_pair( node_id, DeviceData( modelname, vp_node_id_string ) ) );
+    device_data = p.first;
+  }
+
+  device_data->second.set_status( params );
+}
+
+void
+nest::RecordingBackendBinary::disenroll( const RecordingDevice& device )
+{
+  const size_t t = device.get_thread();
+  const size_t node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    // The writer thread must not hold chunks referring to the file of the device
+    device_data->second.submit_chunk( *this );
+    wait_for_writer_();
+    device_data_[ t ].erase( device_data );
+  }
+}
+
+void
+nest::RecordingBackendBinary::set_value_names( const RecordingDevice& device,
+  const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  const size_t t = device.get_thread();
+  const size_t node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  assert( device_data != device_data_[ t ].end() );
+  device_data->second.set_value_names( double_value_names, long_value_names );
+}
+
+void
+nest::RecordingBackendBinary::pre_run_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendBinary::post_run_hook()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.submit_chunk( *this );
+    }
+  }
+
+  wait_for_writer_();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.flush_file();
+    }
+  }
+}
+
+void
+nest::RecordingBackendBinary::post_step_hook()
+{
+  // nothing to do
+}
+
+void
+nest::RecordingBackendBinary::prepare()
+{
+  chunk_size_ = P_.chunk_size_;
+
+  bool has_devices = false;
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_info : inner )
+    {
+      device_info.second.open_file( *this );
+      has_devices = true;
+    }
+  }
+
+  if ( has_devices and not writer_.joinable() )
+  {
+    writer_ = std::thread( &RecordingBackendBinary::write_chunks_, this );
+  }
+}
+
+void
+nest::RecordingBackendBinary::cleanup()
+{
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.submit_chunk( *this );
+    }
+  }
+
+  stop_writer_();
+
+  for ( auto& inner : device_data_ )
+  {
+    for ( auto& device_data : inner )
+    {
+      device_data.second.close_file();
+    }
+  }
+
+  free_.clear();
+}
+
+void
+nest::RecordingBackendBinary::write( const RecordingDevice& device,
+  const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values )
+{
+  const size_t t = device.get_thread();
+  const size_t node_id = device.get_node_id();
+
+  data_map::value_type::iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data == device_data_[ t ].end() )
+  {
+    return;
+  }
+
+  device_data->second.write( event, double_values, long_values, *this );
+}
+
+const std::string
+nest::RecordingBackendBinary::compute_vp_node_id_string_( const RecordingDevice& device ) const
+{
+  const double num_vps = kernel().vp_manager.get_num_virtual_processes();
+  const double num_nodes = kernel().node_manager.size();
+  const int vp_digits = static_cast< int >( std::floor( std::log10( num_vps ) ) + 1 );
+  const int node_id_digits = static_cast< int >( std::floor( std::log10( num_nodes ) ) + 1 );
+
+  std::ostringstream vp_node_id_string;
+  vp_node_id_string << "-" << std::setfill( '0' ) << std::setw( node_id_digits ) << device.get_node_id() << "-"
+                    << std::setfill( '0' ) << std::setw( vp_digits ) << device.get_vp();
+
+  return vp_node_id_string.str();
+}
+
+std::unique_ptr< nest::RecordingBackendBinary::Chunk >
+nest::RecordingBackendBinary::get_chunk_( std::ofstream& file, const size_t num_columns )
+{
+  std::unique_ptr< Chunk > chunk;
+
+  {
+    std::lock_guard< std::mutex > lock( mutex_ );
+    for ( auto it = free_.begin(); it != free_.end(); ++it )
+    {
+      if ( ( *it )->capacity == chunk_size_ and ( *it )->data.size() == chunk_size_ * num_columns )
+      {
+        chunk = std::move( *it );
+        *it = std::move( free_.back() );
+        free_.pop_back();
+        break;
+      }
+    }
+  }
+
+  if ( not chunk )
+  {
+    chunk.reset( new Chunk( chunk_size_, num_columns ) );
+  }
+
+  chunk->file = &file;
+  chunk->size = 0;
+  return chunk;
+}
+
+void
+nest::RecordingBackendBinary::submit_chunk_( std::unique_ptr< Chunk > chunk )
+{
+  const size_t max_pending_chunks = P_.max_pending_chunks_;
+
+  std::unique_lock< std::mutex > lock( mutex_ );
+  chunk_written_.wait( lock, [ this, max_pending_chunks ] { return queued_.size() < max_pending_chunks; } );
+  queued_.push_back( std::move( chunk ) );
+  lock.unlock();
+
+  chunk_queued_.notify_one();
+}
+
+void
+nest::RecordingBackendBinary::wait_for_writer_()
+{
+  std::unique_lock< std::mutex > lock( mutex_ );
+  chunk_written_.wait( lock, [ this ] { return queued_.empty() and num_writing_ == 0; } );
+}
+
+void
+nest::RecordingBackendBinary::stop_writer_()
+{
+  if ( not writer_.joinable() )
+  {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock( mutex_ );
+    stop_ = true;
+  }
+  chunk_queued_.notify_one();
+
+  writer_.join();
+  stop_ = false;
+}
+
+void
+nest::RecordingBackendBinary::write_chunks_()
+{
+  std::unique_lock< std::mutex > lock( mutex_ );
+  while ( true )
+  {
+    chunk_queued_.wait( lock, [ this ] { return stop_ or not queued_.empty(); } );
+    if ( queued_.empty() )
+    {
+      return; // stop_ is set and all chunks are written
+    }
+
+    std::unique_ptr< Chunk > chunk = std::move( queued_.front() );
+    queued_.pop_front();
+    ++num_writing_;
+    lock.unlock();
+
+    chunk->write_block();
+
+    lock.lock();
+    --num_writing_;
+    free_.push_back( std::move( chunk ) );
+    chunk_written_.notify_all();
+  }
+}
+
+void
+nest::RecordingBackendBinary::set_status( const DictionaryDatum& d )
+{
+  Parameters_ ptmp = P_; // temporary copy in case of errors
+  ptmp.set( *this, d );  // throws if BadProperty
+
+  // if we get here, temporaries contain consistent set of properties
+  P_ = ptmp;
+}
+
+void
+nest::RecordingBackendBinary::get_status( DictionaryDatum& d ) const
+{
+  P_.get( *this, d );
+}
+
+void
+nest::RecordingBackendBinary::check_device_status( const DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.set_status( params ); // throws if params contains invalid entries
+}
+
+void
+nest::RecordingBackendBinary::get_device_defaults( DictionaryDatum& params ) const
+{
+  DeviceData dd( "", "" );
+  dd.get_status( params );
+}
+
+void
+nest::RecordingBackendBinary::get_device_status( const nest::RecordingDevice& device, DictionaryDatum& d ) const
+{
+  const size_t t = device.get_thread();
+  const size_t node_id = device.get_node_id();
+
+  data_map::value_type::const_iterator device_data = device_data_[ t ].find( node_id );
+  if ( device_data != device_data_[ t ].end() )
+  {
+    device_data->second.get_status( d );
+  }
+}
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+nest::RecordingBackendBinary::Parameters_::Parameters_()
+  : chunk_size_( 4096 )
+  , max_pending_chunks_( 64 )
+{
+}
+
+void
+nest::RecordingBackendBinary::Parameters_::get( const RecordingBackendBinary&, DictionaryDatum& d ) const
+{
+  ( *d )[ names::chunk_size ] = chunk_size_;
+  ( *d )[ names::max_pending_chunks ] = max_pending_chunks_;
+}
+
+void
+nest::RecordingBackendBinary::Parameters_::set( const RecordingBackendBinary&, const DictionaryDatum& d )
+{
+  updateValue< long >( d, names::chunk_size, chunk_size_ );
+  updateValue< long >( d, names::max_pending_chunks, max_pending_chunks_ );
+
+  if ( chunk_size_ < 1 )
+  {
+    throw BadProperty( "chunk_size must be positive." );
+  }
+  if ( max_pending_chunks_ < 1 )
+  {
+    throw BadProperty( "max_pending_chunks must be positive." );
+  }
+}
+
+/* ******************* Chunk of records ******************* */
+
+nest::RecordingBackendBinary::Chunk::Chunk( const size_t capacity, const size_t num_columns )
+  : file( nullptr )
+  , capacity( capacity )
+  , size( 0 )
+  , data( capacity * num_columns )
+{
+}
+
+void
+nest::RecordingBackendBinary::Chunk::write_block() const
+{
+  const uint64_t num_records = size;
+  file->write( reinterpret_cast< const char* >( &num_records ), sizeof( num_records ) );
+
+  for ( size_t offset = 0; offset < data.size(); offset += capacity )
+  {
+    file->write( reinterpret_cast< const char* >( &data[ offset ] ), size * sizeof( uint64_t ) );
+  }
+}
+
+/* ******************* Device meta data class DeviceData ******************* */
+
+nest::RecordingBackendBinary::DeviceData::DeviceData( std::string modelname, std::string vp_node_id_string )
+  : time_in_steps_( false )
+  , modelname_( modelname )
+  , vp_node_id_string_( vp_node_id_string )
+  , file_extension_( "nbin" )
+  , label_( "" )
+{
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_value_names( const std::vector< Name >& double_value_names,
+  const std::vector< Name >& long_value_names )
+{
+  double_value_names_ = double_value_names;
+  long_value_names_ = long_value_names;
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::submit_chunk( RecordingBackendBinary& backend )
+{
+  if ( chunk_ and chunk_->size > 0 )
+  {
+    backend.submit_chunk_( std::move( chunk_ ) );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::flush_file()
+{
+  file_.flush();
+
+  if ( not file_.good() )
+  {
+    std::string msg = String::compose( "I/O error while writing to file '%1'.", compute_filename_() );
+    LOG( M_ERROR, "RecordingBackendBinary::post_run_hook()", msg );
+    throw IOError();
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::open_file( RecordingBackendBinary& backend )
+{
+  std::string filename = compute_filename_();
+
+  std::ifstream test( filename.c_str() );
+  if ( test.good() and not kernel().io_manager.overwrite_files() )
+  {
+    std::string msg = String::compose(
+      "The file '%1' already exists and overwriting files is disabled. To overwrite files, set "
+      "the kernel property overwrite_files to true. To change the name or location of the file, "
+      "change the kernel properties data_path or data_prefix, or the device property label.",
+      filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+  test.close();
+
+  file_ = std::ofstream( filename.c_str(), std::ios::binary );
+
+  if ( not file_.good() )
+  {
+    std::string msg = String::compose( "I/O error while opening file '%1'.", filename );
+    LOG( M_ERROR, "RecordingBackendBinary::prepare()", msg );
+    throw IOError();
+  }
+
+  std::string header( "NESTBIN\0", 8 );
+  append_value< uint32_t >( header, BINARY_REC_BACKEND_VERSION );
+  append_value< uint32_t >( header, 0x01020304 );
+  const size_t header_size_pos = header.size();
+  append_value< uint64_t >( header, 0 ); // header size, filled in below
+  append_string( header, NEST_VERSION );
+
+  append_value< uint32_t >( header, get_num_columns_() );
+  header += 'u';
+  append_string( header, "sender" );
+  if ( time_in_steps_ )
+  {
+    header += 'i';
+    append_string( header, "time_step" );
+    header += 'f';
+    append_string( header, "time_offset" );
+  }
+  else
+  {
+    header += 'f';
+    append_string( header, "time_ms" );
+  }
+  for ( auto& val : double_value_names_ )
+  {
+    header += 'f';
+    append_string( header, val.toString() );
+  }
+  for ( auto& val : long_value_names_ )
+  {
+    header += 'i';
+    append_string( header, val.toString() );
+  }
+
+  // pad the header, so that all values in the file are aligned to eight bytes
+  header.resize( ( header.size() + 7 ) / 8 * 8, '\0' );
+  const uint64_t header_size = header.size();
+  std::memcpy( &header[ header_size_pos ], &header_size, sizeof( header_size ) );
+
+  file_.write( header.data(), header.size() );
+
+  chunk_ = backend.get_chunk_( file_, get_num_columns_() );
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::close_file()
+{
+  chunk_.reset();
+  file_.close();
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::write( const Event& event,
+  const std::vector< double >& double_values,
+  const std::vector< long >& long_values,
+  RecordingBackendBinary& backend )
+{
+  if ( not chunk_ )
+  {
+    chunk_ = backend.get_chunk_( file_, get_num_columns_() );
+  }
+
+  assert( double_values.size() == double_value_names_.size() );
+  assert( long_values.size() == long_value_names_.size() );
+
+  const size_t pos = chunk_->size;
+  size_t column = 0;
+
+  put_( column++, pos, static_cast< uint64_t >( event.get_sender_node_id() ) );
+
+  if ( time_in_steps_ )
+  {
+    put_( column++, pos, static_cast< int64_t >( event.get_stamp().get_steps() ) );
+    put_( column++, pos, event.get_offset() );
+  }
+  else
+  {
+    put_( column++, pos, event.get_stamp().get_ms() - event.get_offset() );
+  }
+
+  for ( const double val : double_values )
+  {
+    put_( column++, pos, val );
+  }
+  for ( const long val : long_values )
+  {
+    put_( column++, pos, static_cast< int64_t >( val ) );
+  }
+
+  if ( ++chunk_->size == chunk_->capacity )
+  {
+    backend.submit_chunk_( std::move( chunk_ ) );
+  }
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::get_status( DictionaryDatum& d ) const
+{
+  ( *d )[ names::file_extension ] = file_extension_;
+  ( *d )[ names::time_in_steps ] = time_in_steps_;
+
+  std::string filename = compute_filename_();
+  initialize_property_array( d, names::filenames );
+  append_property( d, names::filenames, filename );
+}
+
+void
+nest::RecordingBackendBinary::DeviceData::set_status( const DictionaryDatum& d )
+{
+  updateValue< std::string >( d, names::file_extension, file_extension_ );
+  updateValue< std::string >( d, names::label, label_ );
+
+  bool time_in_steps = false;
+  if ( updateValue< bool >( d, names::time_in_steps, time_in_steps ) )
+  {
+    if ( kernel().simulation_manager.has_been_simulated() )
+    {
+      throw BadProperty( "Property time_in_steps cannot be set after Simulate has been called." );
+    }
+
+    time_in_steps_ = time_in_steps;
+  }
+}
+
+std::string
+nest::RecordingBackendBinary::DeviceData::compute_filename_() const
+{
+  std::string data_path = kernel().io_manager.get_data_path();
+  if ( not data_path.empty() and not( data_path[ data_path.size() - 1 ] == '/' ) )
+  {
+    data_path += '/';
+  }
+
+  std::string label = label_;
+  if ( label.empty() )
+  {
+    label = modelname_;
+  }
+
+  std::string data_prefix = kernel().io_manager.get_data_prefix();
+
+  return data_path + data_prefix + label + vp_node_id_string_ + "." + file_extension_;
+}
+
+size_t
+nest::RecordingBackendBinary::DeviceData::get_num_columns_() const
+{
+  return ( time_in_steps_ ? 3 : 2 ) + double_value_names_.size() + long_value_names_.size();
+}
@@ -0,0 +1,310 @@
+/*
+ *  recording_backend_binary.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDING_BACKEND_BINARY_H
+#define RECORDING_BACKEND_BINARY_H
+
+// C++ includes:
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "recording_backend.h"
+
+/* BeginUserDocs: NOINDEX
+
+Recording backend `binary` - Write data to binary column files
+##############################################################
+
+Description
++++++++++++
+
+The `binary` recording backend writes collected data persistently to
+binary files in a columnar format. It is meant for simulations that
+record large amounts of data, for which formatting numbers as text in
+the :doc:`ascii <recording_backend_ascii>` backend dominates the time
+spent on recording.
+
+Like the `ascii` backend, this backend opens one file per recording
+device per thread on each MPI process. Filenames of data files are
+determined according to the same pattern:
+
+::
+
+   data_path/data_prefix(label|model_name)-node_id-vp.file_extension
+
+The properties ``data_path``, ``data_prefix`` and ``overwrite_files``
+are global kernel properties and have the same meaning as for the
+`ascii` backend.
+
+Each recording device collects its records in a chunk of memory that
+is allocated during ``Prepare``. Once a chunk is full, it is handed to
+a background thread, which writes it to the file while the simulation
+continues with the next chunk. The call to ``Run`` hands all partially
+filled chunks to the background thread and waits until all of them are
+written, so all data is available for immediate inspection afterwards.
+The background thread exists between the calls to ``Prepare`` and
+``Cleanup``.
+
+Data format
++++++++++++
+
+The file starts with a header describing its contents, followed by
+blocks of records. All numbers are stored in the byte order of the
+machine that wrote the file. The header contains, in this order:
+
+* the eight bytes ``NESTBIN\0``
+* the version of the file format as a 32-bit unsigned integer
+* the byte order mark ``0x01020304`` as a 32-bit unsigned integer
+* the size of the header in bytes as a 64-bit unsigned integer
+* the NEST version as a 32-bit unsigned length followed by the string
+* the number of columns as a 32-bit unsigned integer
+* for each column, a type character (``u`` for unsigned integers,
+  ``i`` for signed integers, ``f`` for floating point numbers) and the
+  name of the column as a 32-bit unsigned length followed by the string
+* zero bytes to pad the header to a multiple of eight bytes
+
+Each block starts with the number of records in the block as a 64-bit
+unsigned integer, followed by the values of all records for each
+column in turn. All values are eight bytes wide.
+
+The columns are the same as in the `ascii` backend: the node ID of the
+*source* of the event (``sender``), the time of the event, the
+recorded floating point values and the recorded integer values. If
+``time_in_steps`` is *false* (the default), time is stored in the
+column ``time_ms``. Otherwise, it is stored as the integer time step in
+the column ``time_step`` and the negative offset from the next grid
+point in ms in the column ``time_offset``.
+
+The function :py:func:`.read_binary_recording` reads such a file into
+a dictionary of NumPy arrays, one for each column.
+
+Parameter summary
++++++++++++++++++
+
+The following parameters can be set per recording device:
+
+file_extension
+    A string (default: *"nbin"*) that specifies the file name extension,
+    without leading dot.
+
+filenames
+    A list of the filenames where data is recorded to. This list has one
+    entry per local thread and is a read-only property.
+
+label
+    A string (default: *""*) that replaces the model name component in
+    the filename if it is set.
+
+time_in_steps
+    A Boolean (default: *false*) specifying whether to write time in
+    steps, i.e., in integer multiples of the simulation resolution plus
+    a floating point number for the negative offset from the next grid
+    point in ms, or just the simulation time in ms. This property
+    cannot be set after Simulate has been called.
+
+The following parameters are global and can be set using
+:py:func:`.SetDefaults` with ``"binary"`` as model name:
+
+chunk_size
+    The number of records (default: *4096*) a recording device collects
+    on a thread before they are written to the file. Changes take effect
+    with the next call to ``Prepare``.
+
+max_pending_chunks
+    The number of full chunks (default: *64*) that may wait to be
+    written by the background thread. If the file system cannot keep up
+    with the simulation, the simulation pauses until the number of
+    waiting chunks drops below this value, which bounds the memory used
+    for recording.
+
+EndUserDocs */
+
+namespace nest
+{
+
+/**
+ * Binary specialization of the RecordingBackend interface.
+ *
+ * RecordingBackendBinary maintains one file stream per recording
+ * device instance on every thread, like RecordingBackendASCII. Records
+ * are not written by the simulation threads, but stored in fixed-width
+ * columns of preallocated chunks. Full chunks are passed through a
+ * queue to a single writer thread, which is started in prepare() and
+ * joined in cleanup(). Written chunks are kept for reuse, so that no
+ * memory is allocated while recording once the simulation is running.
+ */
+class RecordingBackendBinary : public RecordingBackend
+{
+public:
+  const static unsigned int BINARY_REC_BACKEND_VERSION;
+
+  RecordingBackendBinary();
+
+  ~RecordingBackendBinary() throw() override;
+
+  void initialize() override;
+
+  void finalize() override;
+
+  void enroll( const RecordingDevice& device, const DictionaryDatum& params ) override;
+
+  void disenroll( const RecordingDevice& device ) override;
+
+  void set_value_names( const RecordingDevice& device,
+    const std::vector< Name >& double_value_names,
+    const std::vector< Name >& long_value_names ) override;
+
+  void prepare() override;
+
+  void cleanup() override;
+
+  void pre_run_hook() override;
+
+  /**
+   * Write all collected records and flush files after a single call to Run
+   */
+  void post_run_hook() override;
+
+  void post_step_hook() override;
+
+  void write( const RecordingDevice&, const Event&, const std::vector< double >&, const std::vector< long >& ) override;
+
+  void set_status( const DictionaryDatum& ) override;
+  void get_status( DictionaryDatum& ) const override;
+
+  void check_device_status( const DictionaryDatum& ) const override;
+  void get_device_defaults( DictionaryDatum& ) const override;
+  void get_device_status( const RecordingDevice& device, DictionaryDatum& ) const override;
+
+private:
+  const std::string compute_vp_node_id_string_( const RecordingDevice& device ) const;
+
+  /**
+   * Records of a single device, stored column by column.
+   *
+   * Column c of the chunk occupies data[ c * capacity ] to
+   * data[ c * capacity + size - 1 ]. Values of all types are stored
+   * as their eight byte representation.
+   */
+  struct Chunk
+  {
+    Chunk( const size_t capacity, const size_t num_columns );
+
+    //! Write the records as a block to file.
+    void write_block() const;
+
+    std::ofstream* file;          //!< File the chunk is written to
+    size_t capacity;              //!< Maximal number of records
+    size_t size;                  //!< Number of records stored
+    std::vector< uint64_t > data; //!< Column-major values of the records
+  };
+
+  struct DeviceData
+  {
+    DeviceData() = delete;
+    DeviceData( std::string, std::string );
+    void set_value_names( const std::vector< Name >&, const std::vector< Name >& );
+    void open_file( RecordingBackendBinary& );
+    void write( const Event&, const std::vector< double >&, const std::vector< long >&, RecordingBackendBinary& );
+    void submit_chunk( RecordingBackendBinary& );
+    void flush_file();
+    void close_file();
+    void get_status( DictionaryDatum& ) const;
+    void set_status( const DictionaryDatum& );
+
+  private:
+    bool time_in_steps_;                     //!< Should time be recorded in steps (ms if false)
+    std::string modelname_;                  //!< File name up to but not including the "."
+    std::string vp_node_id_string_;          //!< The vp and node ID component of the filename
+    std::string file_extension_;             //!< File name extension without leading "."
+    std::string label_;                      //!< The label of the device.
+    std::ofstream file_;                     //!< File stream to use for the device
+    std::vector< Name > double_value_names_; //!< names for values of type double
+    std::vector< Name > long_value_names_;   //!< names for values of type long
+    std::unique_ptr< Chunk > chunk_;         //!< Chunk records are currently stored in
+
+    std::string compute_filename_() const; //!< Compose and return the filename
+    size_t get_num_columns_() const;       //!< Number of columns written per record
+
+    //! Store value in column of the record at position pos of the current chunk
+    template < typename T >
+    void
+    put_( const size_t column, const size_t pos, const T value )
+    {
+      static_assert( sizeof( T ) == sizeof( uint64_t ), "All columns must be eight bytes wide." );
+      std::memcpy( &chunk_->data[ column * chunk_->capacity + pos ], &value, sizeof( uint64_t ) );
+    }
+  };
+
+  //! Return an empty chunk, reusing a written one if possible.
+  std::unique_ptr< Chunk > get_chunk_( std::ofstream& file, const size_t num_columns );
+
+  //! Queue a chunk for the writer thread, waiting if too many chunks are queued.
+  void submit_chunk_( std::unique_ptr< Chunk > chunk );
+
+  //! Wait until the writer thread has written all queued chunks.
+  void wait_for_writer_();
+
+  //! Stop and join the writer thread after it has written all queued chunks.
+  void stop_writer_();
+
+  //! Main loop of the writer thread.
+  void write_chunks_();
+
+  typedef std::vector< std::map< size_t, DeviceData > > data_map;
+  data_map device_data_;
+
+  std::thread writer_;                            //!< Thread writing chunks to files
+  std::mutex mutex_;                              //!< Protects all members below
+  std::condition_variable chunk_queued_;          //!< Signals the writer thread
+  std::condition_variable chunk_written_;         //!< Signals threads waiting for the writer
+  std::deque< std::unique_ptr< Chunk > > queued_; //!< Chunks waiting to be written
+  std::vector< std::unique_ptr< Chunk > > free_;  //!< Written chunks available for reuse
+  size_t num_writing_;                            //!< Number of chunks being written
+  bool stop_;                                     //!< Whether the writer thread should stop
+
+  struct Parameters_
+  {
+    long chunk_size_;         //!< Number of records per chunk
+    long max_pending_chunks_; //!< Maximal number of queued chunks
+
+    Parameters_();
+
+    void get( const RecordingBackendBinary&, DictionaryDatum& ) const;
+    void set( const RecordingBackendBinary&, const DictionaryDatum& );
+  };
+
+  Parameters_ P_;
+  size_t chunk_size_; //!< Chunk size in use between prepare() and cleanup()
+};
+
+} // namespace
+
+#endif /* #ifndef RECORDING_BACKEND_BINARY_H */
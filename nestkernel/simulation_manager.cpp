@@ -744,6 +744,11 @@ nest::SimulationManager::update_connection_infrastructure( const size_t tid )
     sw_communicate_prepare_.start();
   }
 
+#pragma omp single
+  {
+    kernel().connection_manager.check_incremental_update();
+  }
+
   kernel().connection_manager.restructure_connection_tables( tid );
   kernel().connection_manager.sort_connections( tid );
   kernel().connection_manager.collect_compressed_spike_data( tid );
@@ -813,6 +818,7 @@ nest::SimulationManager::update_connection_infrastructure( const size_t tid )
 #pragma omp single
   {
     kernel().connection_manager.clear_compressed_spike_data_map();
+    kernel().event_delivery_manager.reset_spike_data_neighbors();
     kernel().node_manager.set_have_nodes_changed( false );
     kernel().connection_manager.unset_connections_have_changed();
   }
@@ -1084,6 +1090,27 @@ nest::SimulationManager::update_()
         }
 #endif
 
+        // gather spikes only at end of slice, i.e., end of min_delay step; all threads take part in collocating
+        if ( to_step_ == kernel().connection_manager.get_min_delay()
+          and kernel().connection_manager.has_primary_connections() )
+        {
+#ifdef TIMER_DETAILED
+          if ( tid == 0 )
+          {
+            sw_gather_spike_data_.start();
+          }
+#endif
+
+          kernel().event_delivery_manager.gather_spike_data( tid );
+
+#ifdef TIMER_DETAILED
+          if ( tid == 0 )
+          {
+            sw_gather_spike_data_.stop();
+          }
+#endif
+        }
+
         // the following block is executed by the master thread only
 // the other threads are enforced to wait at the end of the block
 #pragma omp master
@@ -1091,17 +1118,6 @@ nest::SimulationManager::update_()
           // gather and deliver only at end of slice, i.e., end of min_delay step
           if ( to_step_ == kernel().connection_manager.get_min_delay() )
           {
-            if ( kernel().connection_manager.has_primary_connections() )
-            {
-#ifdef TIMER_DETAILED
-              sw_gather_spike_data_.start();
-#endif
-
-              kernel().event_delivery_manager.gather_spike_data();
-#ifdef TIMER_DETAILED
-              sw_gather_spike_data_.stop();
-#endif
-            }
             if ( kernel().connection_manager.secondary_connections_exist() )
             {
 #ifdef TIMER_DETAILED
@@ -1167,6 +1183,13 @@ nest::SimulationManager::update_()
     }
   } // of omp parallel
 
+  // No spike exchange may remain in flight once control returns to the user. The spikes received are delivered
+  // at the beginning of the slice after next as usual.
+  if ( kernel().connection_manager.spike_communication_overlapped() )
+  {
+    kernel().event_delivery_manager.complete_spike_data_exchange();
+  }
+
   if ( update_time_limit_exceeded )
   {
     LOG( M_ERROR, "SimulationManager::update", "Update time limit exceeded." );
@@ -21,6 +21,7 @@
  */
 
 // C++ includes:
+#include <algorithm>
 #include <iostream>
 
 // Includes from nestkernel:
@@ -77,6 +78,7 @@ nest::SourceTable::finalize()
   saved_positions_.clear();
   compressible_sources_.clear();
   compressed_spike_data_map_.clear();
+  known_source_indices_.clear();
 }
 
 bool
@@ -506,25 +508,64 @@ nest::SourceTable::dump_compressible_sources() const
   } )
 }
 
+void
+nest::SourceTable::collect_known_source_indices(
+  const std::vector< std::vector< std::vector< SpikeData > > >& compressed_spike_data )
+{
+  known_source_indices_.clear();
+  known_source_indices_.resize( compressed_spike_data.size() );
+
+  for ( synindex syn_id = 0; syn_id < compressed_spike_data.size(); ++syn_id )
+  {
+    for ( size_t source_index = 0; source_index < compressed_spike_data[ syn_id ].size(); ++source_index )
+    {
+      // any thread with a target of this source yields the source node ID
+      for ( const auto& spike_data : compressed_spike_data[ syn_id ][ source_index ] )
+      {
+        if ( spike_data.get_lcid() != invalid_lcid )
+        {
+          const size_t source_gid = sources_[ spike_data.get_tid() ][ syn_id ][ spike_data.get_lcid() ].get_node_id();
+          known_source_indices_[ syn_id ].insert( std::make_pair( source_gid, source_index ) );
+          break;
+        }
+      }
+    }
+  }
+}
+
 void
 nest::SourceTable::fill_compressed_spike_data(
   std::vector< std::vector< std::vector< SpikeData > > >& compressed_spike_data )
 {
   const size_t num_synapse_models = kernel().model_manager.get_num_connection_models();
-  compressed_spike_data.clear();
   compressed_spike_data.resize( num_synapse_models );
   compressed_spike_data_map_.clear();
   compressed_spike_data_map_.resize( num_synapse_models, std::map< size_t, CSDMapEntry >() );
+  known_source_indices_.resize( num_synapse_models );
 
   // For each synapse type, and for each source neuron with at least one local target,
   // store in compressed_spike_data one SpikeData entry for each local thread that
   // owns a local target. In compressed_spike_data_map_ store index into compressed_spike_data[syn_id]
   // where data for a given source is stored.
+  //
+  // Sources in known_source_indices_ have been communicated to the presynaptic side before. They keep
+  // their index and are not entered in compressed_spike_data_map_, as only new sources need to be
+  // communicated. Without incremental update, known_source_indices_ is empty.
 
   // TODO: I believe that at this point compressible_sources_ is ordered by source gid.
   //       Maybe one can exploit that to avoid searching with find() below.
   for ( synindex syn_id = 0; syn_id < kernel().model_manager.get_num_connection_models(); ++syn_id )
   {
+    const auto& known_sources = known_source_indices_[ syn_id ];
+
+    compressed_spike_data[ syn_id ].resize( known_sources.size() );
+    for ( auto& spike_data_per_thread : compressed_spike_data[ syn_id ] )
+    {
+      std::fill( spike_data_per_thread.begin(),
+        spike_data_per_thread.end(),
+        SpikeData( invalid_targetindex, invalid_synindex, invalid_lcid, 0 ) );
+    }
+
     for ( size_t target_thread = 0; target_thread < static_cast< size_t >( compressible_sources_.size() );
           ++target_thread )
     {
@@ -532,19 +573,28 @@ nest::SourceTable::fill_compressed_spike_data(
       {
         const auto source_gid = connection.first;
 
-        if ( compressed_spike_data_map_[ syn_id ].find( source_gid ) == compressed_spike_data_map_[ syn_id ].end() )
+        size_t source_index;
+        const auto known_source = known_sources.find( source_gid );
+        if ( known_source != known_sources.end() )
         {
-          // Set up entry for new source
-          const auto new_source_index = compressed_spike_data[ syn_id ].size();
+          source_index = known_source->second;
+        }
+        else
+        {
+          if ( compressed_spike_data_map_[ syn_id ].find( source_gid ) == compressed_spike_data_map_[ syn_id ].end() )
+          {
+            // Set up entry for new source
+            const auto new_source_index = compressed_spike_data[ syn_id ].size();
 
-          compressed_spike_data[ syn_id ].emplace_back( kernel().vp_manager.get_num_threads(),
-            SpikeData( invalid_targetindex, invalid_synindex, invalid_lcid, 0 ) );
+            compressed_spike_data[ syn_id ].emplace_back( kernel().vp_manager.get_num_threads(),
+              SpikeData( invalid_targetindex, invalid_synindex, invalid_lcid, 0 ) );
 
-          compressed_spike_data_map_[ syn_id ].insert(
-            std::make_pair( source_gid, CSDMapEntry( new_source_index, target_thread ) ) );
-        }
+            compressed_spike_data_map_[ syn_id ].insert(
+              std::make_pair( source_gid, CSDMapEntry( new_source_index, target_thread ) ) );
+          }
 
-        const auto source_index = compressed_spike_data_map_[ syn_id ].find( source_gid )->second.get_source_index();
+          source_index = compressed_spike_data_map_[ syn_id ].find( source_gid )->second.get_source_index();
+        }
 
         assert( compressed_spike_data[ syn_id ][ source_index ][ target_thread ].get_lcid() == invalid_lcid );
 
@@ -555,6 +605,8 @@ nest::SourceTable::fill_compressed_spike_data(
 
     } // for target_thread
   }   // for syn_id
+
+  known_source_indices_.clear();
 }
 
 // Argument name only needed if full logging is activated. Macro-protect to avoid unused argument warning.
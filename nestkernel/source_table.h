@@ -195,6 +195,17 @@ private:
    */
   std::vector< std::map< size_t, CSDMapEntry > > compressed_spike_data_map_;
 
+  /**
+   * Indices in the compressed_spike_data_ structure of ConnectionManager of
+   * all sources that have been communicated to the presynaptic side before.
+   *
+   * Only filled during incremental updates of the connection
+   * infrastructure, so that these sources keep their index and are not
+   * communicated again. Arranged as a one-dimensional vector over synapse
+   * ids with an inner map (source node id -> source_index).
+   */
+  std::vector< std::map< size_t, size_t > > known_source_indices_;
+
 public:
   SourceTable();
   ~SourceTable();
@@ -327,7 +338,8 @@ public:
    *
    * This number corresponds to the number
    * of targets that need to be communicated during construction of
-   * the presynaptic connection infrastructure.
+   * the presynaptic connection infrastructure. Entries that have
+   * already been processed are not counted.
    */
   size_t num_unique_sources( const size_t tid, const synindex syn_id ) const;
 
@@ -349,6 +361,16 @@ public:
   // fills the compressed_spike_data structure in ConnectionManager
   void fill_compressed_spike_data( std::vector< std::vector< std::vector< SpikeData > > >& compressed_spike_data );
 
+  /**
+   * Records the index in compressed_spike_data of each source that has
+   * already been communicated to the presynaptic side.
+   *
+   * Must be called before connections are sorted, as the entries of
+   * compressed_spike_data refer to positions in sources_.
+   */
+  void collect_known_source_indices(
+    const std::vector< std::vector< std::vector< SpikeData > > >& compressed_spike_data );
+
   void clear_compressed_spike_data_map();
 
   void dump_sources() const;
@@ -524,7 +546,7 @@ SourceTable::num_unique_sources( const size_t tid, const synindex syn_id ) const
         cit != sources_[ tid ][ syn_id ].end();
         ++cit )
   {
-    if ( last_source != ( *cit ).get_node_id() )
+    if ( not( *cit ).is_processed() and last_source != ( *cit ).get_node_id() )
     {
       last_source = ( *cit ).get_node_id();
       ++n;
@@ -0,0 +1,211 @@
+/*
+ *  spatial_hash.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+// C++ includes:
+#include <utility>
+#include <vector>
+
+// Includes from spatial:
+#include "ntree.h"
+#include "position.h"
+
+namespace nest
+{
+
+template < int D >
+class Mask;
+
+/**
+ * Uniform grid of cells over the region of an Ntree, used to find the nodes
+ * inside a mask.
+ *
+ * For densely and uniformly populated layers, the nodes inside a mask are
+ * found by scanning the cells overlapping the mask, instead of traversing
+ * the Ntree. Nodes of cells entirely inside the mask are copied without
+ * testing them individually.
+ *
+ * The number of cells in each dimension is a power of two, so that cells
+ * coincide with quadrants of the Ntree. Cells are made larger until the
+ * nodes of each cell are consecutive in the Ntree order. Nodes are then
+ * returned in the same order as by Ntree::masked_iterator by ordering the
+ * cells, so that the two can be used interchangeably when connecting.
+ */
+template < int D, class T >
+class SpatialHash
+{
+public:
+  typedef std::pair< Position< D >, T > value_type;
+
+  /**
+   * Create a spatial hash of the nodes in an Ntree.
+   *
+   * @param ntree     Ntree containing the nodes, its region is covered by the cells.
+   * @param cell_size Smallest size of cells.
+   */
+  SpatialHash( Ntree< D, T >& ntree, const Position< D >& cell_size );
+
+  /**
+   * Append the nodes inside the mask to the vector.
+   *
+   * @param mask    mask to apply.
+   * @param anchors anchors of the mask images, see Ntree::get_anchors().
+   * @param nodes   vector to append nodes to, in the order of Ntree::masked_iterator.
+   */
+  void get_nodes( const Mask< D >& mask,
+    const std::vector< Position< D > >& anchors,
+    std::vector< value_type >& nodes ) const;
+
+  //! @returns the number of nodes.
+  size_t
+  size() const
+  {
+    return nodes_.size();
+  }
+
+  //! @returns the number of cells.
+  size_t
+  get_num_cells() const
+  {
+    return cell_ranges_.size();
+  }
+
+  //! @returns the largest number of nodes in a cell.
+  size_t get_max_cell_size() const;
+
+protected:
+  /**
+   * Ranges of nodes in cells overlapping a mask, and whether each cell is
+   * only partially covered by the mask.
+   */
+  typedef std::vector< std::pair< std::pair< size_t, size_t >, bool > > CellRanges_;
+
+  /**
+   * Assign nodes to cells.
+   *
+   * @returns false if the nodes of some cell are not consecutive in nodes_.
+   */
+  bool fill_cells_();
+
+  //! @returns the index of the cell containing coordinate x in dimension dim.
+  size_t get_cell_index_( const double x, const int dim ) const;
+
+  /**
+   * Append the nodes of cells to the vector, in the order of Ntree::masked_iterator.
+   *
+   * @param ranges  ranges of cells, sorted on return.
+   * @param inside  predicate deciding if the node with the given index in nodes_
+   *                is inside the mask, called for partially covered cells only.
+   * @param nodes   vector to append nodes to.
+   */
+  template < class Inside >
+  void append_nodes_( CellRanges_& ranges, Inside inside, std::vector< value_type >& nodes ) const;
+
+  Position< D > lower_left_;
+  Position< D > extent_;
+  Position< D > cell_size_;
+  Position< D, size_t > num_cells_;
+
+  //! Nodes in the order of Ntree iteration
+  std::vector< value_type > nodes_;
+
+  //! Nodes of cell c are nodes_[ cell_ranges_[ c ].first ] to nodes_[ cell_ranges_[ c ].second - 1 ]
+  std::vector< std::pair< size_t, size_t > > cell_ranges_;
+};
+
+/**
+ * Spatial hash for nodes on a regular grid, used to find the nodes inside
+ * an axis-aligned box mask.
+ *
+ * Each node is labeled with the indices of its coordinates among all
+ * coordinates of nodes in each dimension. For each anchor, the range of
+ * indices inside the box is found per dimension by comparing coordinates
+ * exactly as BoxMask does, so that the same nodes are found as by the
+ * Ntree. Cells and nodes are then selected by comparing integer indices
+ * only. Stencils are applicable to any layer, but they pay off only if
+ * nodes share coordinates as on a grid layer.
+ *
+ * A node at position x is inside the box for the anchor a if
+ * lower_left <= ( x - a ) - mask_anchor <= upper_right, or, if the box
+ * is converse, lower_left <= -( x - a ) - mask_anchor <= upper_right.
+ * This is the test of a BoxMask, wrapped in an AnchoredMask and a
+ * ConverseMask.
+ */
+template < int D, class T >
+class GridStencil : public SpatialHash< D, T >
+{
+public:
+  typedef typename SpatialHash< D, T >::value_type value_type;
+
+  /**
+   * Create a grid stencil of the nodes in an Ntree.
+   *
+   * @param ntree       Ntree containing the nodes, its region is covered by the cells.
+   * @param cell_size   Smallest size of cells.
+   * @param lower_left  lower left corner of the box.
+   * @param upper_right upper right corner of the box.
+   * @param mask_anchor anchor of the box, zero if the box is not anchored.
+   * @param converse    whether the box is mirrored.
+   */
+  GridStencil( Ntree< D, T >& ntree,
+    const Position< D >& cell_size,
+    const Position< D >& lower_left,
+    const Position< D >& upper_right,
+    const Position< D >& mask_anchor,
+    const bool converse );
+
+  /**
+   * Append the nodes inside the box to the vector.
+   *
+   * @param anchors anchors of the box images, see Ntree::get_anchors().
+   * @param nodes   vector to append nodes to, in the order of Ntree::masked_iterator.
+   */
+  void get_nodes( const std::vector< Position< D > >& anchors, std::vector< value_type >& nodes ) const;
+
+  //! @returns the number of distinct coordinates of nodes in dimension dim.
+  size_t
+  get_num_coordinates( const int dim ) const
+  {
+    return coordinates_[ dim ].size();
+  }
+
+private:
+  Position< D > box_lower_left_;
+  Position< D > box_upper_right_;
+  Position< D > mask_anchor_;
+  bool converse_;
+
+  //! Distinct coordinates of nodes, ascending for each dimension
+  std::vector< double > coordinates_[ D ];
+
+  //! Indices of the coordinates of nodes in coordinates_, in the order of nodes_
+  std::vector< Position< D, int > > node_indices_;
+
+  //! Smallest and largest indices of coordinates of nodes in each cell
+  std::vector< std::pair< Position< D, int >, Position< D, int > > > cell_bounds_;
+};
+
+} // namespace nest
+
+#endif /* SPATIAL_HASH_H */
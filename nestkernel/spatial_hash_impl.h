@@ -0,0 +1,407 @@
+/*
+ *  spatial_hash_impl.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPATIAL_HASH_IMPL_H
+#define SPATIAL_HASH_IMPL_H
+
+#include "spatial_hash.h"
+
+// C++ includes:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Includes from spatial:
+#include "mask.h"
+
+namespace nest
+{
+
+template < int D, class T >
+SpatialHash< D, T >::SpatialHash( Ntree< D, T >& ntree, const Position< D >& cell_size )
+  : lower_left_( ntree.get_lower_left() )
+  , extent_( ntree.get_extent() )
+{
+  for ( int i = 0; i < D; ++i )
+  {
+    num_cells_[ i ] = 1;
+    while ( extent_[ i ] / ( 2 * num_cells_[ i ] ) >= cell_size[ i ] )
+    {
+      num_cells_[ i ] *= 2;
+    }
+  }
+
+  for ( typename Ntree< D, T >::iterator it = ntree.begin(); it != ntree.end(); ++it )
+  {
+    nodes_.push_back( *it );
+  }
+
+  // Cells are too small if they split leaves of the Ntree.
+  while ( not fill_cells_() )
+  {
+    for ( int i = 0; i < D; ++i )
+    {
+      num_cells_[ i ] = std::max( num_cells_[ i ] / 2, static_cast< size_t >( 1 ) );
+    }
+  }
+}
+
+template < int D, class T >
+bool
+SpatialHash< D, T >::fill_cells_()
+{
+  size_t total_num_cells = 1;
+  for ( int i = 0; i < D; ++i )
+  {
+    cell_size_[ i ] = extent_[ i ] / num_cells_[ i ];
+    total_num_cells *= num_cells_[ i ];
+  }
+  cell_ranges_.assign( total_num_cells, std::make_pair( 0, 0 ) );
+
+  size_t previous_cell = total_num_cells;
+  for ( size_t n = 0; n < nodes_.size(); ++n )
+  {
+    size_t cell = 0;
+    for ( int i = D - 1; i >= 0; --i )
+    {
+      cell = cell * num_cells_[ i ] + get_cell_index_( nodes_[ n ].first[ i ], i );
+    }
+
+    if ( cell != previous_cell )
+    {
+      if ( cell_ranges_[ cell ].second > 0 )
+      {
+        return total_num_cells == 1; // cell visited before, its nodes are not consecutive
+      }
+      cell_ranges_[ cell ].first = n;
+      previous_cell = cell;
+    }
+    cell_ranges_[ cell ].second = n + 1;
+  }
+  return true;
+}
+
+template < int D, class T >
+size_t
+SpatialHash< D, T >::get_cell_index_( const double x, const int dim ) const
+{
+  // Bisect as Ntree::subquad_() and Ntree::create_children_() do, so that positions on the border between
+  // quadrants are assigned to the same cell as in the Ntree.
+  size_t index = 0;
+  double lower = lower_left_[ dim ];
+  double extent = extent_[ dim ];
+  for ( size_t n = num_cells_[ dim ]; n > 1; n /= 2 )
+  {
+    index *= 2;
+    if ( ( lower + extent / 2 ) - x <= -std::numeric_limits< double >::epsilon() )
+    {
+      ++index;
+      lower += extent * 0.5;
+    }
+    extent *= 0.5;
+  }
+  return index;
+}
+
+template < int D, class T >
+template < class Inside >
+void
+SpatialHash< D, T >::append_nodes_( CellRanges_& ranges, Inside inside, std::vector< value_type >& nodes ) const
+{
+  // Nodes of different cells do not interleave in the Ntree order, so ordering the cells orders the nodes.
+  std::sort( ranges.begin(), ranges.end() );
+  for ( const auto& range : ranges )
+  {
+    if ( not range.second )
+    {
+      nodes.insert( nodes.end(), nodes_.begin() + range.first.first, nodes_.begin() + range.first.second );
+      continue;
+    }
+    for ( size_t n = range.first.first; n < range.first.second; ++n )
+    {
+      if ( inside( n ) )
+      {
+        nodes.push_back( nodes_[ n ] );
+      }
+    }
+  }
+}
+
+template < int D, class T >
+size_t
+SpatialHash< D, T >::get_max_cell_size() const
+{
+  size_t max_cell_size = 0;
+  for ( const auto& range : cell_ranges_ )
+  {
+    max_cell_size = std::max( max_cell_size, range.second - range.first );
+  }
+  return max_cell_size;
+}
+
+template < int D, class T >
+void
+SpatialHash< D, T >::get_nodes( const Mask< D >& mask,
+  const std::vector< Position< D > >& anchors,
+  std::vector< value_type >& nodes ) const
+{
+  const Box< D > mask_bb = mask.get_bbox();
+
+  CellRanges_ ranges;
+
+  for ( const auto& anchor : anchors )
+  {
+    // Range of cells overlapping the bounding box of the mask
+    Position< D, size_t > first_cell;
+    Position< D, size_t > last_cell;
+    bool overlaps = true;
+    for ( int i = 0; i < D; ++i )
+    {
+      const double lower = ( anchor[ i ] + mask_bb.lower_left[ i ] - lower_left_[ i ] ) / cell_size_[ i ];
+      const double upper = ( anchor[ i ] + mask_bb.upper_right[ i ] - lower_left_[ i ] ) / cell_size_[ i ];
+      if ( upper < 0 or lower > num_cells_[ i ] )
+      {
+        overlaps = false;
+        break;
+      }
+      // Include neighboring cells, which may hold nodes on their border.
+      first_cell[ i ] = static_cast< size_t >( std::max( std::floor( lower ) - 1, 0.0 ) );
+      last_cell[ i ] = std::min( static_cast< size_t >( std::floor( upper ) + 1 ), num_cells_[ i ] - 1 );
+    }
+    if ( not overlaps )
+    {
+      continue;
+    }
+
+    ranges.clear();
+    Position< D, size_t > cell_index = first_cell;
+    while ( true )
+    {
+      size_t cell = 0;
+      Position< D > cell_lower_left;
+      for ( int i = D - 1; i >= 0; --i )
+      {
+        cell = cell * num_cells_[ i ] + cell_index[ i ];
+        cell_lower_left[ i ] = lower_left_[ i ] + cell_index[ i ] * cell_size_[ i ] - anchor[ i ];
+      }
+
+      if ( cell_ranges_[ cell ].second > cell_ranges_[ cell ].first )
+      {
+        const Box< D > cell_box( cell_lower_left, cell_lower_left + cell_size_ );
+        if ( mask.inside( cell_box ) )
+        {
+          ranges.push_back( std::make_pair( cell_ranges_[ cell ], false ) );
+        }
+        else if ( not mask.outside( cell_box ) )
+        {
+          ranges.push_back( std::make_pair( cell_ranges_[ cell ], true ) );
+        }
+      }
+
+      // Move to the next cell in the range
+      int i = 0;
+      while ( i < D and cell_index[ i ] == last_cell[ i ] )
+      {
+        cell_index[ i ] = first_cell[ i ];
+        ++i;
+      }
+      if ( i == D )
+      {
+        break;
+      }
+      ++cell_index[ i ];
+    }
+
+    append_nodes_(
+      ranges, [ this, &mask, &anchor ]( const size_t n ) { return mask.inside( nodes_[ n ].first - anchor ); }, nodes );
+  }
+}
+
+template < int D, class T >
+GridStencil< D, T >::GridStencil( Ntree< D, T >& ntree,
+  const Position< D >& cell_size,
+  const Position< D >& lower_left,
+  const Position< D >& upper_right,
+  const Position< D >& mask_anchor,
+  const bool converse )
+  : SpatialHash< D, T >( ntree, cell_size )
+  , box_lower_left_( lower_left )
+  , box_upper_right_( upper_right )
+  , mask_anchor_( mask_anchor )
+  , converse_( converse )
+{
+  const std::vector< value_type >& nodes = this->nodes_;
+
+  for ( int i = 0; i < D; ++i )
+  {
+    std::vector< double >& coordinates = coordinates_[ i ];
+    coordinates.reserve( nodes.size() );
+    for ( const auto& node : nodes )
+    {
+      coordinates.push_back( node.first[ i ] );
+    }
+    std::sort( coordinates.begin(), coordinates.end() );
+    coordinates.erase( std::unique( coordinates.begin(), coordinates.end() ), coordinates.end() );
+  }
+
+  node_indices_.resize( nodes.size() );
+  for ( size_t n = 0; n < nodes.size(); ++n )
+  {
+    for ( int i = 0; i < D; ++i )
+    {
+      node_indices_[ n ][ i ] =
+        std::lower_bound( coordinates_[ i ].begin(), coordinates_[ i ].end(), nodes[ n ].first[ i ] )
+        - coordinates_[ i ].begin();
+    }
+  }
+
+  cell_bounds_.resize( this->cell_ranges_.size() );
+  for ( size_t c = 0; c < cell_bounds_.size(); ++c )
+  {
+    const std::pair< size_t, size_t >& range = this->cell_ranges_[ c ];
+    for ( size_t n = range.first; n < range.second; ++n )
+    {
+      for ( int i = 0; i < D; ++i )
+      {
+        if ( n == range.first or node_indices_[ n ][ i ] < cell_bounds_[ c ].first[ i ] )
+        {
+          cell_bounds_[ c ].first[ i ] = node_indices_[ n ][ i ];
+        }
+        if ( n == range.first or node_indices_[ n ][ i ] > cell_bounds_[ c ].second[ i ] )
+        {
+          cell_bounds_[ c ].second[ i ] = node_indices_[ n ][ i ];
+        }
+      }
+    }
+  }
+}
+
+template < int D, class T >
+void
+GridStencil< D, T >::get_nodes( const std::vector< Position< D > >& anchors, std::vector< value_type >& nodes ) const
+{
+  typename SpatialHash< D, T >::CellRanges_ ranges;
+
+  for ( const auto& anchor : anchors )
+  {
+    // Indices of coordinates inside the box. The displacement is computed as in Ntree::masked_iterator,
+    // ConverseMask and AnchoredMask, and is monotonic in the coordinate, so that the indices inside form a
+    // contiguous range.
+    Position< D, int > first_index;
+    Position< D, int > last_index;
+    bool empty = false;
+    for ( int i = 0; i < D; ++i )
+    {
+      const std::vector< double >& coordinates = coordinates_[ i ];
+      const double a = anchor[ i ];
+      const double m = mask_anchor_[ i ];
+      const double ll = box_lower_left_[ i ];
+      const double ur = box_upper_right_[ i ];
+      std::vector< double >::const_iterator first;
+      std::vector< double >::const_iterator last;
+      if ( converse_ )
+      {
+        first = std::partition_point( coordinates.begin(),
+          coordinates.end(),
+          [ a, m, ur ]( const double x ) { return -( x - a ) - m > ur; } );
+        last = std::partition_point(
+          first, coordinates.end(), [ a, m, ll ]( const double x ) { return -( x - a ) - m >= ll; } );
+      }
+      else
+      {
+        first = std::partition_point(
+          coordinates.begin(), coordinates.end(), [ a, m, ll ]( const double x ) { return ( x - a ) - m < ll; } );
+        last = std::partition_point(
+          first, coordinates.end(), [ a, m, ur ]( const double x ) { return ( x - a ) - m <= ur; } );
+      }
+      if ( first == last )
+      {
+        empty = true;
+        break;
+      }
+      first_index[ i ] = first - coordinates.begin();
+      last_index[ i ] = last - coordinates.begin() - 1;
+    }
+    if ( empty )
+    {
+      continue;
+    }
+
+    // Cells are aligned with coordinates, so cells containing the first and last coordinates bound the range.
+    Position< D, size_t > first_cell;
+    Position< D, size_t > last_cell;
+    for ( int i = 0; i < D; ++i )
+    {
+      first_cell[ i ] = this->get_cell_index_( coordinates_[ i ][ first_index[ i ] ], i );
+      last_cell[ i ] = this->get_cell_index_( coordinates_[ i ][ last_index[ i ] ], i );
+    }
+
+    ranges.clear();
+    Position< D, size_t > cell_index = first_cell;
+    while ( true )
+    {
+      size_t cell = 0;
+      for ( int i = D - 1; i >= 0; --i )
+      {
+        cell = cell * this->num_cells_[ i ] + cell_index[ i ];
+      }
+
+      const std::pair< size_t, size_t >& range = this->cell_ranges_[ cell ];
+      if ( range.second > range.first )
+      {
+        const Position< D, int >& cell_first = cell_bounds_[ cell ].first;
+        const Position< D, int >& cell_last = cell_bounds_[ cell ].second;
+        if ( first_index <= cell_first and cell_last <= last_index )
+        {
+          ranges.push_back( std::make_pair( range, false ) );
+        }
+        else if ( first_index <= cell_last and cell_first <= last_index )
+        {
+          ranges.push_back( std::make_pair( range, true ) );
+        }
+      }
+
+      // Move to the next cell in the range
+      int i = 0;
+      while ( i < D and cell_index[ i ] == last_cell[ i ] )
+      {
+        cell_index[ i ] = first_cell[ i ];
+        ++i;
+      }
+      if ( i == D )
+      {
+        break;
+      }
+      ++cell_index[ i ];
+    }
+
+    this->append_nodes_(
+      ranges,
+      [ this, &first_index, &last_index ]( const size_t n )
+      { return first_index <= node_indices_[ n ] and node_indices_[ n ] <= last_index; },
+      nodes );
+  }
+}
+
+} // namespace nest
+
+#endif
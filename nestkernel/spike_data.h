@@ -89,6 +89,10 @@ enum enum_status_spike_data_id
  * Used to communicate spikes. These are the elements of the MPI
  * buffers.
  *
+ * An entry carries up to MAX_MULTIPLICITY spikes emitted by the same
+ * neuron in the same time step. Spikes of higher multiplicity are
+ * split over several consecutive entries.
+ *
  * @see TargetData
  */
 class SpikeData
@@ -96,16 +100,17 @@ class SpikeData
 protected:
   static constexpr int MAX_LAG = generate_max_value( NUM_BITS_LAG );
 
-  size_t lcid_ : NUM_BITS_LCID;                      //!< local connection index
-  unsigned int marker_ : NUM_BITS_MARKER_SPIKE_DATA; //!< status flag
-  unsigned int lag_ : NUM_BITS_LAG;                  //!< lag in this min-delay interval
-  unsigned int tid_ : NUM_BITS_TID;                  //!< thread index
-  synindex syn_id_ : NUM_BITS_SYN_ID;                //!< synapse-type index
+  size_t lcid_ : NUM_BITS_LCID;                       //!< local connection index
+  unsigned int marker_ : NUM_BITS_MARKER_SPIKE_DATA;  //!< status flag
+  unsigned int multiplicity_ : NUM_BITS_MULTIPLICITY; //!< number of spikes
+  unsigned int lag_ : NUM_BITS_LAG;                   //!< lag in this min-delay interval
+  unsigned int tid_ : NUM_BITS_TID;                   //!< thread index
+  synindex syn_id_ : NUM_BITS_SYN_ID;                 //!< synapse-type index
 
 public:
   SpikeData();
   SpikeData( const SpikeData& rhs );
-  SpikeData( const Target& target, const size_t lag );
+  SpikeData( const Target& target, const size_t lag, const size_t multiplicity = 1 );
   SpikeData( const size_t tid, const synindex syn_id, const size_t lcid, const unsigned int lag );
 
   SpikeData& operator=( const SpikeData& rhs );
@@ -143,6 +148,16 @@ public:
    */
   synindex get_syn_id() const;
 
+  /**
+   * Returns number of spikes represented by this entry.
+   */
+  size_t get_multiplicity() const;
+
+  /**
+   * Sets number of spikes represented by this entry.
+   */
+  void set_multiplicity( const size_t multiplicity );
+
   /**
    * Returns marker.
    */
@@ -195,6 +210,7 @@ using success_spike_data_size = StaticAssert< sizeof( SpikeData ) == 8 >::succes
 inline SpikeData::SpikeData()
   : lcid_( 0 )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , multiplicity_( 1 )
   , lag_( 0 )
   , tid_( 0 )
   , syn_id_( 0 )
@@ -204,24 +220,28 @@ inline SpikeData::SpikeData()
 inline SpikeData::SpikeData( const SpikeData& rhs )
   : lcid_( rhs.lcid_ )
   , marker_( rhs.marker_ )
+  , multiplicity_( rhs.multiplicity_ )
   , lag_( rhs.lag_ )
   , tid_( rhs.tid_ )
   , syn_id_( rhs.syn_id_ )
 {
 }
 
-inline SpikeData::SpikeData( const Target& target, const size_t lag )
+inline SpikeData::SpikeData( const Target& target, const size_t lag, const size_t multiplicity )
   : lcid_( target.get_lcid() )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , multiplicity_( multiplicity )
   , lag_( lag )
   , tid_( target.get_tid() )
   , syn_id_( target.get_syn_id() )
 {
+  assert( 0 < multiplicity and multiplicity <= MAX_MULTIPLICITY );
 }
 
 inline SpikeData::SpikeData( const size_t tid, const synindex syn_id, const size_t lcid, const unsigned int lag )
   : lcid_( lcid )
   , marker_( SPIKE_DATA_ID_DEFAULT )
+  , multiplicity_( 1 )
   , lag_( lag )
   , tid_( tid )
   , syn_id_( syn_id )
@@ -233,6 +253,7 @@ SpikeData::operator=( const SpikeData& rhs )
 {
   lcid_ = rhs.lcid_;
   marker_ = rhs.marker_;
+  multiplicity_ = rhs.multiplicity_;
   lag_ = rhs.lag_;
   tid_ = rhs.tid_;
   syn_id_ = rhs.syn_id_;
@@ -249,6 +270,7 @@ SpikeData::set( const size_t tid, const synindex syn_id, const size_t lcid, cons
 
   lcid_ = lcid;
   marker_ = SPIKE_DATA_ID_DEFAULT;
+  multiplicity_ = 1;
   lag_ = lag;
   tid_ = tid;
   syn_id_ = syn_id;
@@ -263,6 +285,7 @@ SpikeData::set( const TargetT& target, const unsigned int lag )
   assert( lag < MAX_LAG );
   lcid_ = target.get_lcid();
   marker_ = SPIKE_DATA_ID_DEFAULT;
+  multiplicity_ = 1;
   lag_ = lag;
   tid_ = target.get_tid();
   syn_id_ = target.get_syn_id();
@@ -299,6 +322,19 @@ SpikeData::get_syn_id() const
   return syn_id_;
 }
 
+inline size_t
+SpikeData::get_multiplicity() const
+{
+  return multiplicity_;
+}
+
+inline void
+SpikeData::set_multiplicity( const size_t multiplicity )
+{
+  assert( 0 < multiplicity and multiplicity <= MAX_MULTIPLICITY );
+  multiplicity_ = multiplicity;
+}
+
 inline unsigned int
 SpikeData::get_marker() const
 {
@@ -360,7 +396,7 @@ private:
 
 public:
   OffGridSpikeData();
-  OffGridSpikeData( const Target& target, const size_t lag, const double offset );
+  OffGridSpikeData( const Target& target, const size_t lag, const double offset, const size_t multiplicity = 1 );
   OffGridSpikeData( const size_t tid,
     const synindex syn_id,
     const size_t lcid,
@@ -385,8 +421,11 @@ inline OffGridSpikeData::OffGridSpikeData()
 {
 }
 
-inline OffGridSpikeData::OffGridSpikeData( const Target& target, const size_t lag, const double offset )
-  : SpikeData( target, lag )
+inline OffGridSpikeData::OffGridSpikeData( const Target& target,
+  const size_t lag,
+  const double offset,
+  const size_t multiplicity )
+  : SpikeData( target, lag, multiplicity )
   , offset_( offset )
 {
 }
@@ -412,6 +451,7 @@ OffGridSpikeData::operator=( const OffGridSpikeData& rhs )
 {
   lcid_ = rhs.lcid_;
   marker_ = rhs.marker_;
+  multiplicity_ = rhs.multiplicity_;
   lag_ = rhs.lag_;
   tid_ = rhs.tid_;
   syn_id_ = rhs.syn_id_;
@@ -426,6 +466,7 @@ OffGridSpikeData::operator=( const SpikeData& rhs )
   // see example in https://en.cppreference.com/w/cpp/language/access.
   lcid_ = rhs.get_lcid();
   marker_ = rhs.get_marker();
+  multiplicity_ = rhs.get_multiplicity();
   lag_ = rhs.get_lag();
   tid_ = rhs.get_tid();
   syn_id_ = rhs.get_syn_id();
@@ -447,6 +488,7 @@ OffGridSpikeData::set( const size_t tid,
 
   lcid_ = lcid;
   marker_ = SPIKE_DATA_ID_DEFAULT;
+  multiplicity_ = 1;
   lag_ = lag;
   tid_ = tid;
   syn_id_ = syn_id;
@@ -476,15 +518,15 @@ OffGridSpikeData::get_offset() const
  */
 struct SpikeDataWithRank
 {
-  SpikeDataWithRank( const Target& target, const size_t lag );
+  SpikeDataWithRank( const Target& target, const size_t lag, const size_t multiplicity );
 
   const size_t rank;          //!< rank of target neuron
   const SpikeData spike_data; //! data on spike transmitted
 };
 
-inline SpikeDataWithRank::SpikeDataWithRank( const Target& target, const size_t lag )
+inline SpikeDataWithRank::SpikeDataWithRank( const Target& target, const size_t lag, const size_t multiplicity )
   : rank( target.get_rank() )
-  , spike_data( target, lag )
+  , spike_data( target, lag, multiplicity )
 {
 }
 
@@ -495,15 +537,18 @@ inline SpikeDataWithRank::SpikeDataWithRank( const Target& target, const size_t
  */
 struct OffGridSpikeDataWithRank
 {
-  OffGridSpikeDataWithRank( const Target& target, const size_t lag, const double offset );
+  OffGridSpikeDataWithRank( const Target& target, const size_t lag, const double offset, const size_t multiplicity );
 
   const size_t rank;                 //!< rank of target neuron
   const OffGridSpikeData spike_data; //! data on spike transmitted
 };
 
-inline OffGridSpikeDataWithRank::OffGridSpikeDataWithRank( const Target& target, const size_t lag, const double offset )
+inline OffGridSpikeDataWithRank::OffGridSpikeDataWithRank( const Target& target,
+  const size_t lag,
+  const double offset,
+  const size_t multiplicity )
   : rank( target.get_rank() )
-  , spike_data( target, lag, offset )
+  , spike_data( target, lag, offset, multiplicity )
 {
 }
 
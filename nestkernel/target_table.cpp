@@ -83,6 +83,21 @@ nest::TargetTable::compress_secondary_send_buffer_pos( const size_t tid )
   }
 }
 
+void
+nest::TargetTable::get_target_ranks( std::vector< bool >& is_target_rank ) const
+{
+  for ( const auto& targets_per_thread : targets_ )
+  {
+    for ( const auto& targets_per_node : targets_per_thread )
+    {
+      for ( const auto& target : targets_per_node )
+      {
+        is_target_rank[ target.get_rank() ] = true;
+      }
+    }
+  }
+}
+
 void
 nest::TargetTable::add_target( const size_t tid, const size_t target_rank, const TargetData& target_data )
 {
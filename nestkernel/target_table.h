@@ -95,6 +95,11 @@ public:
    */
   const std::vector< Target >& get_targets( const size_t tid, const size_t lid ) const;
 
+  /**
+   * Marks all ranks on which any local neuron has targets.
+   */
+  void get_target_ranks( std::vector< bool >& is_target_rank ) const;
+
   /**
    * Returns all MPI send buffer positions of a neuron.
    *
@@ -109,7 +109,7 @@ nest::TargetTableDevices::get_connections_to_devices_( const size_t requested_so
   const size_t tid,
   const synindex syn_id,
   const long synapse_label,
-  std::deque< ConnectionID >& conns ) const
+  std::vector< ConnectionID >& conns ) const
 {
   if ( requested_source_node_id != 0 )
   {
@@ -135,7 +135,7 @@ nest::TargetTableDevices::get_connections_to_device_for_lid_( const size_t lid,
   const size_t tid,
   const synindex syn_id,
   const long synapse_label,
-  std::deque< ConnectionID >& conns ) const
+  std::vector< ConnectionID >& conns ) const
 {
   if ( target_to_devices_[ tid ][ lid ].size() > 0 )
   {
@@ -155,7 +155,7 @@ nest::TargetTableDevices::get_connections_from_devices_( const size_t requested_
   const size_t tid,
   const synindex syn_id,
   const long synapse_label,
-  std::deque< ConnectionID >& conns ) const
+  std::vector< ConnectionID >& conns ) const
 {
   for ( std::vector< size_t >::const_iterator it = sending_devices_node_ids_[ tid ].begin();
         it != sending_devices_node_ids_[ tid ].end();
@@ -186,7 +186,7 @@ nest::TargetTableDevices::get_connections( const size_t requested_source_node_id
   const size_t tid,
   const synindex syn_id,
   const long synapse_label,
-  std::deque< ConnectionID >& conns ) const
+  std::vector< ConnectionID >& conns ) const
 {
   // collect all connections from neurons to devices
   get_connections_to_devices_( requested_source_node_id, requested_target_node_id, tid, syn_id, synapse_label, conns );
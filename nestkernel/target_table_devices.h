@@ -132,7 +132,7 @@ public:
     const size_t tid,
     const synindex synapse_id,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const;
+    std::vector< ConnectionID >& conns ) const;
 
   /**
    * Returns all connections from particular neuron to devices.
@@ -142,7 +142,7 @@ public:
     const size_t tid,
     const synindex syn_id,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const;
+    std::vector< ConnectionID >& conns ) const;
 
   /**
    * Returns all connections from devices to neurons.
@@ -152,7 +152,7 @@ public:
     const size_t tid,
     const synindex synapse_id,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const;
+    std::vector< ConnectionID >& conns ) const;
 
   /**
    * Returns all connections between neurons and devices.
@@ -162,7 +162,7 @@ public:
     const size_t tid,
     const synindex synapse_id,
     const long synapse_label,
-    std::deque< ConnectionID >& conns ) const;
+    std::vector< ConnectionID >& conns ) const;
 
   /**
    * Returns synapse status of connection from neuron to device.
@@ -253,7 +253,7 @@ TargetTableDevices::is_device_connected( const size_t tid, const size_t lcid ) c
   {
     if ( synapse )
     {
-      std::deque< ConnectionID > conns;
+      std::vector< ConnectionID > conns;
       synapse->get_all_connections( lcid, 0, tid, UNLABELED_CONNECTION, conns );
       if ( not conns.empty() )
       {
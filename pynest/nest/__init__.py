@@ -97,6 +97,7 @@ class NestModule(types.ModuleType):
         _rel_import_star(self, ".lib.hl_api_models")  # noqa: F821
         _rel_import_star(self, ".lib.hl_api_nodes")  # noqa: F821
         _rel_import_star(self, ".lib.hl_api_parallel_computing")  # noqa: F821
+        _rel_import_star(self, ".lib.hl_api_recording")  # noqa: F821
         _rel_import_star(self, ".lib.hl_api_simulation")  # noqa: F821
         _rel_import_star(self, ".lib.hl_api_sonata")  # noqa: F821
         _rel_import_star(self, ".lib.hl_api_spatial")  # noqa: F821
@@ -315,6 +316,35 @@ class NestModule(types.ModuleType):
         ),
         default=True,
     )
+    sort_spikes_by_thread = KernelAttribute(
+        "bool",
+        (
+            "Whether to sort spikes in MPI buffers by target thread, so that each"
+            + " thread only reads the spikes it needs to deliver; has no effect if"
+            + " ``use_compressed_spikes`` is set."
+        ),
+        default=False,
+    )
+    overlap_spike_communication = KernelAttribute(
+        "bool",
+        (
+            "Whether to exchange spikes between MPI processes while the next"
+            + " time slice is updated; time slices then cover at most half the"
+            + " smallest delay; cannot be changed after ``Simulate`` has been called."
+        ),
+        default=False,
+    )
+    spike_exchange_mode = KernelAttribute(
+        "str",
+        (
+            "Collective operation used to exchange spikes between MPI processes:"
+            + " ``alltoall`` sends a chunk of fixed size to every process,"
+            + " ``alltoallv`` sends only the spikes present after exchanging their"
+            + " number, ``neighbor_alltoallv`` does so only between processes"
+            + " connected by synapses; cannot be changed after ``Simulate`` has been called."
+        ),
+        default="alltoall",
+    )
     data_path = KernelAttribute(
         "str",
         "A path, where all data is written to, defaults to current directory",
@@ -348,6 +378,11 @@ class NestModule(types.ModuleType):
         "The list of the available synapse models",
         readonly=True,
     )
+    bytes_per_synapse = KernelAttribute(
+        "dict",
+        "Size of a single connection in bytes for each synapse model",
+        readonly=True,
+    )
     local_spike_counter = KernelAttribute(
         "int",
         (
@@ -368,6 +403,24 @@ class NestModule(types.ModuleType):
         "List of available backends for stimulation devices",
         readonly=True,
     )
+    align_nodes_to_cache_lines = KernelAttribute(
+        "bool",
+        (
+            "Whether to align nodes in memory to cache lines of 64 bytes;"
+            + " can only be changed before nodes are created."
+        ),
+        default=False,
+    )
+    node_memory = KernelAttribute(
+        "dict",
+        (
+            "Memory pools for nodes, summed over all models and threads: number"
+            + " of nodes (``instantiations``), of slots allocated (``capacity``)"
+            + " and of free slots (``available``), bytes allocated (``bytes``) and"
+            + " alignment of nodes in bytes (``alignment``)."
+        ),
+        readonly=True,
+    )
     dict_miss_is_error = KernelAttribute(
         "bool",
         "Whether missed dictionary entries are treated as errors",
@@ -172,6 +172,7 @@ def _process_spatial_projections(conn_spec, syn_spec):
         "pairwise_avg_num_conns",
         "use_on_source",
         "allow_oversized_mask",
+        "use_local_source_positions",
     ]
     allowed_syn_spec_keys = ["weight", "delay", "synapse_model", "synapse_label", "receptor_type"]
     for key in conn_spec.keys():
@@ -26,7 +26,7 @@ Functions for connection handling
 import numpy
 
 from .. import pynestkernel as kernel
-from ..ll_api import check_stack, connect_arrays, spp, sps, sr
+from ..ll_api import check_stack, connect_arrays, get_connection_columns, sps, sr
 from .hl_api_connection_helpers import (
     _connect_layers_needed,
     _connect_spatial,
@@ -102,15 +102,13 @@ def GetConnections(source=None, target=None, synapse_model=None, synapse_label=N
     if synapse_label is not None:
         params["synapse_label"] = synapse_label
 
-    sps(params)
-    sr("GetConnections")
+    # Connections are returned as arrays, from which connection datums are only created when needed
+    columns = get_connection_columns(params)
 
-    conns = spp()
+    if len(columns["source"]) == 0:
+        return SynapseCollection(None)
 
-    if isinstance(conns, tuple):
-        conns = SynapseCollection(None)
-
-    return conns
+    return SynapseCollection(columns)
 
 
 @check_stack
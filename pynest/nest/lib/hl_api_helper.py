@@ -32,8 +32,10 @@ import textwrap
 import warnings
 from string import Template
 
+import numpy
+
 from .. import pynestkernel as kernel
-from ..ll_api import sli_func, spp, sps, sr
+from ..ll_api import get_node_values, sli_func, spp, sps, sr
 
 __all__ = [
     "broadcast",
@@ -518,20 +520,28 @@ def get_parameters(nc, param):
     """
     # param is single literal
     if is_literal(param):
-        cmd = "/{} get".format(param)
-        sps(nc._datum)
-        try:
-            sr(cmd)
-            result = spp()
-        except kernel.NESTError:
-            result = nc.get()[param]  # If the NodeCollection is a composite.
+        param_names = [param]
     # param is array of strings
     elif is_iterable(param):
-        result = {param_name: nc.get(param_name) for param_name in param}
+        param_names = list(param)
     else:
         raise TypeError("Params should be either a string or an iterable")
 
-    return result
+    try:
+        # Values are collected in the kernel, so status dictionaries are not converted
+        values = get_node_values(nc._datum, param_names)
+    except kernel.NESTError:
+        values = nc.get()  # If the NodeCollection is a composite.
+        result = {param_name: values[param_name] for param_name in param_names}
+    else:
+        result = {}
+        for param_name in param_names:
+            param_values = values[param_name]
+            if isinstance(param_values, numpy.ndarray):
+                param_values = tuple(param_values.tolist())
+            result[param_name] = param_values[0] if len(nc) == 1 else param_values
+
+    return result[param] if is_literal(param) else result
 
 
 def get_parameters_hierarchical_addressing(nc, params):
@@ -28,7 +28,7 @@ import warnings
 import nest
 
 from .. import pynestkernel as kernel
-from ..ll_api import check_stack, sli_func, spp, sps, sr
+from ..ll_api import check_stack, create_nodes, sli_func, spp, sps, sr
 from .hl_api_helper import is_iterable, model_deprecation_warning
 from .hl_api_info import SetStatus
 from .hl_api_types import NodeCollection, Parameter
@@ -136,13 +136,17 @@ def Create(model, n=1, params=None, positions=None):
         if not iterable_or_parameter_in_params:
             cmd = "/%s 3 1 roll exch Create" % model
             sps(params)
+            sps(n)
+            sr(cmd)
+            node_ids = spp()
+        elif isinstance(n, dict):
+            # Parameters given in place of the number of nodes are passed on to SLI
+            sps(n)
+            sr("/%s exch Create" % model)
+            node_ids = spp()
         else:
-            cmd = "/%s exch Create" % model
-
-        sps(n)
-        sr(cmd)
-
-        node_ids = spp()
+            # No parameters to pass on creation, so we can bypass SLI
+            node_ids = create_nodes(model, n)
 
     if params is not None and iterable_or_parameter_in_params:
         try:
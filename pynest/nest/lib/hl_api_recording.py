@@ -0,0 +1,130 @@
+# -*- coding: utf-8 -*-
+#
+# hl_api_recording.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Functions to read data written by recording backends
+"""
+
+import struct
+
+import numpy as np
+
+__all__ = [
+    "read_binary_recording",
+]
+
+_BINARY_MAGIC = b"NESTBIN\0"
+_BINARY_VERSION = 1
+_BINARY_BYTE_ORDER_MARK = 0x01020304
+_BINARY_COLUMN_TYPES = {"u": "u8", "i": "i8", "f": "f8"}
+
+
+def read_binary_recording(filename):
+    """Read a file written by the ``binary`` recording backend.
+
+    The file is memory-mapped. If all records of the file are stored in
+    a single block, the returned arrays are views of the mapped file and
+    no data is copied. Otherwise, the blocks of each column are
+    concatenated.
+
+    Parameters
+    ----------
+    filename : str
+        Name of the file, as given by the ``filenames`` property of the
+        recording device.
+
+    Returns
+    -------
+    dict:
+        NumPy arrays with the values of the records, one for each column
+        of the file. Keys are the column names, e.g., ``sender``,
+        ``time_ms`` and the names of recorded quantities.
+
+    Raises
+    ------
+    ValueError
+        If the file was not written by the ``binary`` recording backend
+        or is truncated.
+    """
+
+    data = np.memmap(filename, dtype=np.uint8, mode="r")
+
+    if data[:8].tobytes() != _BINARY_MAGIC:
+        raise ValueError(f"'{filename}' was not written by the binary recording backend.")
+
+    mark = data[12:16].tobytes()
+    if struct.unpack("<I", mark)[0] == _BINARY_BYTE_ORDER_MARK:
+        byte_order = "<"
+    elif struct.unpack(">I", mark)[0] == _BINARY_BYTE_ORDER_MARK:
+        byte_order = ">"
+    else:
+        raise ValueError(f"Invalid byte order mark in '{filename}'.")
+
+    version = struct.unpack(byte_order + "I", data[8:12].tobytes())[0]
+    if version != _BINARY_VERSION:
+        raise ValueError(f"Unsupported version {version} of binary recording file '{filename}'.")
+
+    header_size = int(data[16:24].view(byte_order + "u8")[0])
+    header = data[:header_size].tobytes()
+    pos = 24
+
+    def unpack(fmt):
+        nonlocal pos
+        (value,) = struct.unpack_from(byte_order + fmt, header, pos)
+        pos += struct.calcsize(byte_order + fmt)
+        return value
+
+    def unpack_string():
+        nonlocal pos
+        length = unpack("I")
+        value = header[pos : pos + length].decode()
+        pos += length
+        return value
+
+    unpack_string()  # NEST version
+    columns = []
+    for _ in range(unpack("I")):
+        column_type = chr(unpack("B"))
+        columns.append((unpack_string(), np.dtype(byte_order + _BINARY_COLUMN_TYPES[column_type])))
+
+    blocks = {name: [] for name, _ in columns}
+    offset = header_size
+    while offset < len(data):
+        if offset + 8 > len(data):
+            raise ValueError(f"Binary recording file '{filename}' is truncated.")
+        num_records = int(data[offset : offset + 8].view(byte_order + "u8")[0])
+        offset += 8
+        if offset + 8 * num_records * len(columns) > len(data):
+            raise ValueError(f"Binary recording file '{filename}' is truncated.")
+        for name, dtype in columns:
+            blocks[name].append(data[offset : offset + 8 * num_records].view(dtype))
+            offset += 8 * num_records
+
+    result = {}
+    for name, dtype in columns:
+        if len(blocks[name]) == 1:
+            result[name] = blocks[name][0]
+        elif blocks[name]:
+            result[name] = np.concatenate(blocks[name])
+        else:
+            result[name] = np.empty(0, dtype=dtype)
+
+    return result
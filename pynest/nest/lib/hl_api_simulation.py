@@ -35,10 +35,12 @@ __all__ = [
     "EnableStructuralPlasticity",
     "GetKernelStatus",
     "Install",
+    "LoadNetwork",
     "Prepare",
     "ResetKernel",
     "Run",
     "RunManager",
+    "SaveNetwork",
     "SetKernelStatus",
     "Simulate",
 ]
@@ -332,6 +334,67 @@ def Install(module_name):
     return sr("(%s) Install" % module_name)
 
 
+@check_stack
+def SaveNetwork(path):
+    """Write nodes and connections of the network to a binary snapshot.
+
+    The snapshot contains the models and parameters of all nodes and all
+    connections between neurons. It allows :py:func:`.LoadNetwork` to skip
+    the construction of large networks in subsequent runs.
+
+    Parameters
+    ----------
+    path : str
+        Name of the snapshot file. With more than one MPI process, each
+        process writes its own file, with the rank appended to `path`.
+
+    Raises
+    ------
+    NESTError
+        If the network has already been simulated, contains connections to
+        or from devices, or uses synapse models that do not support
+        snapshots.
+
+    Notes
+    -----
+    Snapshots store connections in the binary representation of their
+    synapse model. They can only be loaded by the same build of NEST with
+    the same numbers of MPI processes and threads and the same resolution.
+    Devices have to be connected after loading the network.
+
+    See Also
+    --------
+    LoadNetwork
+
+    """
+
+    sps(str(path))
+    sr("SaveNetwork")
+
+
+@check_stack
+def LoadNetwork(path):
+    """Create nodes and connections from a binary snapshot.
+
+    The network must be empty. Synapse models created by
+    :py:func:`.CopyModel` before saving the snapshot must be created again
+    before loading it.
+
+    Parameters
+    ----------
+    path : str
+        Name of the snapshot file written by :py:func:`.SaveNetwork`
+
+    See Also
+    --------
+    SaveNetwork
+
+    """
+
+    sps(str(path))
+    sr("LoadNetwork")
+
+
 @check_stack
 def EnableStructuralPlasticity():
     """Enable structural plasticity for the network simulation
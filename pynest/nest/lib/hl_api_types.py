@@ -30,7 +30,17 @@ from math import floor, log
 import numpy
 
 from .. import pynestkernel as kernel
-from ..ll_api import sli_func, spp, sps, sr, take_array_index
+from ..ll_api import (
+    connection_datums,
+    get_connection_values,
+    set_connection_values,
+    set_node_values,
+    sli_func,
+    spp,
+    sps,
+    sr,
+    take_array_index,
+)
 from .hl_api_helper import (
     broadcast,
     get_parameters,
@@ -489,6 +499,12 @@ class NodeCollection:
             ]
 
             if any(contains_list):
+                values = _float_values_array(params, node_params, self.__len__())
+                if values is not None:
+                    # Values are passed to the kernel as array, so no dictionary per node is needed
+                    set_node_values(self._datum, list(params.keys()), values)
+                    return
+
                 temp_param = [{} for _ in range(self.__len__())]
 
                 for key, vals in params.items():
@@ -605,10 +621,15 @@ class SynapseCollection:
     A SynapseCollection is created by the :py:func:`.GetConnections` function.
     """
 
-    _datum = None
+    _columns = None
+    _datums = None
 
     def __init__(self, data):
-        if isinstance(data, list):
+        if isinstance(data, dict):
+            # Arrays of source, target, target_thread, synapse_id and port as returned by the kernel.
+            # Connection datums are only created when they are needed to access the connections in SLI.
+            self._columns = data
+        elif isinstance(data, list):
             for datum in data:
                 if not isinstance(datum, kernel.SLIDatum) or datum.dtype != "connectiontype":
                     raise TypeError("Expected Connection Datum.")
@@ -624,10 +645,22 @@ class SynapseCollection:
 
         self.print_full = False
 
+    @property
+    def _datum(self):
+        if self._datums is None and self._columns is not None:
+            self._datums = connection_datums(self._columns)
+        return self._datums
+
+    @_datum.setter
+    def _datum(self, datums):
+        self._datums = datums
+
     def __iter__(self):
         return SynapseCollectionIterator(self)
 
     def __len__(self):
+        if self._columns is not None:
+            return len(self._columns["source"])
         if self._datum is None:
             return 0
         return len(self._datum)
@@ -650,6 +683,9 @@ class SynapseCollection:
         return not self == other
 
     def __getitem__(self, key):
+        if self._columns is not None:
+            index = key if isinstance(key, slice) else [key]
+            return SynapseCollection({name: column[index] for name, column in self._columns.items()})
         if isinstance(key, slice):
             return SynapseCollection(self._datum[key])
         else:
@@ -745,9 +781,9 @@ class SynapseCollection:
         return self.get(attr)
 
     def __setattr__(self, attr, value):
-        # `_datum` is the only property of SynapseCollection that should not be
-        # interpreted as a property of the model
-        if attr == "_datum" or attr == "print_full":
+        # `_datum`, its columns and `print_full` are the only properties of
+        # SynapseCollection that should not be interpreted as properties of the model
+        if attr in ("_datum", "_datums", "_columns", "print_full"):
             super().__setattr__(attr, value)
         else:
             self.set({attr: value})
@@ -836,23 +872,29 @@ class SynapseCollection:
             # Return empty tuple if get is called with an argument
             return {} if keys is None else ()
 
-        if keys is None:
-            cmd = "GetStatus"
-        elif is_literal(keys):
-            #  Extracting the correct values will be done in restructure_data below
-            cmd = "GetStatus"
-        elif is_iterable(keys):
-            keys_str = " ".join("/{0}".format(x) for x in keys)
-            cmd = "GetStatus {{ [ [ {0} ] ] get }} Map".format(keys_str)
-        else:
-            raise TypeError("keys should be either a string or an iterable")
+        final_result = None
+        if self._columns is not None and keys is not None:
+            # Values are read from the columns and the kernel as arrays, without creating connection datums
+            final_result = self._get_values(keys)
+
+        if final_result is None:
+            if keys is None:
+                cmd = "GetStatus"
+            elif is_literal(keys):
+                #  Extracting the correct values will be done in restructure_data below
+                cmd = "GetStatus"
+            elif is_iterable(keys):
+                keys_str = " ".join("/{0}".format(x) for x in keys)
+                cmd = "GetStatus {{ [ [ {0} ] ] get }} Map".format(keys_str)
+            else:
+                raise TypeError("keys should be either a string or an iterable")
 
-        sps(self._datum)
-        sr(cmd)
-        result = spp()
+            sps(self._datum)
+            sr(cmd)
+            result = spp()
 
-        # Need to restructure the data.
-        final_result = restructure_data(result, keys)
+            # Need to restructure the data.
+            final_result = restructure_data(result, keys)
 
         if pandas_output:
             index = self.get("source") if self.__len__() > 1 else (self.get("source"),)
@@ -864,6 +906,30 @@ class SynapseCollection:
 
         return final_result
 
+    def _get_values(self, keys):
+        """
+        Return the values of `keys` in the same form as `restructure_data`.
+
+        Connection identifiers are taken from the columns, other parameters are read by the kernel. Returns None
+        if a parameter cannot be read this way, e.g., because it is not a floating point parameter.
+        """
+        key_list = [keys] if is_literal(keys) else keys
+        if not (is_iterable(key_list) and all(is_literal(key) for key in key_list)):
+            return None
+
+        result = {}
+        for key in key_list:
+            if key in self._columns:
+                values = self._columns[key]
+            else:
+                try:
+                    values = get_connection_values(self._columns, key)
+                except kernel.NESTError:
+                    return None
+            result[key] = values.tolist()[0] if self.__len__() == 1 else values.tolist()
+
+        return result[keys] if is_literal(keys) else result
+
     def set(self, params=None, **kwargs):
         """
         Set the parameters of the connections to `params`.
@@ -911,6 +977,13 @@ class SynapseCollection:
 
         if isinstance(params, dict):
             node_params = self[0].get()
+            if self._columns is not None:
+                values = _float_values_array(params, node_params, self.__len__())
+                if values is not None:
+                    # Values are passed to the kernel as array, so no dictionary per connection is needed
+                    set_connection_values(self._columns, list(params.keys()), values)
+                    return
+
             contains_list = [
                 is_iterable(vals) and key in node_params and not is_iterable(node_params[key])
                 for key, vals in params.items()
@@ -1277,3 +1350,28 @@ def to_json(data, **kwargs):
     data_serialized = serialize_data(data)
     data_json = json.dumps(data_serialized, **kwargs)
     return data_json
+
+
+def _float_values_array(params, element_params, num_elements):
+    """
+    Return values in `params` as array with one row per key, or None if not all are floating point values.
+
+    Each value can be a single number or a list of `num_elements` numbers. Keys are considered floating point
+    parameters if they are of type float in the parameters `element_params` of a single element.
+    """
+
+    rows = []
+    for key, vals in params.items():
+        if not isinstance(element_params.get(key), float) or isinstance(vals, (str, dict, Parameter)):
+            return None
+        try:
+            row = numpy.asarray(vals, dtype=float)
+        except (TypeError, ValueError):
+            return None
+        if row.ndim == 0:
+            row = numpy.full(num_elements, row)
+        elif row.shape != (num_elements,):
+            return None
+        rows.append(row)
+
+    return numpy.array(rows)
@@ -55,9 +55,16 @@ from . import pynestkernel as kernel  # noqa pylint: disable=no-name-in-module
 __all__ = [
     "check_stack",
     "connect_arrays",
+    "connection_datums",
+    "create_nodes",
+    "get_connection_columns",
+    "get_connection_values",
+    "get_node_values",
     "set_communicator",
+    "set_connection_values",
     "get_debug",
     "set_debug",
+    "set_node_values",
     "sli_func",
     "sli_pop",
     "sli_push",
@@ -76,6 +83,13 @@ sli_push = sps = engine.push
 sli_pop = spp = engine.pop
 take_array_index = engine.take_array_index
 connect_arrays = engine.connect_arrays
+connection_datums = engine.connection_datums
+get_connection_columns = engine.get_connections
+get_connection_values = engine.get_connection_values
+set_connection_values = engine.set_connection_values
+create_nodes = engine.create
+get_node_values = engine.get_values
+set_node_values = engine.set_values
 
 
 def catching_sli_run(cmd):
@@ -149,6 +149,12 @@ cdef extern from "nest.h" namespace "nest":
     Datum* node_collection_array_index(const Datum* node_collection, const long* array, unsigned long n) except +
     Datum* node_collection_array_index(const Datum* node_collection, const cbool* array, unsigned long n) except +
     void connect_arrays( long* sources, long* targets, double* weights, double* delays, vector[string]& p_keys, double* p_values, size_t n, string syn_model ) except +
+    Datum* create_node_collection(const string& model_name, long n) except +
+    Datum* node_collection_get_values(const Datum* node_collection, const vector[string]& keys) except +
+    void node_collection_set_values(const Datum* node_collection, const vector[string]& keys, const double* values, unsigned long n) except +
+    Datum* get_connection_columns(const Datum* params) except +
+    void get_connection_values(const long* sources, const long* targets, const long* threads, const long* synapse_ids, const long* ports, unsigned long n, const string& key, double* values) except +
+    void set_connection_values(const long* sources, const long* targets, const long* threads, const long* synapse_ids, const long* ports, unsigned long n, const vector[string]& keys, const double* values) except +
 
 cdef extern from *:
 
@@ -355,6 +355,186 @@ cdef class NESTEngine:
             exceptionCls = getattr(NESTErrors, str(e))
             raise exceptionCls('connect_arrays', '') from None
 
+    def create(self, model, n):
+        """Calls create_node_collection, bypassing SLI to create nodes without parameters"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+
+        cdef string model_string = str(model).encode('UTF-8')
+        cdef Datum* nc_datum = NULL
+
+        try:
+            nc_datum = create_node_collection(model_string, n)
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('create', '') from None
+
+        try:
+            return sli_datum_to_object(nc_datum)
+        finally:
+            del nc_datum
+
+    def get_values(self, node_collection, keys):
+        """Calls node_collection_get_values, bypassing SLI to return the values of the given properties as arrays"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+
+        if not (isinstance(node_collection, SLIDatum) and (<SLIDatum> node_collection).dtype == SLI_TYPE_NODECOLLECTION.decode()):
+            raise TypeError('node_collection must be a NodeCollection, got {}'.format(type(node_collection)))
+
+        cdef vector[string] keys_vector
+        for key in keys:
+            keys_vector.push_back(key.encode('UTF-8'))
+
+        cdef Datum* values_datum = NULL
+
+        try:
+            values_datum = node_collection_get_values((<SLIDatum> node_collection).thisptr, keys_vector)
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('get_values', '') from None
+
+        try:
+            return sli_datum_to_object(values_datum)
+        finally:
+            del values_datum
+
+    def set_values(self, node_collection, keys, values):
+        """Calls node_collection_set_values, bypassing SLI to set one value per node for each key"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        if not (isinstance(node_collection, SLIDatum) and (<SLIDatum> node_collection).dtype == SLI_TYPE_NODECOLLECTION.decode()):
+            raise TypeError('node_collection must be a NodeCollection, got {}'.format(type(node_collection)))
+        if not (isinstance(values, numpy.ndarray) and values.ndim == 2):
+            raise TypeError('values must be a 2-dimensional NumPy array')
+        if not len(keys) == values.shape[0]:
+            raise ValueError('values must be a matrix with one array per key in keys.')
+
+        cdef vector[string] keys_vector
+        for key in keys:
+            keys_vector.push_back(key.encode('UTF-8'))
+
+        cdef double[:, ::1] values_mv = numpy.ascontiguousarray(values, dtype=numpy.double)
+
+        # An empty array has no first element, the kernel then only checks the number of values
+        cdef const double* values_ptr = NULL
+        if values_mv.shape[0] > 0 and values_mv.shape[1] > 0:
+            values_ptr = &values_mv[0, 0]
+
+        try:
+            node_collection_set_values((<SLIDatum> node_collection).thisptr, keys_vector, values_ptr, values.shape[1])
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('set_values', '') from None
+
+    def get_connections(self, params):
+        """Calls get_connection_columns, bypassing SLI to return the selected connections as arrays"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+
+        cdef Datum* params_datum = python_object_to_datum(params)
+        cdef Datum* columns_datum = NULL
+
+        try:
+            columns_datum = get_connection_columns(params_datum)
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('get_connections', '') from None
+        finally:
+            del params_datum
+
+        try:
+            return sli_datum_to_object(columns_datum)
+        finally:
+            del columns_datum
+
+    def get_connection_values(self, columns, key):
+        """Calls get_connection_values, bypassing SLI to return one parameter of the connections as array"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        cdef long[::1] sources_mv = numpy.ascontiguousarray(columns['source'], dtype=int)
+        cdef long[::1] targets_mv = numpy.ascontiguousarray(columns['target'], dtype=int)
+        cdef long[::1] threads_mv = numpy.ascontiguousarray(columns['target_thread'], dtype=int)
+        cdef long[::1] synapse_ids_mv = numpy.ascontiguousarray(columns['synapse_id'], dtype=int)
+        cdef long[::1] ports_mv = numpy.ascontiguousarray(columns['port'], dtype=int)
+
+        cdef size_t n = sources_mv.shape[0]
+        values = numpy.empty(n, dtype=numpy.double)
+        if n == 0:
+            return values
+
+        cdef double[::1] values_mv = values
+        cdef string key_string = key.encode('UTF-8')
+
+        try:
+            get_connection_values(&sources_mv[0], &targets_mv[0], &threads_mv[0], &synapse_ids_mv[0], &ports_mv[0], n, key_string, &values_mv[0])
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('get_connection_values', '') from None
+
+        return values
+
+    def set_connection_values(self, columns, keys, values):
+        """Calls set_connection_values, bypassing SLI to set one value per connection for each key"""
+        if self.pEngine is NULL:
+            raise NESTErrors.PyNESTError("engine uninitialized")
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        cdef long[::1] sources_mv = numpy.ascontiguousarray(columns['source'], dtype=int)
+        cdef long[::1] targets_mv = numpy.ascontiguousarray(columns['target'], dtype=int)
+        cdef long[::1] threads_mv = numpy.ascontiguousarray(columns['target_thread'], dtype=int)
+        cdef long[::1] synapse_ids_mv = numpy.ascontiguousarray(columns['synapse_id'], dtype=int)
+        cdef long[::1] ports_mv = numpy.ascontiguousarray(columns['port'], dtype=int)
+
+        cdef size_t n = sources_mv.shape[0]
+        if not (isinstance(values, numpy.ndarray) and values.ndim == 2):
+            raise TypeError('values must be a 2-dimensional NumPy array')
+        if not (len(keys) == values.shape[0] and n == values.shape[1]):
+            raise ValueError('values must be a matrix with one array per key in keys and one column per connection.')
+        if n == 0 or len(keys) == 0:
+            return
+
+        cdef vector[string] keys_vector
+        for key in keys:
+            keys_vector.push_back(key.encode('UTF-8'))
+
+        cdef double[:, ::1] values_mv = numpy.ascontiguousarray(values, dtype=numpy.double)
+
+        try:
+            set_connection_values(&sources_mv[0], &targets_mv[0], &threads_mv[0], &synapse_ids_mv[0], &ports_mv[0], n, keys_vector, &values_mv[0][0])
+        except RuntimeError as e:
+            exceptionCls = getattr(NESTErrors, str(e))
+            raise exceptionCls('set_connection_values', '') from None
+
+    def connection_datums(self, columns):
+        """Creates a list of connection datums from arrays returned by get_connections"""
+        if not HAVE_NUMPY:
+            raise NESTErrors.PyNESTError("NumPy is not available")
+
+        cdef long[::1] sources_mv = numpy.ascontiguousarray(columns['source'], dtype=int)
+        cdef long[::1] targets_mv = numpy.ascontiguousarray(columns['target'], dtype=int)
+        cdef long[::1] threads_mv = numpy.ascontiguousarray(columns['target_thread'], dtype=int)
+        cdef long[::1] synapse_ids_mv = numpy.ascontiguousarray(columns['synapse_id'], dtype=int)
+        cdef long[::1] ports_mv = numpy.ascontiguousarray(columns['port'], dtype=int)
+
+        cdef size_t i
+        cdef size_t n = sources_mv.shape[0]
+        cdef tmp = [None] * n
+
+        for i in range(n):
+            datum = SLIDatum()
+            (<SLIDatum> datum)._set_datum(<Datum*> new ConnectionDatum(ConnectionID(sources_mv[i], targets_mv[i], threads_mv[i], synapse_ids_mv[i], ports_mv[i])), SLI_TYPE_CONNECTION.decode())
+            tmp[i] = datum
+
+        return tmp
+
 cdef inline Datum* python_object_to_datum(obj) except NULL:
 
     cdef Datum* ret = NULL
@@ -27,6 +27,7 @@ sli::pool::pool()
   , growth_factor( 1 )
   , block_size( initial_block_size )
   , el_size( sizeof( link ) )
+  , alignment( alignof( link ) )
   , instantiations( 0 )
   , total( 0 )
   , capacity( 0 )
@@ -41,6 +42,7 @@ sli::pool::pool( const sli::pool& p )
   , growth_factor( p.growth_factor )
   , block_size( initial_block_size )
   , el_size( sizeof( link ) )
+  , alignment( p.alignment )
   , instantiations( 0 )
   , total( 0 )
   , capacity( 0 )
@@ -51,11 +53,12 @@ sli::pool::pool( const sli::pool& p )
 }
 
 
-sli::pool::pool( size_t n, size_t initial, size_t growth )
+sli::pool::pool( size_t n, size_t initial, size_t growth, size_t align )
   : initial_block_size( initial )
   , growth_factor( growth )
   , block_size( initial_block_size )
-  , el_size( ( n < sizeof( link ) ) ? sizeof( link ) : n )
+  , el_size( 0 )
+  , alignment( align )
   , instantiations( 0 )
   , total( 0 )
   , capacity( 0 )
@@ -63,19 +66,23 @@ sli::pool::pool( size_t n, size_t initial, size_t growth )
   , head( nullptr )
   , initialized_( true )
 {
+  assert( alignment >= alignof( link ) and ( alignment & ( alignment - 1 ) ) == 0 );
+  el_size = aligned_size_( n );
 }
 
 void
-sli::pool::init( size_t n, size_t initial, size_t growth )
+sli::pool::init( size_t n, size_t initial, size_t growth, size_t align )
 {
   assert( instantiations == 0 );
+  assert( align >= alignof( link ) and ( align & ( align - 1 ) ) == 0 );
 
   initialized_ = true;
 
   initial_block_size = initial;
   growth_factor = growth;
   block_size = initial_block_size;
-  el_size = ( n < sizeof( link ) ) ? sizeof( link ) : n;
+  alignment = align;
+  el_size = aligned_size_( n );
   instantiations = 0;
   total = 0;
   capacity = 0;
@@ -106,6 +113,7 @@ sli::pool::operator=( const sli::pool& p )
   growth_factor = p.growth_factor;
   block_size = initial_block_size;
   el_size = p.el_size;
+  alignment = p.alignment;
   instantiations = 0;
   total = 0;
   chunks = nullptr;
@@ -115,10 +123,17 @@ sli::pool::operator=( const sli::pool& p )
   return *this;
 }
 
+size_t
+sli::pool::aligned_size_( size_t n ) const
+{
+  const size_t size = ( n < sizeof( link ) ) ? sizeof( link ) : n;
+  return ( size + alignment - 1 ) / alignment * alignment;
+}
+
 void
 sli::pool::grow( size_t nelements )
 {
-  chunk* n = new chunk( nelements * el_size );
+  chunk* n = new chunk( nelements * el_size, alignment );
   total += nelements;
 
   n->next = chunks;
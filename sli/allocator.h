@@ -29,6 +29,7 @@
 // C++ includes:
 #include <cassert>
 #include <cstdlib>
+#include <new>
 #include <string>
 
 namespace sli
@@ -63,6 +64,7 @@ class pool
   class chunk
   {
     const size_t csize;
+    const size_t calign;
     chunk( const chunk& );            //!< not implemented
     chunk& operator=( const chunk& ); //!< not implemented
 
@@ -70,16 +72,17 @@ class pool
     chunk* next;
     char* mem;
 
-    explicit chunk( size_t s )
+    chunk( size_t s, size_t a )
       : csize( s )
+      , calign( a )
       , next( nullptr )
-      , mem( new char[ csize ] )
+      , mem( static_cast< char* >( ::operator new[]( csize, std::align_val_t( calign ) ) ) )
     {
     }
 
     ~chunk()
     {
-      delete[] mem;
+      ::operator delete[]( mem, std::align_val_t( calign ) );
       mem = nullptr;
     }
 
@@ -94,7 +97,8 @@ class pool
   size_t growth_factor;
 
   size_t block_size;     //!< number of elements per chunk
-  size_t el_size;        //!< sizeof an element
+  size_t el_size;        //!< sizeof an element, rounded up to a multiple of alignment
+  size_t alignment;      //!< alignment of chunks and elements in bytes
   size_t instantiations; //!< number of instantiated elements
   size_t total;          //!< total number of allocated elements
   size_t capacity;       //!< number of free elements
@@ -112,13 +116,15 @@ public:
    *  block size, i.e. the number of objects per block.
    *  growth is the factor by which the allocations block increases after
    *  each growth.
+   *  align is the alignment of all objects in bytes; it must be a power of
+   *  two and at least the alignment required by the objects.
    */
   pool();
   pool( const pool& );
   pool& operator=( const pool& );
 
-  explicit pool( size_t n, size_t initial = 100, size_t growth = 1 );
-  void init( size_t n, size_t initial = 100, size_t growth = 1 );
+  explicit pool( size_t n, size_t initial = 100, size_t growth = 1, size_t align = alignof( link ) );
+  void init( size_t n, size_t initial = 100, size_t growth = 1, size_t align = alignof( link ) );
 
   ~pool(); //!< deallocate ALL memory
 
@@ -149,6 +155,11 @@ public:
   inline size_t get_el_size() const;
   inline size_t get_instantiations() const;
   inline size_t get_total() const;
+  inline size_t get_alignment() const;
+
+private:
+  //! Return n rounded up to a multiple of alignment, but at least the size of a link
+  size_t aligned_size_( size_t n ) const;
 };
 
 inline void*
@@ -195,6 +206,12 @@ pool::get_total() const
 {
   return total;
 }
+
+inline size_t
+pool::get_alignment() const
+{
+  return alignment;
+}
 }
 
 #ifdef USE_PMA
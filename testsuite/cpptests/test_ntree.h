@@ -0,0 +1,506 @@
+/*
+ *  test_ntree.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef TEST_NTREE_H
+#define TEST_NTREE_H
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+// C++ includes:
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Includes from nestkernel:
+#include "mask_impl.h"
+#include "ntree_impl.h"
+#include "spatial_hash_impl.h"
+
+namespace nest
+{
+
+/**
+ * Check that Ntree::insert_bulk() builds the same tree as inserting nodes one by one.
+ */
+template < int D >
+void
+check_insert_bulk( const size_t num_nodes, const std::bitset< D > periodic )
+{
+  std::mt19937_64 rng( 12345 );
+  std::uniform_real_distribution< double > dist( -0.5, 0.5 );
+
+  // Some nodes share positions, so that leaves are filled to max_depth.
+  std::vector< std::pair< Position< D >, size_t > > nodes;
+  for ( size_t i = 0; i < num_nodes; ++i )
+  {
+    Position< D > pos;
+    for ( int j = 0; j < D; ++j )
+    {
+      pos[ j ] = i % 10 == 0 ? 0.25 : dist( rng );
+    }
+    nodes.push_back( std::make_pair( pos, i ) );
+  }
+
+  const Position< D > lower_left( std::vector< double >( D, -0.5 ) );
+  const Position< D > extent( std::vector< double >( D, 1.0 ) );
+  Ntree< D, size_t > inserted( lower_left, extent, periodic );
+  for ( const auto& node : nodes )
+  {
+    inserted.insert( node );
+  }
+  Ntree< D, size_t > bulk( lower_left, extent, periodic );
+  bulk.insert_bulk( nodes );
+
+  // Iteration visits leaves in order, and nodes within leaves in order.
+  std::vector< size_t > inserted_ids;
+  for ( auto it = inserted.begin(); it != inserted.end(); ++it )
+  {
+    inserted_ids.push_back( it->second );
+  }
+  std::vector< size_t > bulk_ids;
+  for ( auto it = bulk.begin(); it != bulk.end(); ++it )
+  {
+    bulk_ids.push_back( it->second );
+  }
+  BOOST_REQUIRE_EQUAL_COLLECTIONS( inserted_ids.begin(), inserted_ids.end(), bulk_ids.begin(), bulk_ids.end() );
+
+  const BallMask< D > mask( Position< D >( std::vector< double >( D, 0.0 ) ), 0.2 );
+  const Position< D > anchor( std::vector< double >( D, 0.4 ) );
+  inserted_ids.clear();
+  for ( auto it = inserted.masked_begin( mask, anchor ); it != inserted.masked_end(); ++it )
+  {
+    inserted_ids.push_back( it->second );
+  }
+  bulk_ids.clear();
+  for ( auto it = bulk.masked_begin( mask, anchor ); it != bulk.masked_end(); ++it )
+  {
+    bulk_ids.push_back( it->second );
+  }
+  BOOST_REQUIRE_EQUAL_COLLECTIONS( inserted_ids.begin(), inserted_ids.end(), bulk_ids.begin(), bulk_ids.end() );
+}
+
+/**
+ * Check that Ntree::insert_bulk() with counted nodes finds the nodes inside a mask in the same order as the Ntree of
+ * all nodes, if given the nodes of a region containing the mask.
+ *
+ * Each position is held by two nodes, as if one of them was on each of two MPI processes. The counts of both
+ * processes are thus summed by doubling the counts of the even nodes.
+ */
+template < int D >
+void
+check_insert_bulk_counted( const size_t num_positions )
+{
+  std::mt19937_64 rng( 24680 );
+  std::uniform_real_distribution< double > dist( -0.5, 0.5 );
+
+  std::vector< std::pair< Position< D >, size_t > > nodes;
+  std::vector< std::pair< Position< D >, size_t > > even_nodes;
+  for ( size_t i = 0; i < num_positions; ++i )
+  {
+    Position< D > pos;
+    for ( int j = 0; j < D; ++j )
+    {
+      pos[ j ] = i % 10 == 0 ? 0.25 : dist( rng );
+    }
+    nodes.push_back( std::make_pair( pos, 2 * i ) );
+    nodes.push_back( std::make_pair( pos, 2 * i + 1 ) );
+    even_nodes.push_back( nodes[ 2 * i ] );
+  }
+
+  const Position< D > lower_left( std::vector< double >( D, -0.5 ) );
+  const Position< D > extent( std::vector< double >( D, 1.0 ) );
+  Ntree< D, size_t > all( lower_left, extent, 0 );
+  all.insert_bulk( nodes );
+
+  // Anchors are in [ -0.1, 0.3 ]^D, the mask reaches 0.1 beyond them.
+  const BallMask< D > mask( Position< D >( std::vector< double >( D, 0.0 ) ), 0.1 );
+  std::vector< std::pair< Position< D >, size_t > > region_nodes;
+  for ( const auto& node : nodes )
+  {
+    bool inside = true;
+    for ( int j = 0; j < D; ++j )
+    {
+      inside &= -0.2 <= node.first[ j ] and node.first[ j ] <= 0.4;
+    }
+    if ( inside )
+    {
+      region_nodes.push_back( node );
+    }
+  }
+  Ntree< D, size_t > region( lower_left, extent, 0 );
+  region.insert_bulk( region_nodes,
+    even_nodes,
+    []( std::vector< double >& counts )
+    {
+      for ( auto& count : counts )
+      {
+        count *= 2;
+      }
+    } );
+
+  std::uniform_real_distribution< double > anchor_dist( -0.1, 0.3 );
+  for ( int k = 0; k < 200; ++k )
+  {
+    Position< D > anchor;
+    for ( int j = 0; j < D; ++j )
+    {
+      anchor[ j ] = k == 0 ? 0.25 : anchor_dist( rng );
+    }
+
+    std::vector< size_t > all_ids;
+    for ( auto it = all.masked_begin( mask, anchor ); it != all.masked_end(); ++it )
+    {
+      all_ids.push_back( it->second );
+    }
+    std::vector< size_t > region_ids;
+    for ( auto it = region.masked_begin( mask, anchor ); it != region.masked_end(); ++it )
+    {
+      region_ids.push_back( it->second );
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS( all_ids.begin(), all_ids.end(), region_ids.begin(), region_ids.end() );
+  }
+}
+
+/**
+ * Create an Ntree with nodes at uniformly distributed positions.
+ */
+template < int D >
+void
+fill_uniform( Ntree< D, size_t >& tree, const size_t num_nodes )
+{
+  std::mt19937_64 rng( 54321 );
+  std::uniform_real_distribution< double > dist( -0.5, 0.5 );
+  std::vector< std::pair< Position< D >, size_t > > nodes;
+  for ( size_t i = 0; i < num_nodes; ++i )
+  {
+    Position< D > pos;
+    for ( int j = 0; j < D; ++j )
+    {
+      pos[ j ] = dist( rng );
+    }
+    nodes.push_back( std::make_pair( pos, i ) );
+  }
+  tree.insert_bulk( nodes );
+}
+
+/**
+ * Check that SpatialHash::get_nodes() finds the same nodes in the same order as the masked iterator of the Ntree.
+ */
+template < int D >
+void
+check_spatial_hash( const Mask< D >& mask, const std::bitset< D > periodic )
+{
+  const Position< D > lower_left( std::vector< double >( D, -0.5 ) );
+  const Position< D > extent( std::vector< double >( D, 1.0 ) );
+  Ntree< D, size_t > tree( lower_left, extent, periodic );
+  fill_uniform( tree, 20000 );
+
+  const Box< D > bbox = mask.get_bbox();
+  const SpatialHash< D, size_t > hash( tree, ( bbox.upper_right - bbox.lower_left ) * 0.125 );
+
+  std::mt19937_64 rng( 6789 );
+  std::uniform_real_distribution< double > dist( -0.6, 0.6 );
+  for ( int k = 0; k < 200; ++k )
+  {
+    Position< D > anchor;
+    for ( int j = 0; j < D; ++j )
+    {
+      anchor[ j ] = dist( rng );
+    }
+
+    std::vector< size_t > tree_ids;
+    for ( auto it = tree.masked_begin( mask, anchor ); it != tree.masked_end(); ++it )
+    {
+      tree_ids.push_back( it->second );
+    }
+    std::vector< std::pair< Position< D >, size_t > > nodes;
+    hash.get_nodes( mask, tree.get_anchors( mask, anchor ), nodes );
+    std::vector< size_t > hash_ids;
+    for ( const auto& node : nodes )
+    {
+      hash_ids.push_back( node.second );
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS( tree_ids.begin(), tree_ids.end(), hash_ids.begin(), hash_ids.end() );
+  }
+}
+
+/**
+ * Fill an Ntree covering [-0.5, 0.5] x [-0.5, 0.5] with the nodes of a dim x dim grid layer.
+ *
+ * @returns the nodes in the order of their indices.
+ */
+std::vector< std::pair< Position< 2 >, size_t > >
+fill_grid( Ntree< 2, size_t >& tree, const size_t dim )
+{
+  // Positions as computed by GridLayer
+  const Position< 2 > upper_left( -0.5, 0.5 );
+  const Position< 2 > ext( 1.0, -1.0 );
+  const Position< 2, size_t > dims( dim, dim );
+  std::vector< std::pair< Position< 2 >, size_t > > nodes;
+  for ( size_t i = 0; i < dim; ++i )
+  {
+    for ( size_t j = 0; j < dim; ++j )
+    {
+      const Position< 2, int > gridpos( i, j );
+      nodes.push_back( std::make_pair( upper_left + ext / dims * gridpos + ext / dims * 0.5, i * dim + j ) );
+    }
+  }
+  tree.insert_bulk( nodes );
+  return nodes;
+}
+
+/**
+ * Check that GridStencil::get_nodes() finds the same nodes in the same order as the masked iterator of an Ntree
+ * holding the nodes of a 40 x 40 grid layer, for a box with the given corners, anchor and orientation.
+ */
+void
+check_grid_stencil( const Position< 2 >& lower_left,
+  const Position< 2 >& upper_right,
+  const Position< 2 >& mask_anchor,
+  const bool converse,
+  const std::bitset< 2 > periodic )
+{
+  Ntree< 2, size_t > tree( Position< 2 >( -0.5, -0.5 ), Position< 2 >( 1.0, 1.0 ), periodic );
+  const std::vector< std::pair< Position< 2 >, size_t > > nodes = fill_grid( tree, 40 );
+
+  const BoxMask< 2 > box( lower_left, upper_right );
+  const AnchoredMask< 2 > anchored( box, mask_anchor );
+  std::unique_ptr< Mask< 2 > > mask;
+  if ( converse )
+  {
+    mask.reset( new ConverseMask< 2 >( anchored ) );
+  }
+  else
+  {
+    mask.reset( anchored.clone() );
+  }
+  const GridStencil< 2, size_t > stencil(
+    tree, Position< 2 >( 0.01, 0.01 ), lower_left, upper_right, mask_anchor, converse );
+
+  for ( size_t k = 0; k < nodes.size(); k += 7 )
+  {
+    const Position< 2 >& anchor = nodes[ k ].first;
+
+    std::vector< size_t > tree_ids;
+    for ( auto it = tree.masked_begin( *mask, anchor ); it != tree.masked_end(); ++it )
+    {
+      tree_ids.push_back( it->second );
+    }
+    std::vector< std::pair< Position< 2 >, size_t > > found;
+    stencil.get_nodes( tree.get_anchors( *mask, anchor ), found );
+    std::vector< size_t > stencil_ids;
+    for ( const auto& node : found )
+    {
+      stencil_ids.push_back( node.second );
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS( tree_ids.begin(), tree_ids.end(), stencil_ids.begin(), stencil_ids.end() );
+  }
+}
+
+} // namespace nest
+
+BOOST_AUTO_TEST_SUITE( test_ntree )
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_2d )
+{
+  nest::check_insert_bulk< 2 >( 20000, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_2d_periodic )
+{
+  nest::check_insert_bulk< 2 >( 20000, 3 );
+}
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_3d )
+{
+  nest::check_insert_bulk< 3 >( 20000, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_few_nodes )
+{
+  nest::check_insert_bulk< 2 >( 50, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_counted_2d )
+{
+  nest::check_insert_bulk_counted< 2 >( 10000 );
+}
+
+BOOST_AUTO_TEST_CASE( test_insert_bulk_counted_3d )
+{
+  nest::check_insert_bulk_counted< 3 >( 10000 );
+}
+
+BOOST_AUTO_TEST_CASE( test_spatial_hash_ball )
+{
+  nest::check_spatial_hash< 2 >( nest::BallMask< 2 >( nest::Position< 2 >( 0.0, 0.0 ), 0.1 ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_spatial_hash_ball_periodic )
+{
+  nest::check_spatial_hash< 2 >( nest::BallMask< 2 >( nest::Position< 2 >( 0.05, -0.1 ), 0.2 ), 3 );
+}
+
+BOOST_AUTO_TEST_CASE( test_spatial_hash_box_periodic )
+{
+  nest::check_spatial_hash< 2 >(
+    nest::BoxMask< 2 >( nest::Position< 2 >( -0.1, -0.3 ), nest::Position< 2 >( 0.2, 0.1 ), 0.0, 0.0 ), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( test_spatial_hash_ball_3d )
+{
+  nest::check_spatial_hash< 3 >( nest::BallMask< 3 >( nest::Position< 3 >( 0.0, 0.0, 0.0 ), 0.15 ), 7 );
+}
+
+BOOST_AUTO_TEST_CASE( test_grid_stencil )
+{
+  // Edges half way between grid positions, as for grid masks
+  nest::check_grid_stencil(
+    nest::Position< 2 >( -0.0625, -0.0875 ), nest::Position< 2 >( 0.0625, 0.0375 ), nest::Position< 2 >(), false, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_grid_stencil_edges_on_grid )
+{
+  nest::check_grid_stencil(
+    nest::Position< 2 >( -0.1, -0.05 ), nest::Position< 2 >( 0.2, 0.15 ), nest::Position< 2 >(), false, 3 );
+}
+
+BOOST_AUTO_TEST_CASE( test_grid_stencil_anchored_converse )
+{
+  nest::check_grid_stencil(
+    nest::Position< 2 >( 0.0, 0.0 ), nest::Position< 2 >( 0.6, 0.3 ), nest::Position< 2 >( 0.1, -0.2 ), true, 1 );
+}
+
+/**
+ * Compares the time needed to find the nodes inside a circular mask with
+ * the Ntree and with the spatial hash.
+ */
+BOOST_AUTO_TEST_CASE( benchmark_spatial_hash )
+{
+  const size_t num_nodes = 40000;
+  const int num_queries = 10000;
+  const nest::Position< 2 > lower_left( -0.5, -0.5 );
+  const nest::Position< 2 > extent( 1.0, 1.0 );
+  nest::Ntree< 2, size_t > tree( lower_left, extent, 3 );
+  nest::fill_uniform( tree, num_nodes );
+
+  const nest::BallMask< 2 > mask( nest::Position< 2 >( 0.0, 0.0 ), 0.1 );
+  const nest::SpatialHash< 2, size_t > hash( tree, nest::Position< 2 >( 0.025, 0.025 ) );
+
+  std::mt19937_64 rng( 13579 );
+  std::uniform_real_distribution< double > dist( -0.5, 0.5 );
+  std::vector< nest::Position< 2 > > anchors;
+  for ( int k = 0; k < num_queries; ++k )
+  {
+    anchors.push_back( nest::Position< 2 >( dist( rng ), dist( rng ) ) );
+  }
+
+  std::vector< std::pair< nest::Position< 2 >, size_t > > nodes;
+  size_t num_found_tree = 0;
+  const auto t_start = std::chrono::steady_clock::now();
+  for ( const auto& anchor : anchors )
+  {
+    nodes.clear();
+    std::copy( tree.masked_begin( mask, anchor ), tree.masked_end(), std::back_inserter( nodes ) );
+    num_found_tree += nodes.size();
+  }
+  const auto t_tree = std::chrono::steady_clock::now();
+  size_t num_found_hash = 0;
+  for ( const auto& anchor : anchors )
+  {
+    nodes.clear();
+    hash.get_nodes( mask, tree.get_anchors( mask, anchor ), nodes );
+    num_found_hash += nodes.size();
+  }
+  const auto t_hash = std::chrono::steady_clock::now();
+
+  typedef std::chrono::duration< double, std::milli > milliseconds;
+  const double ms_tree = milliseconds( t_tree - t_start ).count();
+  const double ms_hash = milliseconds( t_hash - t_tree ).count();
+  BOOST_TEST_MESSAGE( "Querying " << num_nodes << " nodes " << num_queries << " times: Ntree " << ms_tree
+                                  << " ms, spatial hash " << ms_hash << " ms" );
+
+  BOOST_REQUIRE_EQUAL( num_found_tree, num_found_hash );
+}
+
+/**
+ * Compares the time needed to find the nodes of a 200 x 200 grid layer inside
+ * a box of 21 x 21 grid positions with the Ntree, the spatial hash and the
+ * grid stencil.
+ */
+BOOST_AUTO_TEST_CASE( benchmark_grid_stencil )
+{
+  nest::Ntree< 2, size_t > tree( nest::Position< 2 >( -0.5, -0.5 ), nest::Position< 2 >( 1.0, 1.0 ), 3 );
+  const std::vector< std::pair< nest::Position< 2 >, size_t > > grid_nodes = nest::fill_grid( tree, 200 );
+
+  const nest::Position< 2 > lower_left( -0.0525, -0.0525 );
+  const nest::Position< 2 > upper_right( 0.0525, 0.0525 );
+  const nest::BoxMask< 2 > mask( lower_left, upper_right );
+  const nest::Position< 2 > cell_size( 0.0125, 0.0125 );
+  const nest::SpatialHash< 2, size_t > hash( tree, cell_size );
+  const nest::GridStencil< 2, size_t > stencil(
+    tree, cell_size, lower_left, upper_right, nest::Position< 2 >(), false );
+
+  std::vector< std::pair< nest::Position< 2 >, size_t > > nodes;
+  size_t num_found_tree = 0;
+  const auto t_start = std::chrono::steady_clock::now();
+  for ( const auto& node : grid_nodes )
+  {
+    nodes.clear();
+    std::copy( tree.masked_begin( mask, node.first ), tree.masked_end(), std::back_inserter( nodes ) );
+    num_found_tree += nodes.size();
+  }
+  const auto t_tree = std::chrono::steady_clock::now();
+  size_t num_found_hash = 0;
+  for ( const auto& node : grid_nodes )
+  {
+    nodes.clear();
+    hash.get_nodes( mask, tree.get_anchors( mask, node.first ), nodes );
+    num_found_hash += nodes.size();
+  }
+  const auto t_hash = std::chrono::steady_clock::now();
+  size_t num_found_stencil = 0;
+  for ( const auto& node : grid_nodes )
+  {
+    nodes.clear();
+    stencil.get_nodes( tree.get_anchors( mask, node.first ), nodes );
+    num_found_stencil += nodes.size();
+  }
+  const auto t_stencil = std::chrono::steady_clock::now();
+
+  typedef std::chrono::duration< double, std::milli > milliseconds;
+  const double ms_tree = milliseconds( t_tree - t_start ).count();
+  const double ms_hash = milliseconds( t_hash - t_tree ).count();
+  const double ms_stencil = milliseconds( t_stencil - t_hash ).count();
+  BOOST_TEST_MESSAGE( "Querying 200 x 200 grid at each node: Ntree " << ms_tree << " ms, spatial hash " << ms_hash
+                                                                     << " ms, grid stencil " << ms_stencil << " ms" );
+
+  BOOST_REQUIRE_EQUAL( num_found_tree, num_found_hash );
+  BOOST_REQUIRE_EQUAL( num_found_tree, num_found_stencil );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* TEST_NTREE_H */
@@ -32,7 +32,10 @@
 #include <boost/test/unit_test.hpp>
 
 // Includes from nestkernel
+#include "free_layer.h"
+#include "layer_impl.h"
 #include "nest_datums.h"
+#include "parameter_program.h"
 #include "random_generators.h"
 
 BOOST_AUTO_TEST_SUITE( test_parameter )
@@ -88,6 +91,95 @@ BOOST_AUTO_TEST_CASE( test_uniform_int_returns_integer )
   }
 }
 
+/**
+ * Tests that a compiled spatial parameter gives exactly the values of the parameter tree.
+ */
+BOOST_AUTO_TEST_CASE( test_compiled_parameter_matches_value )
+{
+  // Without a kernel, the layer cannot have a node collection, which its destructor requires.
+  // The layer is therefore not destroyed.
+  auto& layer = *new nest::FreeLayer< 2 >();
+  DictionaryDatum layer_dict = new Dictionary();
+  ( *layer_dict )[ nest::names::edge_wrap ] = true;
+  // FreeLayer::set_status() requires nodes, only set the periodic boundary conditions.
+  layer.nest::Layer< 2 >::set_status( layer_dict );
+
+  DictionaryDatum dist_dict = new Dictionary();
+  ParameterDatum distance = new nest::SpatialDistanceParameter( dist_dict );
+  ( *dist_dict )[ nest::names::dimension ] = 1;
+  ParameterDatum dx = new nest::SpatialDistanceParameter( dist_dict );
+  DictionaryDatum pos_dict = new Dictionary();
+  ( *pos_dict )[ nest::names::dimension ] = 1;
+  ( *pos_dict )[ nest::names::synaptic_endpoint ] = 1;
+  ParameterDatum source_y = new nest::NodePosParameter( pos_dict );
+
+  DictionaryDatum exp_dict = new Dictionary();
+  ( *exp_dict )[ "x" ] = distance;
+  ( *exp_dict )[ "beta" ] = 0.3;
+  ParameterDatum exp_dist = new nest::ExpDistParameter( exp_dict );
+
+  DictionaryDatum gauss_dict = new Dictionary();
+  ( *gauss_dict )[ "x" ] = dx;
+  ( *gauss_dict )[ "y" ] = source_y;
+  ( *gauss_dict )[ "mean_x" ] = 0.1;
+  ( *gauss_dict )[ "mean_y" ] = -0.2;
+  ( *gauss_dict )[ "std_x" ] = 0.25;
+  ( *gauss_dict )[ "std_y" ] = 0.4;
+  ( *gauss_dict )[ "rho" ] = 0.3;
+  ParameterDatum gauss_2d = new nest::Gaussian2DParameter( gauss_dict );
+
+  DictionaryDatum cmp_dict = new Dictionary();
+  ( *cmp_dict )[ nest::names::comparator ] = 2; // <=
+  ParameterDatum radius = new nest::ConstantParameter( 0.35 );
+  ParameterDatum condition = new nest::ComparingParameter( distance, radius, cmp_dict );
+  ParameterDatum kernel_param = new nest::ConditionalParameter( condition,
+    nest::min_parameter( nest::add_parameter( exp_dist, gauss_2d ), 1.0 ),
+    nest::pow_parameter( nest::cos_parameter( distance ), 3.0 ) );
+
+  nest::ParameterProgram program;
+  BOOST_REQUIRE( kernel_param->compile( program ) );
+  BOOST_REQUIRE_EQUAL( program.get_num_dimensions(), 2 );
+
+  nest::RandomGeneratorFactory< std::mt19937_64 > rf;
+  nest::RngPtr rng = rf.create( { 1234567890, 23423423 } );
+
+  const size_t num_candidates = 1000;
+  const std::vector< double > target_pos = { 0.1, -0.3 };
+  nest::ParameterBatch batch( 2 );
+  batch.target_pos = target_pos;
+  std::vector< std::vector< double > > source_positions;
+  for ( size_t i = 0; i < num_candidates; ++i )
+  {
+    const std::vector< double > source_pos = { rng->drand() - 0.5, rng->drand() - 0.5 };
+    const std::vector< double > displacement = { layer.compute_displacement( source_pos, target_pos, 0 ),
+      layer.compute_displacement( source_pos, target_pos, 1 ) };
+    batch.add( source_pos, displacement );
+    source_positions.push_back( source_pos );
+  }
+
+  std::vector< double > values;
+  program.evaluate( batch, values );
+  BOOST_REQUIRE_EQUAL( values.size(), num_candidates );
+  for ( size_t i = 0; i < num_candidates; ++i )
+  {
+    BOOST_REQUIRE_EQUAL( values[ i ], kernel_param->value( rng, source_positions[ i ], target_pos, layer, nullptr ) );
+  }
+}
+
+/**
+ * Tests that parameters drawing random numbers are not compiled.
+ */
+BOOST_AUTO_TEST_CASE( test_random_parameter_not_compiled )
+{
+  DictionaryDatum d = new Dictionary();
+  ParameterDatum distance = new nest::SpatialDistanceParameter( d );
+  ParameterDatum uniform = new nest::UniformParameter( d );
+  ParameterDatum kernel_param = nest::multiply_parameter( distance, uniform );
+
+  nest::ParameterProgram program;
+  BOOST_CHECK( not kernel_param->compile( program ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* TEST_PARAMETER_H */
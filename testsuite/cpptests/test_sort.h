@@ -28,8 +28,12 @@
 
 // C++ includes:
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
+// C includes:
+#include <sys/resource.h>
+
 // Includes from libnestutil:
 #include "sort.h"
 
@@ -232,6 +236,191 @@ BOOST_FIXTURE_TEST_CASE( test_boost_linear, fill_bv_vec_linear )
   BOOST_REQUIRE( std::equal( vec_sort_small.begin(), vec_sort_small.end(), bv_perm_small.begin() ) );
 }
 
+/**
+ * Tests whether entries appended to a sorted array are sorted correctly
+ * when merging them into the sorted part.
+ */
+BOOST_FIXTURE_TEST_CASE( test_sort_tail_and_merge_random, fill_bv_vec_random )
+{
+  // All but the last entries are sorted, as if these had been appended.
+  const int num_appended = 100;
+  std::sort( bv_sort.begin(), bv_sort.end() - num_appended );
+  std::sort( bv_perm.begin(), bv_perm.end() - num_appended );
+
+  nest::sort_tail_and_merge( bv_sort, bv_perm );
+
+  BOOST_REQUIRE( std::is_sorted( bv_sort.begin(), bv_sort.end() ) );
+  BOOST_REQUIRE( std::is_sorted( bv_perm.begin(), bv_perm.end() ) );
+
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_sort.begin() ) );
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_perm.begin() ) );
+}
+
+/**
+ * Tests whether merging appended entries keeps the order of equal entries.
+ */
+BOOST_AUTO_TEST_CASE( test_sort_tail_and_merge_stable )
+{
+  BlockVector< int > bv_sort;
+  BlockVector< int > bv_perm;
+  for ( const int key : { 1, 2, 2, 3, 2, 1, 3 } )
+  {
+    bv_perm.push_back( bv_sort.size() );
+    bv_sort.push_back( key );
+  }
+
+  nest::sort_tail_and_merge( bv_sort, bv_perm );
+
+  const std::vector< int > expected_sort = { 1, 1, 2, 2, 2, 3, 3 };
+  const std::vector< int > expected_perm = { 0, 5, 1, 2, 4, 3, 6 };
+  BOOST_REQUIRE( std::equal( expected_sort.begin(), expected_sort.end(), bv_sort.begin() ) );
+  BOOST_REQUIRE( std::equal( expected_perm.begin(), expected_perm.end(), bv_perm.begin() ) );
+}
+
+/**
+ * Tests whether the length of the sorted prefix is determined correctly.
+ */
+BOOST_AUTO_TEST_CASE( test_sorted_prefix_size )
+{
+  BlockVector< int > bv;
+  BOOST_REQUIRE( nest::sorted_prefix_size( bv ) == 0 );
+
+  for ( const int key : { 1, 2, 2, 3 } )
+  {
+    bv.push_back( key );
+  }
+  BOOST_REQUIRE( nest::sorted_prefix_size( bv ) == 4 );
+
+  bv.push_back( 0 );
+  bv.push_back( 5 );
+  BOOST_REQUIRE( nest::sorted_prefix_size( bv ) == 4 );
+}
+
+/**
+ * Tests whether two arrays with randomly generated numbers are sorted
+ * correctly when sorting with the radix sort.
+ */
+BOOST_FIXTURE_TEST_CASE( test_radix_sort_random, fill_bv_vec_random )
+{
+  nest::radix_sort( bv_sort, bv_perm );
+
+  BOOST_REQUIRE( std::is_sorted( bv_sort.begin(), bv_sort.end() ) );
+  BOOST_REQUIRE( std::is_sorted( bv_perm.begin(), bv_perm.end() ) );
+
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_sort.begin() ) );
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_perm.begin() ) );
+
+  // Using smaller data sets to sort with the fallback algorithm.
+  nest::radix_sort( bv_sort_small, bv_perm_small );
+
+  BOOST_REQUIRE( std::equal( vec_sort_small.begin(), vec_sort_small.end(), bv_sort_small.begin() ) );
+  BOOST_REQUIRE( std::equal( vec_sort_small.begin(), vec_sort_small.end(), bv_perm_small.begin() ) );
+}
+
+/**
+ * Tests whether two arrays with linearly decreasing numbers are sorted
+ * correctly when sorting with the radix sort.
+ */
+BOOST_FIXTURE_TEST_CASE( test_radix_sort_linear, fill_bv_vec_linear )
+{
+  nest::radix_sort( bv_sort, bv_perm );
+
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_sort.begin() ) );
+  BOOST_REQUIRE( std::equal( vec_sort.begin(), vec_sort.end(), bv_perm.begin() ) );
+}
+
+/**
+ * Tests whether the radix sort keeps the order of equal entries and sorts
+ * by the given key.
+ */
+BOOST_AUTO_TEST_CASE( test_radix_sort_stable_key )
+{
+  BlockVector< int > bv_sort;
+  BlockVector< int > bv_perm;
+  for ( int i = 0; i < 1000; ++i )
+  {
+    bv_perm.push_back( i );
+    bv_sort.push_back( ( i * 7919 ) % 13 + ( i % 2 ) * 1000000 );
+  }
+
+  // Sort only by the lower digits, so that the high bit does not contribute.
+  nest::radix_sort( bv_sort, bv_perm, []( const int k ) { return static_cast< uint64_t >( k % 1000000 ); } );
+
+  for ( size_t i = 1; i < bv_sort.size(); ++i )
+  {
+    BOOST_REQUIRE( bv_sort[ i - 1 ] % 1000000 <= bv_sort[ i ] % 1000000 );
+    if ( bv_sort[ i - 1 ] % 1000000 == bv_sort[ i ] % 1000000 )
+    {
+      BOOST_REQUIRE( bv_perm[ i - 1 ] < bv_perm[ i ] );
+    }
+  }
+}
+
+/**
+ * Returns the peak resident set size of the process in kB.
+ */
+long
+peak_rss_kb()
+{
+  rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; // reported in bytes
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * Compares the time needed to sort random sources with connection-sized
+ * entries with the quicksort and the radix sort, and measures by how much
+ * the radix sort increases the peak memory of the process.
+ */
+BOOST_AUTO_TEST_CASE( benchmark_radix_sort )
+{
+  struct Payload
+  {
+    int value;
+    double data[ 7 ];
+  };
+
+  const int N = 200000;
+  BlockVector< int > bv_sort_quick;
+  BlockVector< Payload > bv_perm_quick;
+  for ( int i = 0; i < N; ++i )
+  {
+    const int k = std::rand() % N;
+    bv_sort_quick.push_back( k );
+    bv_perm_quick.push_back( Payload { k, {} } );
+  }
+  BlockVector< int > bv_sort_radix( bv_sort_quick );
+  BlockVector< Payload > bv_perm_radix( bv_perm_quick );
+
+  const auto t_start = std::chrono::steady_clock::now();
+  nest::quicksort3way( bv_sort_quick, bv_perm_quick, 0, bv_sort_quick.size() - 1 );
+  const auto t_quick = std::chrono::steady_clock::now();
+  const long rss_before = peak_rss_kb();
+  nest::radix_sort( bv_sort_radix, bv_perm_radix );
+  const auto t_radix = std::chrono::steady_clock::now();
+  const long rss_increase = peak_rss_kb() - rss_before;
+
+  typedef std::chrono::duration< double, std::milli > milliseconds;
+  const double ms_quick = milliseconds( t_quick - t_start ).count();
+  const double ms_radix = milliseconds( t_radix - t_quick ).count();
+  BOOST_TEST_MESSAGE( "Sorting " << N << " entries: quicksort " << ms_quick << " ms, radix sort " << ms_radix << " ms" );
+  BOOST_TEST_MESSAGE( "Peak memory increase of radix sort: " << rss_increase << " kB, "
+                                                             << 1024.0 * rss_increase / N << " B per entry" );
+
+  // The radix sort must not copy the entries.
+  BOOST_REQUIRE( rss_increase * 1024 < static_cast< long >( N * sizeof( Payload ) ) );
+
+  BOOST_REQUIRE( std::equal( bv_sort_quick.begin(), bv_sort_quick.end(), bv_sort_radix.begin() ) );
+  for ( int i = 0; i < N; ++i )
+  {
+    BOOST_REQUIRE( bv_perm_radix[ i ].value == bv_sort_radix[ i ] );
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* TEST_SORT_H */
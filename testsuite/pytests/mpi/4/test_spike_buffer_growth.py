@@ -0,0 +1 @@
+../../test_spike_buffer_growth.py
\ No newline at end of file
@@ -0,0 +1 @@
+../../test_spike_exchange_mode.py
\ No newline at end of file
@@ -0,0 +1,64 @@
+# -*- coding: utf-8 -*-
+#
+# test_local_source_positions.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+from mpi_test_wrapper import MPITestAssertEqual
+
+
+@pytest.mark.parametrize("use_on_source", [False, True])
+@MPITestAssertEqual([1, 2, 4], debug=False)
+def test_local_source_positions(use_on_source):
+    """
+    Confirm that spatial connections are invariant under number of MPI ranks if ranks gather only nearby sources.
+
+    On every rank, the connections must also be identical to those created with all source positions.
+    """
+
+    import nest
+    import numpy as np
+
+    def connect(use_local_source_positions):
+        nest.ResetKernel()
+        nest.set(total_num_virtual_procs=4, rng_seed=12)
+
+        rng = np.random.default_rng(123)
+        positions = nest.spatial.free(rng.uniform(-0.5, 0.5, (2000, 2)).tolist(), extent=[1.0, 1.0], edge_wrap=True)
+        sources = nest.Create("parrot_neuron", positions=positions)
+        targets = nest.Create("parrot_neuron", positions=positions)
+        nest.Connect(
+            sources,
+            targets,
+            {
+                "rule": "pairwise_bernoulli",
+                "p": 0.5,
+                "use_on_source": use_on_source,
+                "mask": {"circular": {"radius": 0.1}},
+                "use_local_source_positions": use_local_source_positions,
+            },
+        )
+
+        return nest.GetConnections().get(output="pandas").drop(labels=["target_thread", "port"], axis=1)
+
+    conns_all = connect(False)
+    conns = connect(True)
+    assert conns.equals(conns_all)
+
+    conns.to_csv(OTHER_LABEL.format(nest.num_processes) + f"-{nest.Rank()}.dat", index=False)  # noqa: F821
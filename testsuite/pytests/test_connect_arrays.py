@@ -340,6 +340,39 @@ class TestConnectArrays(unittest.TestCase):
         with self.assertRaises(nest.kernel.NESTErrors.UnknownNode):
             nest.Connect(sources, targets, syn_spec={"weight": weights, "delay": delays, "synapse_model": syn_model})
 
+    def test_connect_arrays_unknown_nodes_no_connections(self):
+        """No connections are created if some of the nodes are unknown"""
+        n = 10
+        nest.Create("iaf_psc_alpha", n)
+        sources = np.arange(1, n + 1, dtype=np.uint64)
+        targets = np.arange(1, n + 1, dtype=np.uint64)
+        targets[-1] = n + 1
+
+        with self.assertRaises(nest.kernel.NESTErrors.UnknownNode):
+            nest.Connect(sources, targets, conn_spec="one_to_one", syn_spec={"weight": np.ones(n)})
+
+        self.assertEqual(nest.num_connections, 0)
+
+    @unittest.skipIf(not HAVE_OPENMP, "NEST was compiled without multi-threading")
+    def test_connect_arrays_threaded_with_devices(self):
+        """Connecting NumPy arrays from and to devices, threaded"""
+        nest.local_num_threads = 4
+        neurons = nest.Create("iaf_psc_alpha", 10)
+        pg = nest.Create("poisson_generator")
+        sr = nest.Create("spike_recorder")
+
+        sources = np.array(neurons.tolist() + [pg.global_id] * 5 + [3, 7, 2])
+        targets = np.array([sr.global_id] * 10 + [2, 4, 6, 8, 10] + [9, 1, 5])
+        weights = np.arange(len(sources), dtype=float) + 1.0
+
+        nest.Connect(sources, targets, conn_spec="one_to_one", syn_spec={"weight": weights})
+
+        conns = nest.GetConnections()
+        self.assertEqual(
+            sorted(zip(conns.source, conns.target, conns.weight)),
+            sorted(zip(sources.tolist(), targets.tolist(), weights.tolist())),
+        )
+
     @unittest.skipIf(not HAVE_OPENMP, "NEST was compiled without multi-threading")
     def test_connect_arrays_receptor_type(self):
         """Connecting NumPy arrays with receptor type specified, threaded"""
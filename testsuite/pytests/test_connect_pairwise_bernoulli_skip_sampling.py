@@ -0,0 +1,143 @@
+# -*- coding: utf-8 -*-
+#
+# test_connect_pairwise_bernoulli_skip_sampling.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test the pairwise_bernoulli rule with skip sampling of sources.
+"""
+
+import nest
+import numpy as np
+import pytest
+import scipy.stats
+
+N_S = 200
+N_T = 100
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def connect(p, use_skip_sampling=True, num_threads=1, **conn_spec):
+    """
+    Connect two populations and return the indegrees of the targets.
+    """
+
+    nest.local_num_threads = num_threads
+    sources = nest.Create("parrot_neuron", N_S)
+    targets = nest.Create("parrot_neuron", N_T)
+    nest.Connect(
+        sources,
+        targets,
+        dict(conn_spec, rule="pairwise_bernoulli", p=p, use_skip_sampling=use_skip_sampling),
+    )
+
+    conns = nest.GetConnections(sources, targets)
+    return np.bincount(np.array(conns.target, dtype=int) - targets[0].global_id, minlength=N_T)
+
+
+@pytest.mark.parametrize("p", [0.02, 0.3])
+def test_indegrees_binomial(p):
+    """
+    Expectation: The total number of connections and the variance of indegrees match the binomial distribution.
+    """
+
+    degrees = connect(p, num_threads=2 if nest.ll_api.sli_func("is_threaded") else 1)
+
+    assert scipy.stats.binomtest(int(degrees.sum()), N_S * N_T, p).pvalue > 0.001
+    assert degrees.var() == pytest.approx(N_S * p * (1 - p), rel=0.5)
+
+
+@pytest.mark.parametrize("p, expected", [(0.0, 0), (1.0, N_S)])
+def test_extreme_probabilities(p, expected):
+    """
+    Expectation: No source is connected for p = 0 and every source for p = 1.
+    """
+
+    degrees = connect(p)
+
+    assert np.all(degrees == expected)
+
+
+def test_no_autapses():
+    """
+    Expectation: Autapses are excluded if not allowed.
+    """
+
+    nodes = nest.Create("parrot_neuron", 10)
+    nest.Connect(
+        nodes, nodes, {"rule": "pairwise_bernoulli", "p": 1.0, "use_skip_sampling": True, "allow_autapses": False}
+    )
+    conns = nest.GetConnections(nodes, nodes)
+
+    assert len(conns) == 90
+    assert all(s != t for s, t in zip(conns.source, conns.target))
+
+
+def test_parameter_probability():
+    """
+    Expectation: Probabilities given as parameter are thinned relative to p_max.
+    """
+
+    degrees = connect(nest.random.uniform(0.0, 0.2), p_max=0.2)
+    num_conns = degrees.sum()
+    expected = 0.1 * N_S * N_T
+
+    assert abs(num_conns - expected) < 5 * np.sqrt(expected)
+
+
+def test_parameter_probability_requires_p_max():
+    """
+    Expectation: Skip sampling with a parameter as probability fails without p_max.
+    """
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        connect(nest.random.uniform(0.0, 0.2))
+
+
+@pytest.mark.parametrize(
+    "make_p",
+    [
+        lambda: nest.random.uniform(0.1, 0.2),
+        lambda: nest.random.normal(0.01, 0.001),
+        lambda: nest.math.min(nest.random.normal(0.01, 0.001), 0.1),
+    ],
+)
+def test_parameter_probability_exceeds_p_max(make_p):
+    """
+    Expectation: A probability that may exceed p_max raises an error before any connection is created.
+    """
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        connect(make_p(), p_max=0.05)
+
+    assert nest.num_connections == 0
+
+
+def test_parameter_probability_bounded_by_min():
+    """
+    Expectation: A probability limited to p_max is accepted.
+    """
+
+    degrees = connect(nest.math.min(nest.random.normal(0.01, 0.001), 0.05), p_max=0.05)
+
+    assert degrees.sum() > 0
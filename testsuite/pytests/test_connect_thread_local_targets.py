@@ -0,0 +1,138 @@
+# -*- coding: utf-8 -*-
+#
+# test_connect_thread_local_targets.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that connection rules visiting only the targets local to each thread create all connections.
+
+Targets are given as sliced and composite NodeCollections, in which local nodes are not equidistant.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2, 3, 4]
+else:
+    THREAD_NUMBERS = [1]
+
+
+def create_network(sliced):
+    """
+    Create sources and targets, with targets given as a composite of several parts or as a sliced composite.
+    """
+
+    sources = nest.Create("parrot_neuron", 6)
+    a = nest.Create("iaf_psc_alpha", 11)
+    nest.Create("parrot_neuron", 2)
+    b = nest.Create("iaf_psc_exp", 7)
+    targets = (a + b)[1::3] if sliced else a[1:4] + b + a[7:10]
+
+    return sources, targets
+
+
+@pytest.fixture(params=[(num_threads, sliced) for num_threads in THREAD_NUMBERS for sliced in [False, True]])
+def network(request):
+    num_threads, sliced = request.param
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    return create_network(sliced)
+
+
+def test_local_begin_visits_all_nodes(network):
+    """
+    Expectation: Connecting one source to all targets reaches every target exactly once.
+    """
+
+    sources, targets = network
+    nest.Connect(sources[0], targets)
+
+    conns = nest.GetConnections(sources[0])
+    assert sorted(conns.target) == sorted(targets.tolist())
+
+
+@pytest.mark.parametrize(
+    "conn_spec",
+    [
+        {"rule": "all_to_all"},
+        {"rule": "fixed_indegree", "indegree": 3},
+        {"rule": "pairwise_bernoulli", "p": 1.0},
+        {"rule": "pairwise_poisson", "pairwise_avg_num_conns": 1.0},
+    ],
+)
+def test_all_targets_connected(network, conn_spec):
+    """
+    Expectation: Every target receives connections, irrespective of the thread it is on.
+    """
+
+    sources, targets = network
+    nest.Connect(sources, targets, conn_spec)
+
+    conns = nest.GetConnections(sources)
+    assert set(conns.target) == set(targets.tolist())
+    if conn_spec["rule"] in ["all_to_all", "pairwise_bernoulli"]:
+        assert len(conns) == len(sources) * len(targets)
+    elif conn_spec["rule"] == "fixed_indegree":
+        assert len(conns) == 3 * len(targets)
+
+
+def test_one_to_one_sources(network):
+    """
+    Expectation: Each target is connected to the source at the same position.
+    """
+
+    sources, targets = network
+    sources = nest.Create("parrot_neuron", len(targets))
+    nest.Connect(sources, targets, "one_to_one")
+
+    conns = nest.GetConnections(sources)
+    pairs = sorted(zip(conns.source, conns.target))
+    assert pairs == sorted(zip(sources.tolist(), targets.tolist()))
+
+
+def test_one_to_one_slices_of_composite(network):
+    """
+    Expectation: Single nodes sliced from later parts of a composite are connected to each other.
+    """
+
+    sources, targets = network
+    nest.Connect(targets[-2], targets[-1], "one_to_one")
+
+    conns = nest.GetConnections(targets[-2])
+    assert len(conns) == 1
+    assert (conns.source, conns.target) == (targets[-2].global_id, targets[-1].global_id)
+
+
+def test_all_to_all_array_weights(network):
+    """
+    Expectation: Array parameters are assigned to the correct pairs when targets on other threads are skipped.
+    """
+
+    sources, targets = network
+    weights = np.arange(len(targets) * len(sources), dtype=float).reshape(len(targets), len(sources))
+    nest.Connect(sources, targets, "all_to_all", {"weight": weights})
+
+    target_pos = {t: i for i, t in enumerate(targets.tolist())}
+    source_pos = {s: i for i, s in enumerate(sources.tolist())}
+    conns = nest.GetConnections(sources)
+    assert len(conns) == weights.size
+    for s, t, w in zip(conns.source, conns.target, conns.weight):
+        assert w == weights[target_pos[t], source_pos[s]]
@@ -140,3 +140,79 @@ def test_get_connections_correct_table_with_node_collection_index():
     )
 
     pdtest.assert_frame_equal(actual_conns, expected_conns)
+
+
+def test_get_connections_with_targets_matches_filtered_connections():
+    """
+    Test that ``GetConnections`` with targets returns the connections to those targets in the same order.
+    """
+
+    nest.rng_seed = 12
+    nodes = nest.Create("iaf_psc_alpha", 20)
+    nest.Connect(nodes, nodes, {"rule": "pairwise_bernoulli", "p": 0.3})
+    targets = nodes[13] + nodes[2] + nodes[7:10]
+
+    all_conns = nest.GetConnections().get(["source", "target", "port"])
+    expected = [
+        (s, t, p)
+        for s, t, p in zip(all_conns["source"], all_conns["target"], all_conns["port"])
+        if t in targets.tolist()
+    ]
+
+    actual_conns = nest.GetConnections(target=targets).get(["source", "target", "port"])
+    actual = list(zip(actual_conns["source"], actual_conns["target"], actual_conns["port"]))
+
+    assert len(expected) > 0
+    assert actual == expected
+
+
+def test_get_connections_creates_connection_datums_on_demand():
+    """
+    Test that connection datums are only created when a parameter is read through SLI.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 3)
+    nest.Connect(nodes, nodes, syn_spec={"weight": 2.5})
+
+    conns = nest.GetConnections()
+    assert conns.get("target") == [1, 2, 3, 1, 2, 3, 1, 2, 3]
+    assert conns.get("weight") == [2.5] * 9
+    assert conns._datums is None
+
+    assert conns.get("synapse_model") == ["static_synapse"] * 9
+    assert len(conns._datums) == 9
+
+
+def test_get_connections_indexing_matches_connection_datums():
+    """
+    Test that indexing and slicing a ``SynapseCollection`` gives the same connections with and without datums.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 4)
+    nest.Connect(nodes, nodes)
+
+    conns = nest.GetConnections()
+    conns_from_datums = nest.SynapseCollection(conns._datum)
+
+    assert conns[-1] == conns_from_datums[-1]
+    assert conns[3:11:2] == conns_from_datums[3:11:2]
+    assert conns[5].get() == conns_from_datums[5].get()
+    with pytest.raises(IndexError):
+        conns[16]
+
+
+@pytest.mark.skipif_missing_threads
+def test_get_connections_ordered_by_synapse_model_and_thread():
+    """
+    Test that ``GetConnections`` returns connections ordered by synapse model and then by thread.
+    """
+
+    nest.local_num_threads = 2
+    nodes = nest.Create("iaf_psc_alpha", 6)
+    nest.Connect(nodes, nodes, syn_spec={"synapse_model": "stdp_synapse"})
+    nest.Connect(nodes, nodes)
+
+    conns = nest.GetConnections().get(["synapse_model", "target_thread"])
+
+    assert conns["synapse_model"] == ["static_synapse"] * 36 + ["stdp_synapse"] * 36
+    assert conns["target_thread"] == 2 * ([0] * 18 + [1] * 18)
@@ -0,0 +1,145 @@
+# -*- coding: utf-8 -*-
+#
+# test_incremental_connection_update.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that connections created between simulations are included in the connection infrastructure.
+
+Without removed connections, the connection infrastructure is updated incrementally. Setting
+``use_compressed_spikes`` forces a complete update, which serves as reference.
+"""
+
+import nest
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2]
+else:
+    THREAD_NUMBERS = [1]
+
+
+def simulate_with_added_connections(num_threads, use_compressed_spikes, full_update):
+    """
+    Simulate a network to which connections are added between simulations.
+
+    Parrot neurons relay input spikes to neurons, which only project to a spike recorder. Input spikes are
+    chosen such that no spike is in transit between simulations, and weights are integers so that summation
+    of input does not depend on the order of connections.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.use_compressed_spikes = use_compressed_spikes
+
+    spike_times = [[50.0 * k + 5.0 + 3.0 * i + 0.1 * j for k in range(4) for i in range(13)] for j in range(20)]
+    generators = nest.Create("spike_generator", 20, params=[{"spike_times": times} for times in spike_times])
+    parrots = nest.Create("parrot_neuron", 20)
+    neurons = nest.Create("iaf_psc_alpha", 30, params={"I_e": 300.0})
+    sr = nest.Create("spike_recorder")
+
+    nest.Connect(generators, parrots, "one_to_one")
+    nest.Connect(parrots, neurons, {"rule": "fixed_indegree", "indegree": 3}, {"weight": 50.0})
+    nest.Connect(neurons, sr)
+
+    for k in range(3):
+        nest.Simulate(50.0)
+        if full_update:
+            nest.use_compressed_spikes = use_compressed_spikes
+        nest.Connect(
+            parrots[k * 5 : k * 5 + 10], neurons, {"rule": "fixed_outdegree", "outdegree": 2}, {"weight": 200.0}
+        )
+    nest.Simulate(50.0)
+
+    conns = nest.GetConnections(source=parrots, target=neurons).get(["source", "target", "weight"])
+    spikes = sorted(zip(sr.events["senders"], sr.events["times"]))
+
+    return sorted(zip(*conns.values())), spikes
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("use_compressed_spikes", [False, True])
+def test_incremental_update_identical_to_full_update(num_threads, use_compressed_spikes):
+    """
+    Expectation: Connections and spikes are identical for incremental and complete updates.
+    """
+
+    conns_incremental, spikes_incremental = simulate_with_added_connections(num_threads, use_compressed_spikes, False)
+    conns_full, spikes_full = simulate_with_added_connections(num_threads, use_compressed_spikes, True)
+
+    assert len(conns_incremental) == 30 * 3 + 3 * 10 * 2
+    assert len(spikes_incremental) > 0
+    assert conns_incremental == conns_full
+    assert spikes_incremental == spikes_full
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("use_compressed_spikes", [False, True])
+def test_spikes_transmitted_through_added_connections(num_threads, use_compressed_spikes):
+    """
+    Expectation: Spikes are transmitted through connections created after a simulation, also if their source
+    already had targets before.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.use_compressed_spikes = use_compressed_spikes
+
+    sg = nest.Create("spike_generator", params={"spike_times": [10.0, 110.0]})
+    parrots = nest.Create("parrot_neuron", 4)
+    sr = nest.Create("spike_recorder")
+    nest.Connect(sg, parrots[0])
+    nest.Connect(parrots[0], parrots[1])
+    nest.Connect(parrots[1:], sr)
+
+    nest.Simulate(100.0)
+    assert sorted(sr.events["senders"]) == [parrots[1].global_id]
+
+    nest.Connect(parrots[0], parrots[2])
+    nest.Connect(parrots[1], parrots[3])
+    nest.Simulate(100.0)
+
+    assert sorted(sr.events["senders"]) == sorted(parrots.tolist()[1:] + [parrots[1].global_id])
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("use_compressed_spikes", [False, True])
+def test_spikes_in_transit_delivered_after_update(num_threads, use_compressed_spikes):
+    """
+    Expectation: Spikes in transit between simulations reach their targets, also if connections added before
+    the next simulation change the position of existing connections.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.use_compressed_spikes = use_compressed_spikes
+
+    sg = nest.Create("spike_generator", params={"spike_times": [49.0]})
+    parrots = nest.Create("parrot_neuron", 4)
+    sr = nest.Create("spike_recorder")
+    nest.Connect(sg, parrots[1])
+    nest.Connect(parrots[1], parrots[3])
+    nest.Connect(parrots[3], sr)
+
+    # parrots[1] spikes in the last step of the first simulation
+    nest.Simulate(50.0)
+    nest.Connect(parrots[0], parrots[2])
+    nest.Simulate(10.0)
+
+    assert sr.events["times"].tolist() == [51.0]
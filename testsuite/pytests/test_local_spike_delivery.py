@@ -0,0 +1,101 @@
+# -*- coding: utf-8 -*-
+#
+# test_local_spike_delivery.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test delivery of spikes between neurons on the same MPI process.
+
+Spikes to targets on the same process bypass the MPI buffers and are delivered from per-thread registers.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2, 3]
+else:
+    THREAD_NUMBERS = [1]
+
+SPIKE_TIMES = [1.0, 1.3, 2.2, 5.7, 8.0]
+MULTIPLICITIES = [1, 3, 1, 2, 1]
+CHAIN_LENGTH = 7
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("compressed", [False, True])
+@pytest.mark.parametrize("off_grid", [False, True])
+@pytest.mark.parametrize("delay", [0.3, 1.0, 2.5])
+def test_chain_spike_times(num_threads, compressed, off_grid, delay):
+    """
+    Expectation: Each parrot in a chain spanning all threads repeats the input spikes after the chain delay.
+    """
+
+    nest.ResetKernel()
+    nest.resolution = 0.1
+    nest.local_num_threads = num_threads
+    nest.use_compressed_spikes = compressed
+
+    parrot_model = "parrot_neuron_ps" if off_grid else "parrot_neuron"
+    sg = nest.Create(
+        "spike_generator",
+        params={"spike_times": SPIKE_TIMES, "spike_multiplicities": MULTIPLICITIES, "precise_times": off_grid},
+    )
+    chain = nest.Create(parrot_model, CHAIN_LENGTH)
+    srs = nest.Create("spike_recorder", CHAIN_LENGTH)
+    nest.Connect(sg, chain[0], syn_spec={"delay": 1.0})
+    nest.Connect(chain[:-1], chain[1:], "one_to_one", syn_spec={"delay": delay})
+    nest.Connect(chain, srs, "one_to_one")
+
+    # split simulation so that spikes are pending across calls to Simulate
+    for _ in range(5):
+        nest.Simulate(5.3)
+
+    expected_times = np.repeat(SPIKE_TIMES, MULTIPLICITIES)
+    for position, sr in enumerate(srs):
+        times = np.sort(sr.events["times"])
+        np.testing.assert_allclose(times, expected_times + 1.0 + position * delay)
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_convergent_connections_with_plastic_synapse(num_threads):
+    """
+    Expectation: Targets receive the input of all sources on all threads, also through plastic synapses.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+
+    num_sources = 10
+    sg = nest.Create("spike_generator", params={"spike_times": [2.0, 4.0]})
+    sources = nest.Create("parrot_neuron", num_sources)
+    targets = nest.Create("parrot_neuron", 2)
+    sr = nest.Create("spike_recorder")
+    nest.Connect(sg, sources)
+    nest.Connect(sources, targets[0], syn_spec={"synapse_model": "static_synapse"})
+    nest.Connect(sources, targets[1], syn_spec={"synapse_model": "stdp_synapse"})
+    nest.Connect(targets, sr)
+
+    nest.Simulate(10.0)
+
+    events = sr.events
+    for target in targets:
+        times = events["times"][events["senders"] == target.global_id]
+        np.testing.assert_array_equal(np.sort(times), np.repeat([4.0, 6.0], num_sources))
@@ -0,0 +1,213 @@
+# -*- coding: utf-8 -*-
+#
+# test_network_snapshot.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test saving networks to binary snapshots and loading them again.
+"""
+
+import nest
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2]
+else:
+    THREAD_NUMBERS = [1]
+
+
+def build_network(num_threads):
+    """
+    Create a randomly connected network of neurons with static and plastic synapses.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.rng_seed = 1234
+
+    exc = nest.Create("iaf_psc_alpha", 40, params={"I_e": 380.0, "V_m": nest.random.uniform(-70.0, -55.0)})
+    inh = nest.Create("iaf_psc_exp", 10, params={"I_e": 380.0})
+    parrots = nest.Create("parrot_neuron", 5)
+
+    nest.Connect(
+        exc,
+        exc + inh,
+        {"rule": "pairwise_bernoulli", "p": 0.2},
+        {"synapse_model": "stdp_synapse", "weight": nest.random.uniform(20.0, 40.0), "delay": 1.5},
+    )
+    nest.Connect(inh, exc, {"rule": "fixed_indegree", "indegree": 3}, {"weight": -50.0, "delay": 2.0})
+    nest.Connect(parrots, exc[:5], "one_to_one")
+
+    return exc + inh
+
+
+def connections(synapse_model):
+    return sorted(
+        zip(
+            *nest.GetConnections(synapse_model=synapse_model).get(["source", "target", "weight", "delay"]).values()
+        )
+    )
+
+
+def record_spikes(neurons):
+    sr = nest.Create("spike_recorder")
+    nest.Connect(neurons, sr)
+    nest.Simulate(100.0)
+    return sorted(zip(sr.events["senders"], sr.events["times"]))
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_snapshot_restores_network(tmp_path, num_threads):
+    """
+    Expectation: The loaded network has the same nodes, node parameters and connections as the saved one.
+    """
+
+    neurons = build_network(num_threads)
+    V_m = neurons.V_m
+    static = connections("static_synapse")
+    stdp = connections("stdp_synapse")
+    nest.SaveNetwork(tmp_path / "net.bin")
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.LoadNetwork(tmp_path / "net.bin")
+    neurons = nest.NodeCollection(list(range(1, 51)))
+
+    assert nest.network_size == 55
+    assert nest.NodeCollection([55]).model == "parrot_neuron"
+    assert neurons.V_m == V_m
+    assert connections("static_synapse") == static
+    assert connections("stdp_synapse") == stdp
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_loaded_network_simulates_identically(tmp_path, num_threads):
+    """
+    Expectation: Loaded and originally constructed networks produce the same spikes.
+    """
+
+    neurons = build_network(num_threads)
+    nest.SaveNetwork(tmp_path / "net.bin")
+    expected = record_spikes(neurons)
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.LoadNetwork(tmp_path / "net.bin")
+    neurons = nest.NodeCollection(list(range(1, 51)))
+
+    assert len(expected) > 0
+    assert record_spikes(neurons) == expected
+
+
+def test_snapshot_restores_array_and_dictionary_entries(tmp_path):
+    """
+    Expectation: Status entries holding arrays and dictionaries are restored.
+    """
+
+    nest.ResetKernel()
+    nest.Create("multimeter", params={"record_from": ["V_m", "I_syn_ex"], "label": "mm"})
+    nest.Create("spike_recorder")
+    nest.SaveNetwork(tmp_path / "net.bin")
+
+    nest.ResetKernel()
+    nest.LoadNetwork(tmp_path / "net.bin")
+    mm = nest.NodeCollection([1])
+
+    assert mm.record_from == ("V_m", "I_syn_ex")
+    assert mm.label == "mm"
+    assert nest.NodeCollection([2]).n_events == 0
+
+
+@pytest.mark.parametrize(
+    "model, params, receptor_types",
+    [
+        ("iaf_psc_exp_multisynapse", {"tau_syn": [1.0, 2.0, 3.0]}, [1, 2, 3]),
+        pytest.param("ht_neuron", {}, [1, 2, 3, 4], marks=pytest.mark.skipif_missing_gsl),
+        pytest.param("iaf_cond_alpha_mc", {}, [1, 2, 3, 4, 5, 6], marks=pytest.mark.skipif_missing_gsl),
+        pytest.param("pp_cond_exp_mc_urbanczik", {}, [1, 2, 3, 4], marks=pytest.mark.skipif_missing_gsl),
+    ],
+)
+def test_snapshot_restores_receptor_types(tmp_path, model, params, receptor_types):
+    """
+    Expectation: Connections to receptors of multisynapse and multi-compartment neurons keep their receptor.
+    """
+
+    nest.ResetKernel()
+    sources = nest.Create("parrot_neuron", len(receptor_types))
+    target = nest.Create(model, params=params)
+    for source, receptor_type in zip(sources, receptor_types):
+        nest.Connect(source, target, syn_spec={"receptor_type": receptor_type})
+    expected = sorted(zip(*nest.GetConnections().get(["source", "receptor"]).values()))
+    nest.SaveNetwork(tmp_path / "net.bin")
+
+    nest.ResetKernel()
+    nest.LoadNetwork(tmp_path / "net.bin")
+
+    assert sorted(zip(*nest.GetConnections().get(["source", "receptor"]).values())) == expected
+
+
+def test_load_requires_empty_network(tmp_path):
+    """
+    Expectation: A snapshot cannot be loaded into a network that already contains nodes.
+    """
+
+    build_network(1)
+    nest.SaveNetwork(tmp_path / "net.bin")
+
+    with pytest.raises(nest.kernel.NESTError):
+        nest.LoadNetwork(tmp_path / "net.bin")
+
+
+def test_load_requires_same_resolution(tmp_path):
+    """
+    Expectation: A snapshot cannot be loaded with a different resolution.
+    """
+
+    build_network(1)
+    nest.SaveNetwork(tmp_path / "net.bin")
+
+    nest.ResetKernel()
+    nest.resolution = 0.2
+
+    with pytest.raises(nest.kernel.NESTError):
+        nest.LoadNetwork(tmp_path / "net.bin")
+
+
+def test_save_after_simulate_fails(tmp_path):
+    """
+    Expectation: Networks that have been simulated cannot be saved.
+    """
+
+    build_network(1)
+    nest.Simulate(1.0)
+
+    with pytest.raises(nest.kernel.NESTError):
+        nest.SaveNetwork(tmp_path / "net.bin")
+
+
+def test_save_with_device_connections_fails(tmp_path):
+    """
+    Expectation: Networks with connections to or from devices cannot be saved.
+    """
+
+    neurons = build_network(1)
+    nest.Connect(nest.Create("poisson_generator"), neurons)
+
+    with pytest.raises(nest.kernel.NESTError):
+        nest.SaveNetwork(tmp_path / "net.bin")
@@ -0,0 +1,163 @@
+# -*- coding: utf-8 -*-
+#
+# test_node_collection_get_set_arrays.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test creating nodes and getting and setting single parameters of many nodes, which bypass the SLI interpreter.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def test_create_without_params():
+    """
+    Expectation: Nodes created without parameters form a NodeCollection with consecutive node IDs.
+    """
+
+    first = nest.Create("iaf_psc_alpha", 5)
+    second = nest.Create("parrot_neuron")
+
+    assert first.tolist() == [1, 2, 3, 4, 5]
+    assert second.global_id == 6
+    assert second.get("model") == "parrot_neuron"
+
+
+@pytest.mark.parametrize("n", [0, -1])
+def test_create_illegal_number(n):
+    """
+    Expectation: Creating no nodes or a negative number of nodes raises an error.
+    """
+
+    with pytest.raises(nest.kernel.NESTErrors.RangeCheck):
+        nest.Create("iaf_psc_alpha", n)
+
+
+def test_create_unknown_model():
+    """
+    Expectation: Creating nodes of an unknown model raises an error.
+    """
+
+    with pytest.raises(nest.kernel.NESTErrors.UnknownModelName):
+        nest.Create("no_such_model")
+
+
+def test_get_single_parameter_types():
+    """
+    Expectation: Values of a single parameter are returned as tuple of Python values, or as value for one node.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 3)
+
+    assert nodes.get("V_m") == (-70.0, -70.0, -70.0)
+    assert nodes.get("global_id") == (1, 2, 3)
+    assert nodes.get("frozen") == (False, False, False)
+    assert nodes.get("model") == ("iaf_psc_alpha",) * 3
+    assert all(type(v) is float for v in nodes.get("V_m"))
+    assert all(type(v) is int for v in nodes.get("global_id"))
+
+    assert nodes[1].get("V_m") == -70.0
+    assert type(nodes[1].get("global_id")) is int
+
+
+def test_get_several_parameters():
+    """
+    Expectation: Values of several parameters are returned as dictionary of tuples, or of values for one node.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 3)
+
+    assert nodes.get(["V_m", "global_id"]) == {"V_m": (-70.0, -70.0, -70.0), "global_id": (1, 2, 3)}
+    assert nodes[1].get(["V_m", "global_id"]) == {"V_m": -70.0, "global_id": 2}
+
+
+def test_get_unknown_parameter():
+    """
+    Expectation: Getting an unknown parameter raises a KeyError.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 3)
+
+    with pytest.raises(KeyError):
+        nodes.get("no_such_parameter")
+
+
+def test_set_arrays_and_scalars():
+    """
+    Expectation: Arrays and single values of floating point parameters are set for all nodes.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 4)
+    V_m = np.array([-60.0, -61.0, -62.0, -63.0])
+    nodes.set(V_m=V_m, I_e=[1.0, 2, 3.0, 4.0], C_m=200.0)
+
+    assert nodes.get("V_m") == tuple(V_m)
+    assert nodes.get("I_e") == (1.0, 2.0, 3.0, 4.0)
+    assert nodes.get("C_m") == (200.0,) * 4
+
+
+def test_set_parameters_checked_together():
+    """
+    Expectation: All parameters of a node are set together, so that their consistency is checked only once.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 2)
+    nodes.set(V_th=[-40.0, -45.0], V_reset=[-42.0, -46.0])
+
+    assert nodes.get("V_reset") == (-42.0, -46.0)
+
+    with pytest.raises(nest.kernel.NESTError):
+        nodes.set(V_reset=[-30.0, -30.0])
+
+
+def test_set_mixed_types():
+    """
+    Expectation: Parameters that are not floating point values are set as before.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 2)
+    nodes.set(V_m=[-60.0, -61.0], frozen=[True, False])
+
+    assert nodes.get("V_m") == (-60.0, -61.0)
+    assert nodes.get("frozen") == (True, False)
+
+
+@pytest.mark.parametrize("shape", [(1, 0), (0, 3)])
+def test_set_empty_values(shape):
+    """
+    Expectation: An empty array of values sets nothing and raises an error if its size does not match the nodes.
+    """
+
+    nodes = nest.Create("iaf_psc_alpha", 3)
+    keys = ["V_m"] * shape[0]
+
+    if shape[1] == len(nodes):
+        nest.ll_api.set_node_values(nodes._datum, keys, np.empty(shape))
+    else:
+        with pytest.raises(nest.kernel.NESTErrors.DimensionMismatch):
+            nest.ll_api.set_node_values(nodes._datum, keys, np.empty(shape))
+
+    assert nodes.get("V_m") == (-70.0, -70.0, -70.0)
@@ -0,0 +1,86 @@
+# -*- coding: utf-8 -*-
+#
+# test_node_memory.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test memory pools for nodes and their alignment.
+"""
+
+import nest
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def test_node_memory_keys():
+    """
+    Expectation: node_memory reports all statistics of the node memory pools.
+    """
+
+    assert set(nest.node_memory.keys()) == {"instantiations", "capacity", "available", "bytes", "alignment"}
+
+
+def test_node_memory_grows_with_nodes():
+    """
+    Expectation: Each created node is counted as instantiation and pools allocate memory for it.
+    """
+
+    before = nest.node_memory
+    nest.Create("iaf_psc_alpha", 10)
+    nest.Create("parrot_neuron", 5)
+    after = nest.node_memory
+
+    assert after["instantiations"] - before["instantiations"] == 15
+    assert after["capacity"] >= after["instantiations"]
+    assert after["available"] == after["capacity"] - after["instantiations"]
+    assert after["bytes"] > 0
+
+
+def test_align_nodes_to_cache_lines():
+    """
+    Expectation: Nodes are aligned to cache lines if requested, and the alignment is reset with the kernel.
+    """
+
+    assert not nest.align_nodes_to_cache_lines
+
+    nest.align_nodes_to_cache_lines = True
+    assert nest.align_nodes_to_cache_lines
+    assert nest.node_memory["alignment"] == 64
+
+    nest.Create("iaf_psc_alpha", 10)
+    nest.Simulate(10.0)
+
+    nest.ResetKernel()
+    assert not nest.align_nodes_to_cache_lines
+    assert nest.node_memory["alignment"] < 64
+
+
+def test_align_nodes_to_cache_lines_after_create_fails():
+    """
+    Expectation: Alignment of nodes cannot be changed once nodes exist.
+    """
+
+    nest.Create("iaf_psc_alpha")
+
+    with pytest.raises(nest.kernel.NESTError):
+        nest.align_nodes_to_cache_lines = True
@@ -0,0 +1,125 @@
+# -*- coding: utf-8 -*-
+#
+# test_overlap_spike_communication.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that overlapping spike communication with the update does not change simulation results.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2, 4]
+else:
+    THREAD_NUMBERS = [1]
+
+
+def _simulate_chain(overlap, num_threads, delays, off_grid=False):
+    """
+    Simulate chains of parrot neurons driven by irregular spike trains and return recorded spikes.
+
+    Each chain uses a different delay. Simulation is split into several calls to ``Simulate``.
+    """
+
+    nest.ResetKernel()
+    nest.resolution = 0.1
+    nest.local_num_threads = num_threads
+    nest.overlap_spike_communication = overlap
+
+    sr = nest.Create("spike_recorder")
+    parrot_model = "parrot_neuron_ps" if off_grid else "parrot_neuron"
+    for delay in delays:
+        sg = nest.Create(
+            "spike_generator",
+            params={"spike_times": [1.0, 1.3, 2.2, 2.3, 5.7, 8.0, 8.1], "precise_times": off_grid},
+        )
+        chain = nest.Create(parrot_model, 6)
+        nest.Connect(sg, chain[0])
+        nest.Connect(chain[:-1], chain[1:], "one_to_one", syn_spec={"delay": delay})
+        nest.Connect(chain, sr)
+
+    for _ in range(3):
+        nest.Simulate(7.3)
+
+    events = sr.events
+    order = np.lexsort((events["senders"], events["times"]))
+    return events["senders"][order], events["times"][order]
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("delays", [[0.2], [0.5, 1.0], [0.3, 1.7]])
+@pytest.mark.parametrize("off_grid", [False, True])
+def test_overlap_preserves_spikes(num_threads, delays, off_grid):
+    """
+    Expectation: The same spikes are recorded with and without overlapping communication.
+    """
+
+    senders_ref, times_ref = _simulate_chain(False, num_threads, delays, off_grid)
+    senders, times = _simulate_chain(True, num_threads, delays, off_grid)
+
+    assert len(times_ref) > 0
+    np.testing.assert_array_equal(senders, senders_ref)
+    np.testing.assert_array_equal(times, times_ref)
+
+
+def test_min_delay_is_reported_unchanged():
+    """
+    Expectation: The kernel reports the smallest delay in the network, not the shortened time slice.
+    """
+
+    nest.ResetKernel()
+    nest.overlap_spike_communication = True
+    n = nest.Create("parrot_neuron", 2)
+    nest.Connect(n[0], n[1], syn_spec={"delay": 1.5})
+    nest.Simulate(10.0)
+
+    assert nest.min_delay == pytest.approx(1.5)
+
+
+def test_connect_after_simulate_respects_slice_length():
+    """
+    Expectation: Delays of at least twice the slice length are accepted once simulation has started, shorter
+    delays are rejected.
+    """
+
+    nest.ResetKernel()
+    nest.overlap_spike_communication = True
+    n = nest.Create("parrot_neuron", 2)
+    nest.Connect(n[0], n[1], syn_spec={"delay": 1.5})
+    nest.Simulate(10.0)
+
+    # 15 steps of 0.1 ms give slices of 7 steps
+    nest.Connect(n[1], n[0], syn_spec={"delay": 1.4})
+    with pytest.raises(nest.kernel.NESTErrors.BadDelay):
+        nest.Connect(n[1], n[0], syn_spec={"delay": 1.3})
+
+
+def test_cannot_change_after_simulate():
+    """
+    Expectation: Switching overlapping communication on or off after simulation has started is an error.
+    """
+
+    nest.ResetKernel()
+    nest.Simulate(1.0)
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.overlap_spike_communication = True
@@ -0,0 +1,136 @@
+# -*- coding: utf-8 -*-
+#
+# test_recording_backend_binary.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that the binary recording backend records the same data as the memory backend.
+"""
+
+import nest
+import numpy as np
+import numpy.testing as nptest
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def prepare(tmp_path):
+    nest.ResetKernel()
+    nest.data_path = str(tmp_path)
+    nest.overwrite_files = True
+
+
+def read_all(recorder):
+    """Read and concatenate the files of all threads, sorted by sender and time."""
+
+    files = [nest.read_binary_recording(fname) for fname in recorder.filenames]
+    data = {key: np.concatenate([f[key] for f in files]) for key in files[0]}
+    time = data["time_step"] if "time_step" in data else data["time_ms"]
+    order = np.lexsort((time, data["sender"]))
+    return {key: val[order] for key, val in data.items()}
+
+
+def sorted_events(recorder):
+    events = recorder.events
+    order = np.lexsort((events["times"], events["senders"]))
+    return {key: np.asarray(val)[order] for key, val in events.items()}
+
+
+@pytest.mark.parametrize("chunk_size", [1, 7, 4096])
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_spikes_match_memory_backend(chunk_size, num_threads):
+    """Test that spikes are recorded completely, also if they fill many chunks."""
+
+    nest.local_num_threads = num_threads
+    nest.SetDefaults("binary", {"chunk_size": chunk_size, "max_pending_chunks": 2})
+
+    neurons = nest.Create("iaf_psc_alpha", 10, params={"I_e": 400.0})
+    sr_binary = nest.Create("spike_recorder", params={"record_to": "binary"})
+    sr_memory = nest.Create("spike_recorder")
+    nest.Connect(neurons, sr_binary)
+    nest.Connect(neurons, sr_memory)
+
+    nest.Simulate(200.0)
+
+    binary = read_all(sr_binary)
+    memory = sorted_events(sr_memory)
+
+    assert list(binary.keys()) == ["sender", "time_ms"]
+    assert binary["sender"].dtype == np.uint64
+    assert len(binary["sender"]) == sr_memory.n_events > 0
+    nptest.assert_array_equal(binary["sender"], memory["senders"])
+    nptest.assert_array_equal(binary["time_ms"], memory["times"])
+
+
+def test_multimeter_with_time_in_steps():
+    """Test the columns written for a multimeter with time in steps."""
+
+    neuron = nest.Create("iaf_psc_alpha", params={"I_e": 400.0})
+    params = {"record_from": ["V_m", "I_syn_ex"], "interval": 0.5, "time_in_steps": True}
+    mm_binary = nest.Create("multimeter", params=dict(params, record_to="binary"))
+    mm_memory = nest.Create("multimeter", params=params)
+    nest.Connect(mm_binary, neuron)
+    nest.Connect(mm_memory, neuron)
+
+    nest.Simulate(100.0)
+
+    binary = read_all(mm_binary)
+    memory = sorted_events(mm_memory)
+
+    assert list(binary.keys()) == ["sender", "time_step", "time_offset", "V_m", "I_syn_ex"]
+    assert binary["time_step"].dtype == np.int64
+    nptest.assert_array_equal(binary["time_step"], memory["times"])
+    nptest.assert_array_equal(binary["time_offset"], memory["offsets"])
+    nptest.assert_array_equal(binary["V_m"], memory["V_m"])
+    nptest.assert_array_equal(binary["I_syn_ex"], memory["I_syn_ex"])
+
+
+def test_data_available_after_each_run():
+    """Test that all data recorded so far can be read after each call to Run."""
+
+    nest.SetDefaults("binary", {"chunk_size": 1000})
+
+    neuron = nest.Create("iaf_psc_alpha")
+    mm = nest.Create("multimeter", params={"record_from": ["V_m"], "interval": 1.0, "record_to": "binary"})
+    nest.Connect(mm, neuron)
+
+    with nest.RunManager():
+        for n in range(1, 4):
+            nest.Run(10.0)
+            data = nest.read_binary_recording(mm.filenames[0])
+            nptest.assert_array_equal(data["time_ms"], np.arange(1.0, 10.0 * n))
+
+
+def test_no_events():
+    """Test that a file without records yields empty columns."""
+
+    sr = nest.Create("spike_recorder", params={"record_to": "binary"})
+    nest.Connect(nest.Create("iaf_psc_alpha"), sr)
+
+    nest.Simulate(10.0)
+
+    data = nest.read_binary_recording(sr.filenames[0])
+    assert list(data.keys()) == ["sender", "time_ms"]
+    assert len(data["sender"]) == 0
+
+
+@pytest.mark.parametrize("param", ["chunk_size", "max_pending_chunks"])
+def test_invalid_backend_parameters(param):
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.SetDefaults("binary", {param: 0})
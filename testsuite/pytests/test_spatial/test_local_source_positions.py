@@ -0,0 +1,132 @@
+# -*- coding: utf-8 -*-
+#
+# test_local_source_positions.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that gathering only source positions near local targets creates the same connections.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def connect(source_positions, target_positions, conn_spec, use_local_source_positions):
+    """
+    Connect two spatial populations and return the connections as (source, target, weight) tuples.
+    """
+
+    nest.ResetKernel()
+    nest.set(rng_seed=12, local_num_threads=2)
+    sources = nest.Create("iaf_psc_alpha", positions=source_positions)
+    targets = nest.Create("iaf_psc_alpha", positions=target_positions)
+    nest.Connect(
+        sources,
+        targets,
+        dict(conn_spec, use_local_source_positions=use_local_source_positions),
+        {"weight": 1.0 + nest.spatial.distance},
+    )
+
+    conns = nest.GetConnections(sources, targets)
+    return sorted(zip(conns.source, conns.target, conns.weight))
+
+
+@pytest.mark.parametrize("edge_wrap", [False, True])
+@pytest.mark.parametrize(
+    "conn_spec",
+    [
+        {"rule": "pairwise_bernoulli", "p": 0.5, "mask": {"circular": {"radius": 0.15}}},
+        {
+            "rule": "pairwise_bernoulli",
+            "p": 0.5,
+            "use_on_source": True,
+            "mask": {"rectangular": {"lower_left": [-0.1, -0.05], "upper_right": [0.2, 0.1]}, "anchor": [0.03, 0.0]},
+        },
+        {"rule": "fixed_indegree", "indegree": 10, "mask": {"circular": {"radius": 0.2}}},
+        {"rule": "pairwise_poisson", "pairwise_avg_num_conns": 0.5, "mask": {"circular": {"radius": 0.1}}},
+    ],
+)
+def test_free_layers_same_connections(conn_spec, edge_wrap):
+    """
+    Test that connections from a free layer to targets in a corner of the layer are unchanged.
+
+    With periodic boundary conditions, masks of the targets extend across the border of the layer.
+    """
+
+    rng = np.random.default_rng(123)
+    source_positions = nest.spatial.free(
+        rng.uniform(-0.5, 0.5, (3000, 2)).tolist(), extent=[1.0, 1.0], edge_wrap=edge_wrap
+    )
+    target_positions = nest.spatial.free(
+        rng.uniform(0.2, 0.45, (200, 2)).tolist(), extent=[1.0, 1.0], edge_wrap=edge_wrap
+    )
+
+    global_conns = connect(source_positions, target_positions, conn_spec, False)
+    local_conns = connect(source_positions, target_positions, conn_spec, True)
+
+    assert len(global_conns) > 0
+    assert local_conns == global_conns
+
+
+@pytest.mark.parametrize(
+    "mask",
+    [
+        {"grid": {"shape": [5, 3]}, "anchor": [2, 1]},
+        {"rectangular": {"lower_left": [-0.1, -0.1], "upper_right": [0.1, 0.1]}},
+    ],
+)
+def test_grid_layers_same_connections(mask):
+    """
+    Test that connections between grid layers with grid and rectangular masks are unchanged.
+    """
+
+    source_positions = nest.spatial.grid(shape=[40, 40], edge_wrap=True)
+    target_positions = nest.spatial.grid(shape=[40, 40], edge_wrap=True)
+    conn_spec = {"rule": "pairwise_bernoulli", "p": 0.6, "mask": mask}
+
+    global_conns = connect(source_positions, target_positions, conn_spec, False)
+    local_conns = connect(source_positions, target_positions, conn_spec, True)
+
+    assert len(global_conns) > 0
+    assert local_conns == global_conns
+
+
+def test_fixed_outdegree_not_supported():
+    """
+    Test that fixed_outdegree, which draws targets for all sources on all MPI processes, is rejected.
+    """
+
+    layer = nest.Create("iaf_psc_alpha", positions=nest.spatial.grid(shape=[5, 5]))
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.Connect(
+            layer,
+            layer,
+            {
+                "rule": "fixed_outdegree",
+                "outdegree": 2,
+                "mask": {"circular": {"radius": 0.2}},
+                "use_local_source_positions": True,
+            },
+        )
@@ -0,0 +1,74 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_buffer_growth.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that bursts of spikes are transmitted completely when MPI buffers for spikes need to grow.
+
+Spikes are collocated thread-parallel into the MPI buffers. When run on several MPI processes,
+the burst exceeds the initial buffer size and forces the buffers to be resized.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2, 4]
+else:
+    THREAD_NUMBERS = [1]
+
+BURST_TIMES = [2.0, 5.0, 5.1]
+NUM_SOURCES = 300
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("sort_by_thread", [False, True])
+@pytest.mark.parametrize("compressed_spikes", [False, True])
+def test_burst_is_delivered(num_threads, sort_by_thread, compressed_spikes):
+    """
+    Expectation: Each target receives the spikes of all sources.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.sort_spikes_by_thread = sort_by_thread
+    nest.use_compressed_spikes = compressed_spikes
+
+    sg = nest.Create("spike_generator", params={"spike_times": BURST_TIMES})
+    sources = nest.Create("parrot_neuron", NUM_SOURCES)
+    targets = nest.Create("parrot_neuron", 10)
+    sr = nest.Create("spike_recorder")
+    nest.Connect(sg, sources)
+    nest.Connect(sources, targets, syn_spec={"delay": 1.0})
+    nest.Connect(targets, sr)
+
+    nest.Simulate(10.0)
+
+    events = sr.events
+    local_targets = nest.GetLocalNodeCollection(targets).tolist()
+    assert sorted(np.unique(events["senders"])) == local_targets
+    expected_times = np.repeat(np.array(BURST_TIMES) + 2.0, NUM_SOURCES)
+    for target in local_targets:
+        times = np.sort(events["times"][events["senders"] == target])
+        np.testing.assert_allclose(times, expected_times)
+
+    if nest.num_processes > 1:
+        assert len(nest.spike_buffer_resize_log["times"]) > 0
@@ -0,0 +1,103 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_exchange_mode.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that all spike exchange modes transmit the same spikes.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2]
+else:
+    THREAD_NUMBERS = [1]
+
+
+def _simulate(mode, num_threads, compressed_spikes, sort_by_thread, off_grid):
+    """
+    Simulate a randomly connected network of parrot neurons driven by Poisson input and return recorded spikes.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+    nest.rng_seed = 1234
+    nest.spike_exchange_mode = mode
+    nest.use_compressed_spikes = compressed_spikes
+    nest.sort_spikes_by_thread = sort_by_thread
+
+    parrot_model = "parrot_neuron_ps" if off_grid else "parrot_neuron"
+    pg = nest.Create("poisson_generator_ps" if off_grid else "poisson_generator", params={"rate": 50.0})
+    inputs = nest.Create(parrot_model, 10)
+    outputs = nest.Create(parrot_model, 20)
+    sr = nest.Create("spike_recorder")
+
+    nest.Connect(pg, inputs)
+    nest.Connect(inputs, outputs, {"rule": "fixed_indegree", "indegree": 2}, {"delay": nest.random.uniform(1.0, 2.0)})
+    nest.Connect(outputs, sr)
+
+    nest.Simulate(50.0)
+    nest.Simulate(50.0)
+
+    events = sr.events
+    order = np.lexsort((events["senders"], events["times"]))
+    return events["senders"][order], events["times"][order]
+
+
+@pytest.mark.parametrize("mode", ["alltoallv", "neighbor_alltoallv"])
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("compressed_spikes, sort_by_thread", [(True, False), (False, False), (False, True)])
+@pytest.mark.parametrize("off_grid", [False, True])
+def test_spike_exchange_modes_agree(mode, num_threads, compressed_spikes, sort_by_thread, off_grid):
+    """
+    Expectation: The same spikes are recorded as with the default mode.
+    """
+
+    senders_ref, times_ref = _simulate("alltoall", num_threads, compressed_spikes, sort_by_thread, off_grid)
+    senders, times = _simulate(mode, num_threads, compressed_spikes, sort_by_thread, off_grid)
+
+    assert len(times_ref) > 0
+    np.testing.assert_array_equal(senders, senders_ref)
+    np.testing.assert_array_equal(times, times_ref)
+
+
+def test_unknown_mode_raises():
+    nest.ResetKernel()
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.spike_exchange_mode = "broadcast"
+
+
+def test_cannot_combine_with_overlap():
+    nest.ResetKernel()
+    nest.overlap_spike_communication = True
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.spike_exchange_mode = "alltoallv"
+
+
+def test_cannot_change_after_simulate():
+    nest.ResetKernel()
+    nest.Simulate(1.0)
+
+    with pytest.raises(nest.kernel.NESTErrors.BadProperty):
+        nest.spike_exchange_mode = "neighbor_alltoallv"
@@ -0,0 +1,112 @@
+# -*- coding: utf-8 -*-
+#
+# test_spike_multiplicity_transmission.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that spikes with multiplicity are transmitted completely through the connection infrastructure.
+
+Multiplicities above the number of spikes a single spike-data entry can hold are split over several entries.
+"""
+
+import nest
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2]
+else:
+    THREAD_NUMBERS = [1]
+
+SPIKE_TIMES = [1.0, 2.0, 3.0, 4.0]
+MULTIPLICITIES = [1, 3, 10, 20]
+
+
+def create_parrot(num_threads, precise_times=False):
+    """
+    Create a parrot neuron that emits spikes with the given multiplicities.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+
+    sg = nest.Create(
+        "spike_generator",
+        params={
+            "spike_times": SPIKE_TIMES,
+            "spike_multiplicities": MULTIPLICITIES,
+            "precise_times": precise_times,
+        },
+    )
+    parrot = nest.Create("parrot_neuron_ps" if precise_times else "parrot_neuron")
+    nest.Connect(sg, parrot)
+
+    return parrot
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+@pytest.mark.parametrize("precise_times", [False, True])
+def test_multiplicity_transmitted(num_threads, precise_times):
+    """
+    Expectation: A spike recorder connected by static synapses records every spike of a multi-spike event.
+    """
+
+    parrot = create_parrot(num_threads, precise_times)
+    srs = nest.Create("spike_recorder", num_threads)
+    nest.Connect(parrot, srs)
+
+    nest.Simulate(10.0)
+
+    for sr in srs:
+        assert sr.n_events == sum(MULTIPLICITIES)
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_multiplicity_unrolled_for_plastic_synapses(num_threads):
+    """
+    Expectation: Plastic synapses handle each spike of a multi-spike event individually.
+    """
+
+    parrot = create_parrot(num_threads)
+    neurons = nest.Create("iaf_psc_alpha", num_threads)
+    wr = nest.Create("weight_recorder")
+    nest.CopyModel("stdp_synapse", "stdp_synapse_rec", {"weight_recorder": wr})
+    nest.Connect(parrot, neurons, syn_spec={"synapse_model": "stdp_synapse_rec"})
+
+    nest.Simulate(10.0)
+
+    assert wr.n_events == num_threads * sum(MULTIPLICITIES)
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_multiplicity_input_identical(num_threads):
+    """
+    Expectation: Neurons receive the same input through synapses with and without support for multiplicity.
+
+    Weights are integers so that summation of input is exact.
+    """
+
+    parrot = create_parrot(num_threads)
+    neurons = nest.Create("iaf_psc_alpha", 2, params={"V_th": 1000.0})
+    nest.Connect(parrot, neurons[0], syn_spec={"synapse_model": "static_synapse", "weight": 10.0})
+    nest.Connect(parrot, neurons[1], syn_spec={"synapse_model": "stdp_synapse", "weight": 10.0, "lambda": 0.0})
+
+    nest.Simulate(5.0)
+
+    assert neurons[0].V_m > neurons[0].E_L
+    assert neurons[0].V_m == neurons[1].V_m
@@ -51,7 +51,7 @@ class TestSpikeTransmission:
     t_arrival = t_spike + 2 * delay  # expected spike arrival time
 
     @classmethod
-    def _simulate_network(cls, n_pre, n_post, conn_rule, num_threads, compressed_spikes):
+    def _simulate_network(cls, n_pre, n_post, conn_rule, num_threads, compressed_spikes, sort_by_thread=False):
         """
         Simulate network for given parameters and return spike recorder events.
 
@@ -62,6 +62,7 @@ class TestSpikeTransmission:
         nest.resolution = cls.dt
         nest.local_num_threads = num_threads
         nest.use_compressed_spikes = compressed_spikes
+        nest.sort_spikes_by_thread = sort_by_thread
 
         sg = nest.Create("spike_generator", params={"spike_times": [cls.t_spike]})
         sr = nest.Create("spike_recorder")
@@ -145,3 +146,21 @@ class TestSpikeTransmission:
         )
         assert sorted(spike_data["senders"]) == sorted(num_neurons * post_pop.tolist())
         assert all(spike_data["times"] == self.t_arrival)
+
+    @pytest.mark.parametrize("conn_rule", ["one_to_one", "all_to_all"])
+    @pytest.mark.parametrize("num_neurons", [4, 5])
+    @pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+    def test_sort_spikes_by_thread(self, conn_rule, num_neurons, num_threads):
+        """
+        Test that sorting spikes by target thread does not affect transmission.
+
+        Expectation: Each post neuron receives exactly one spike from each connected pre neuron,
+        exactly as for unsorted transmission.
+        """
+
+        post_pop, spike_data = self._simulate_network(
+            num_neurons, num_neurons, conn_rule, num_threads, False, sort_by_thread=True
+        )
+        num_pre_per_post = 1 if conn_rule == "one_to_one" else num_neurons
+        assert sorted(spike_data["senders"]) == sorted(num_pre_per_post * post_pop.tolist())
+        assert all(spike_data["times"] == self.t_arrival)
@@ -0,0 +1,89 @@
+# -*- coding: utf-8 -*-
+#
+# test_static_synapse_compact.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test static synapses with single precision weights and the reported synapse sizes.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def test_bytes_per_synapse_lists_all_models():
+    """
+    Expectation: bytes_per_synapse reports a positive size for each synapse model.
+    """
+
+    sizes = nest.bytes_per_synapse
+    assert set(sizes.keys()) == set(nest.synapse_models)
+    assert all(size > 0 for size in sizes.values())
+
+
+@pytest.mark.parametrize("suffix", ["", "_hpc"])
+def test_compact_synapse_is_smaller(suffix):
+    """
+    Expectation: Compact static synapses take less memory than static synapses.
+    """
+
+    sizes = nest.bytes_per_synapse
+    assert sizes["static_synapse_compact" + suffix] < sizes["static_synapse" + suffix]
+
+
+@pytest.mark.parametrize("synapse_model", ["static_synapse_compact", "static_synapse_compact_hpc"])
+def test_compact_synapse_transmits_spikes(synapse_model):
+    """
+    Expectation: Compact static synapses store weight and delay and transmit spikes like static synapses.
+    """
+
+    sg = nest.Create("spike_generator", params={"spike_times": [1.0]})
+    parrot = nest.Create("parrot_neuron")
+    targets = nest.Create("iaf_psc_delta", 2)
+    nest.Connect(sg, parrot)
+    nest.Connect(parrot, targets[0], syn_spec={"synapse_model": "static_synapse", "weight": 0.1, "delay": 1.5})
+    nest.Connect(parrot, targets[1], syn_spec={"synapse_model": synapse_model, "weight": 0.1, "delay": 1.5})
+
+    conn = nest.GetConnections(synapse_model=synapse_model)
+    assert conn.weight == pytest.approx(0.1, rel=1e-7)
+    assert conn.delay == 1.5
+
+    nest.Simulate(5.0)
+    assert targets[1].V_m == pytest.approx(targets[0].V_m, rel=1e-6)
+
+
+def test_compact_synapse_weight_precision():
+    """
+    Expectation: Weights are stored in single precision.
+    """
+
+    n = nest.Create("iaf_psc_alpha", 2)
+    nest.Connect(n[0], n[1], syn_spec={"synapse_model": "static_synapse_compact", "weight": 1.0 / 3.0})
+
+    conn = nest.GetConnections()
+    assert conn.weight == float(np.float32(1.0 / 3.0))
+
+    conn.weight = 2.0 / 3.0
+    assert conn.weight == float(np.float32(2.0 / 3.0))
@@ -0,0 +1,166 @@
+# -*- coding: utf-8 -*-
+#
+# test_synapse_collection_get_set_arrays.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test getting and setting single parameters of many connections, which bypass the SLI interpreter.
+"""
+
+import nest
+import numpy as np
+import pytest
+
+
+@pytest.fixture(autouse=True)
+def reset():
+    nest.ResetKernel()
+
+
+def build_network(num_threads=1):
+    nest.local_num_threads = num_threads
+    nrns = nest.Create("iaf_psc_alpha", 6)
+    nest.Connect(nrns[:3], nrns[3:], syn_spec={"weight": 2.0, "delay": 1.5})
+    nest.Connect(nrns[3:], nrns[:3], syn_spec={"synapse_model": "stdp_synapse", "weight": 3.0})
+    return nrns
+
+
+def status_values(conns, key):
+    """Return the values of `key` read from the status of each connection."""
+    return [status[key] for status in nest.GetStatus(conns)]
+
+
+def test_get_matches_status_of_each_connection():
+    """
+    Expectation: Values read as arrays match the status of each connection, also for several synapse models.
+    """
+
+    build_network()
+    conns = nest.GetConnections()
+
+    assert conns.get("weight") == status_values(conns, "weight")
+    assert conns.get(["delay", "source"]) == {
+        "delay": status_values(conns, "delay"),
+        "source": status_values(conns, "source"),
+    }
+    assert conns[-1].get("weight") == 3.0
+
+
+@pytest.mark.parametrize(
+    "synapse_model",
+    ["static_synapse_hpc", "static_synapse_lbl", "static_synapse_compact", "tsodyks_synapse", "cont_delay_synapse"],
+)
+def test_get_weights_and_delays_of_synapse_models(synapse_model):
+    """
+    Expectation: Weights and delays read as arrays match the status, whether they are read directly or not.
+    """
+
+    nrns = nest.Create("iaf_psc_alpha", 3)
+    nest.Connect(nrns, nrns, syn_spec={"synapse_model": synapse_model, "weight": 2.5, "delay": 1.55})
+    conns = nest.GetConnections()
+
+    assert conns.get("weight") == status_values(conns, "weight")
+    assert conns.get("delay") == status_values(conns, "delay")
+
+
+@pytest.mark.skipif_missing_threads
+def test_get_and_set_with_threads():
+    """
+    Expectation: Values are read and written for connections on all threads.
+    """
+
+    build_network(num_threads=2)
+    conns = nest.GetConnections()
+    weights = np.arange(len(conns), dtype=float)
+    conns.set(weight=weights)
+
+    assert conns.get("weight") == weights.tolist()
+    assert status_values(conns, "weight") == weights.tolist()
+
+
+def test_set_arrays_and_scalars():
+    """
+    Expectation: Arrays and single values of floating point parameters are set for all connections.
+    """
+
+    build_network()
+    conns = nest.GetConnections(synapse_model="static_synapse")
+    weights = np.linspace(-1.0, 1.0, len(conns))
+    conns.set(weight=weights, delay=2.5)
+
+    assert status_values(conns, "weight") == weights.tolist()
+    assert status_values(conns, "delay") == [2.5] * len(conns)
+
+
+def test_get_and_set_device_connections():
+    """
+    Expectation: Connections from and to devices are read and written like connections between neurons.
+    """
+
+    nrns = nest.Create("iaf_psc_alpha", 2)
+    pg = nest.Create("poisson_generator")
+    sr = nest.Create("spike_recorder")
+    nest.Connect(pg, nrns, syn_spec={"weight": 5.0})
+    nest.Connect(nrns, sr)
+    nest.Connect(nrns[0], nrns[1])
+
+    conns = nest.GetConnections()
+    weights = [1.0, 2.0, 3.0, 4.0, 5.0]
+    conns.set(weight=weights)
+
+    assert conns.get("weight") == weights
+    assert status_values(conns, "weight") == weights
+
+
+def test_get_parameters_of_other_types():
+    """
+    Expectation: Parameters that are not floating point values are returned as before.
+    """
+
+    build_network()
+    conns = nest.GetConnections(synapse_model="static_synapse")
+
+    assert conns.get("synapse_model") == ["static_synapse"] * len(conns)
+    assert conns.get("receptor") == [0] * len(conns)
+
+
+def test_set_parameter_of_other_model_raises():
+    """
+    Expectation: Setting a parameter that only some of the connections have raises an error.
+    """
+
+    nrns = nest.Create("iaf_psc_alpha", 2)
+    nest.Connect(nrns, nrns, syn_spec={"synapse_model": "stdp_synapse"})
+    nest.Connect(nrns, nrns, syn_spec={"synapse_model": "tsodyks_synapse"})
+    conns = nest.GetConnections()
+
+    with pytest.raises(nest.kernel.NESTErrors.DictError):
+        conns.set(tau_plus=10.0)
+
+
+def test_set_invalid_value_raises():
+    """
+    Expectation: Setting an invalid value raises an error.
+    """
+
+    build_network()
+    conns = nest.GetConnections(synapse_model="static_synapse")
+
+    with pytest.raises(nest.kernel.NESTError):
+        conns.set(delay=-1.0)
@@ -0,0 +1,89 @@
+# -*- coding: utf-8 -*-
+#
+# test_volume_transmitter_binding.py
+#
+# This file is part of NEST.
+#
+# Copyright (C) 2004 The NEST Initiative
+#
+# NEST is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# NEST is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Test that a volume transmitter only triggers weight updates of the synapses bound to it.
+"""
+
+import nest
+import pytest
+
+if nest.ll_api.sli_func("is_threaded"):
+    THREAD_NUMBERS = [1, 2]
+else:
+    THREAD_NUMBERS = [1]
+
+WEIGHT = 10.0
+
+
+def simulate(num_threads, with_other_synapses):
+    """
+    Simulate dopamine-modulated synapses bound to two volume transmitters, of which only one receives dopamine spikes.
+
+    Returns the weights of synapses bound to the first and to the second volume transmitter.
+    """
+
+    nest.ResetKernel()
+    nest.local_num_threads = num_threads
+
+    pre_sg = nest.Create("spike_generator", params={"spike_times": [10.0 * k + 5.0 for k in range(1, 20)]})
+    pre = nest.Create("parrot_neuron")
+    post = nest.Create("iaf_psc_alpha", 4, params={"I_e": 400.0})
+    post_b = nest.Create("iaf_psc_alpha", 4, params={"I_e": 400.0})
+    dopa_sg = nest.Create("spike_generator", params={"spike_times": [15.0 * k for k in range(1, 13)]})
+    dopa = nest.Create("parrot_neuron")
+    vt_a, vt_b = nest.Create("volume_transmitter", 2)
+
+    nest.Connect(pre_sg, pre)
+    nest.Connect(dopa_sg, dopa)
+    nest.Connect(dopa, vt_a)
+
+    params = {"A_plus": 0.1, "A_minus": 0.05, "b": 0.0, "tau_c": 100.0, "tau_n": 50.0, "Wmax": 100.0}
+    nest.CopyModel("stdp_dopamine_synapse", "syn_a", dict(params, volume_transmitter=vt_a))
+    nest.CopyModel("stdp_dopamine_synapse", "syn_b", dict(params, volume_transmitter=vt_b))
+
+    nest.Connect(pre, post, syn_spec={"synapse_model": "syn_a", "weight": WEIGHT})
+    if with_other_synapses:
+        nest.Connect(pre, post_b, syn_spec={"synapse_model": "syn_b", "weight": WEIGHT})
+        nest.Connect(pre, post, syn_spec={"synapse_model": "static_synapse", "weight": 0.0})
+        nest.Connect(pre, post, syn_spec={"synapse_model": "stdp_synapse", "weight": 0.0, "lambda": 0.0})
+
+    nest.Simulate(200.0)
+
+    weights_a = nest.GetConnections(synapse_model="syn_a").get("weight")
+    weights_b = nest.GetConnections(synapse_model="syn_b").get("weight") if with_other_synapses else []
+
+    return weights_a, weights_b
+
+
+@pytest.mark.parametrize("num_threads", THREAD_NUMBERS)
+def test_volume_transmitter_binding(num_threads):
+    """
+    Expectation: Only synapses bound to the volume transmitter receiving dopamine change their weights, and they
+    change in the same way irrespective of other synapses in the network.
+    """
+
+    weights_a_alone, _ = simulate(num_threads, False)
+    weights_a, weights_b = simulate(num_threads, True)
+
+    assert all(w != WEIGHT for w in weights_a)
+    assert sorted(weights_a) == sorted(weights_a_alone)
+    assert all(w == WEIGHT for w in weights_b)